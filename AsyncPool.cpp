@@ -0,0 +1,80 @@
+// AsyncPool.cpp: implementation of the AsyncPool class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "AsyncPool.h"
+
+namespace OdbcJdbcLibrary {
+
+AsyncPool &asyncPool = *new AsyncPool;
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+AsyncPool::AsyncPool()
+{
+	idle = 0;
+	stopping = false;
+}
+
+//
+// Stops the threads once they are done with the calls submitted. Later
+// calls start new ones.
+//
+void AsyncPool::shutdown()
+{
+	std::vector<std::thread> stopped;
+
+	{
+		std::lock_guard<std::mutex> guard( mutex );
+		stopping = true;
+		stopped.swap( workers );
+	}
+
+	ready.notify_all();
+
+	for ( std::thread &worker : stopped )
+		worker.join();
+
+	std::lock_guard<std::mutex> guard( mutex );
+	stopping = false;
+}
+
+void AsyncPool::submit( std::function<void()> task )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	queue.push_back( std::move( task ) );
+
+	// the idle workers are enough for the tasks waiting
+	if ( idle >= (int)queue.size() || workers.size() >= ASYNC_POOL_THREADS )
+		ready.notify_one();
+	else
+		workers.emplace_back( &AsyncPool::run, this );
+}
+
+void AsyncPool::run()
+{
+	std::unique_lock<std::mutex> lock( mutex );
+
+	while ( true )
+	{
+		++idle;
+		ready.wait( lock, [this]{ return stopping || !queue.empty(); } );
+		--idle;
+
+		// the calls waiting are run before stopping
+		if ( queue.empty() )
+			break;
+
+		std::function<void()> task = std::move( queue.front() );
+		queue.pop_front();
+
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+
+}; // end namespace OdbcJdbcLibrary
@@ -0,0 +1,50 @@
+// AsyncPool.h: interface for the AsyncPool class.
+//
+//	The threads that run the functions called on statements with
+//	SQL_ATTR_ASYNC_ENABLE on. They are started as the calls come, up to
+//	ASYNC_POOL_THREADS, and kept until the last environment is freed;
+//	calls beyond that many wait in order for a thread to be free. The
+//	pool is never destroyed: a driver unloaded with threads left cannot
+//	join them from a static destructor, which on Windows runs under the
+//	lock of the loader the exiting threads need as well.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ASYNCPOOL_H_)
+#define _ASYNCPOOL_H_
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace OdbcJdbcLibrary {
+
+#define ASYNC_POOL_THREADS		64
+
+class AsyncPool
+{
+public:
+	AsyncPool();
+
+	void	submit( std::function<void()> task );
+	void	shutdown();
+
+private:
+	void	run();
+
+	std::deque< std::function<void()> > queue;
+	std::vector<std::thread>	workers;
+	int							idle;		// workers waiting for a task
+	bool						stopping;
+	std::mutex					mutex;
+	std::condition_variable		ready;
+};
+
+extern AsyncPool &asyncPool;
+
+}; // end namespace OdbcJdbcLibrary
+
+#endif // !defined(_ASYNCPOOL_H_)
@@ -49,6 +49,7 @@ DescRecord::DescRecord()
 	isBlobOrArray = 0;
 	data_at_exec = false;
 	startedTransfer	= false;
+	directTransfer = false;
 	sizeColumnExtendedFetch = 0;
 	dataOffset = 0;
 	currentFetched = 0;
@@ -78,6 +79,7 @@ DescRecord::DescRecord()
 	unNamed = SQL_NAMED;
 	dataPtr = NULL;
 	fnConv = NULL;
+	fnConvBlock = NULL;
 #ifdef _WINDOWS
 	WcsToMbs = _WcsToMbs;
 	MbsToWcs = _MbsToWcs;
@@ -209,15 +211,26 @@ void DescRecord::initZeroColumn()
 	updaTable = SQL_ATTR_READONLY;
 }
 
+//
+// A BLOB is written to the server as the chunks arrive, unless it takes
+// a hex string: a chunk may end between the two digits of a byte.
+//
 void DescRecord::beginBlobDataTransfer()
 {
 	dataBlobPtr->clear();
 	startedTransfer = true;
+	directTransfer = !dataBlobPtr->isArray() && ( conciseType == SQL_C_BINARY || dataBlobPtr->isClob() );
+
+	if ( directTransfer )
+		dataBlobPtr->directCreateStreamBlob();
 }
 
 void DescRecord::putBlobSegmentData (int length, const void *bytes)
 {
-	dataBlobPtr->putLongSegment (length, (char*)bytes);
+	if ( directTransfer )
+		dataBlobPtr->directWriteBlob ((char*)bytes, length);
+	else
+		dataBlobPtr->putLongSegment (length, (char*)bytes);
 }
 
 void DescRecord::endBlobDataTransfer()
@@ -225,4 +238,15 @@ void DescRecord::endBlobDataTransfer()
 	startedTransfer = false;
 }
 
+//
+// A transfer that ends without a value leaves no stream blob open.
+//
+void DescRecord::cancelBlobDataTransfer()
+{
+	if ( directTransfer )
+		dataBlobPtr->directCancelStreamBlob();
+
+	directTransfer = false;
+}
+
 }; // end namespace OdbcJdbcLibrary
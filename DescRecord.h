@@ -46,6 +46,7 @@ public:
     void beginBlobDataTransfer();
     void putBlobSegmentData (int length, const void *bytes);
     void endBlobDataTransfer();	
+    void cancelBlobDataTransfer();
 
 	int getBufferLength()
 	{ 
@@ -64,6 +65,7 @@ public:
 	int				isBlobOrArray;
 	bool			data_at_exec;
 	bool			startedTransfer;
+	bool			directTransfer;	// sqlPutData writes straight to the server
 	int				sizeColumnExtendedFetch;
 	SQLINTEGER		dataOffset;
 	int				currentFetched;
@@ -110,6 +112,7 @@ public:
 public:
 
 	ADRESS_FUNCTION fnConv;
+	COLUMN_BLOCK_FUNCTION fnConvBlock;	// NULL - no columnar kernel, use fnConv per row
 };
 
 }; // end namespace OdbcJdbcLibrary
@@ -36,6 +36,7 @@ NITEM (SQL_BATCH_ROW_COUNT, 0)
 NITEM (SQL_BATCH_SUPPORT, 0)
 CITEM (SQL_DATA_SOURCE_NAME, "")
 NITEM (SQL_MAX_ASYNC_CONCURRENT_STATEMENTS, 0)
+NITEM (SQL_ASYNC_NOTIFICATION, SQL_ASYNC_NOTIFICATION_CAPABLE)
 NITEM (SQL_DRIVER_HDBC, 0)
 SITEM (SQL_MAX_CONCURRENT_ACTIVITIES, 0) // no limit
 
@@ -97,12 +98,15 @@ NITEM (SQL_STATIC_CURSOR_ATTRIBUTES2, (SQL_CA2_READ_ONLY_CONCURRENCY |
 										SQL_CA2_MAX_ROWS_AFFECTS_ALL
 										))
 NITEM (SQL_KEYSET_CURSOR_ATTRIBUTES1, (SQL_CA1_NEXT |
+										SQL_CA1_ABSOLUTE |
 										SQL_CA1_BOOKMARK |
-										SQL_CA1_LOCK_NO_CHANGE
+										SQL_CA1_RELATIVE |
+										SQL_CA1_LOCK_NO_CHANGE |
+										SQL_CA1_POS_POSITION
 										))
 NITEM (SQL_KEYSET_CURSOR_ATTRIBUTES2, (SQL_CA2_READ_ONLY_CONCURRENCY |
 										SQL_CA2_OPT_VALUES_CONCURRENCY |
-										SQL_CA2_SENSITIVITY_ADDITIONS |
+										SQL_CA2_SENSITIVITY_DELETIONS |
 										SQL_CA2_SENSITIVITY_UPDATES
 										))
 CITEM (SQL_SEARCH_PATTERN_ESCAPE, "")
@@ -126,7 +130,7 @@ SITEM (SQL_CONCAT_NULL_BEHAVIOR, SQL_CB_NULL)
 
 CITEM (SQL_SCHEMA_TERM, "")
 SITEM (SQL_CURSOR_COMMIT_BEHAVIOR, 0)
-NITEM (SQL_SCROLL_OPTIONS, (SQL_SO_STATIC | SQL_SO_FORWARD_ONLY) )
+NITEM (SQL_SCROLL_OPTIONS, (SQL_SO_STATIC | SQL_SO_KEYSET_DRIVEN | SQL_SO_FORWARD_ONLY) )
 SITEM (SQL_ODBC_SAG_CLI_CONFORMANCE, SQL_OSCC_COMPLIANT)
 
 SITEM (SQL_CURSOR_ROLLBACK_BEHAVIOR, 0)
@@ -37,6 +37,7 @@
 #include "SQLError.h"
 #include "Parameters.h"
 #include "IscConnection.h"
+#include "AttachmentPool.h"
 
 static char databaseInfoItems [] = { 
 	isc_info_db_id,
@@ -75,6 +76,11 @@ Attachment::Attachment()
 	majorFb = 1;
 	minorFb = 0;
 	versionFb = 0;
+	poolSize = 0;
+	poolIdleTimeout = DEFAULT_POOL_IDLE_TIMEOUT;
+	poolLifetime = 0;
+	attachTime = 0;
+	idleTime = 0;
 }
 
 Attachment::~Attachment()
@@ -548,9 +554,51 @@ void Attachment::openDatabase(const char *dbName, Properties *properties)
 	if (property && *property)
 		dsn = property;
 
+	property = properties->findValue ("poolSize", NULL);
+
+	if (property && *property)
+		poolSize = atoi(property);
+
+	property = properties->findValue ("poolIdleTimeout", NULL);
+
+	if (property && *property)
+		poolIdleTimeout = atoi(property);
+
+	property = properties->findValue ("poolLifetime", NULL);
+
+	if (property && *property)
+		poolLifetime = atoi(property);
+
+	attachTime = time (NULL);
+
 	checkAdmin();
 }
 
+bool Attachment::ping()
+{
+	CheckStatusWrapper status( GDS->_status );
+	databaseHandle->ping( &status );
+
+	return ( status.getState() & IStatus::STATE_ERRORS ) == 0;
+}
+
+//
+// Brings the session back to the state it had after the attach: context
+// variables, the role, rows of temporary tables, the time zone... Servers
+// before Firebird 4 have no statement for it; on them it is left as is.
+//
+bool Attachment::resetSession()
+{
+	if ( majorFb < 4 )
+		return true;
+
+	static const char sql[] = "ALTER SESSION RESET";
+	CheckStatusWrapper status( GDS->_status );
+	databaseHandle->execute( &status, NULL, sizeof( sql ) - 1, sql, databaseDialect, NULL, NULL, NULL, NULL );
+
+	return ( status.getState() & IStatus::STATE_ERRORS ) == 0;
+}
+
 void Attachment::addRef()
 {
 	++useCount;
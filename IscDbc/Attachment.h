@@ -25,6 +25,8 @@
 #if !defined(_ATTACHMENT_H_)
 #define _ATTACHMENT_H_
 
+#include <time.h>
+#include <string>
 #include "Mutex.h"
 
 namespace IscDbcLibrary {
@@ -50,6 +52,8 @@ public:
 	bool isFirebirdVer2_0(){ return majorFb == 2; }
 	void createDatabase(const char *dbName, Properties *properties);
 	void openDatabase(const char * dbName, Properties * properties);
+	bool ping();
+	bool resetSession();
 	Attachment();
 	~Attachment();
 
@@ -88,6 +92,13 @@ public:
 	bool		admin;
 	bool		isRoles;
 	Mutex		mutex;
+
+	std::string	poolKey;		// empty unless it goes back to the pool
+	int			poolSize;
+	int			poolIdleTimeout;
+	int			poolLifetime;
+	time_t		attachTime;
+	time_t		idleTime;
 };
 
 inline
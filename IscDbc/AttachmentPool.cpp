@@ -0,0 +1,214 @@
+// AttachmentPool.cpp: implementation of the AttachmentPool class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <stdlib.h>
+#include "IscDbc.h"
+#include "Attachment.h"
+#include "AttachmentPool.h"
+#include "Properties.h"
+
+namespace IscDbcLibrary {
+
+AttachmentPool &attachmentPool = *new AttachmentPool;
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+AttachmentPool::AttachmentPool()
+{
+	count = 0;
+	hits = 0;
+	misses = 0;
+}
+
+//
+// Detaches every idle attachment, once the pool is unlocked.
+//
+void AttachmentPool::clear()
+{
+	std::vector<Attachment*> expired;
+
+	{
+		std::lock_guard<std::mutex> guard( mutex );
+
+		for ( auto &it : idle )
+			for ( Attachment *attachment : it.second )
+				expired.push_back( attachment );
+
+		idle.clear();
+		count = 0;
+	}
+
+	for ( Attachment *attachment : expired )
+		attachment->release();
+}
+
+//
+// The key of the attachments a connection may take: the database and
+// every parameter that goes into the attach or into what the driver
+// keeps of it. Returns false when the connection is not to be pooled.
+//
+bool AttachmentPool::makeKey( const char *dbName, Properties *properties, std::string &key )
+{
+	// the first four are names, which are not case sensitive
+	static const char *names[] = { "user", "role", "charset", "characterset",
+		"password", "client", "timeout", "dialect", "quoted", "sensitive", "autoQuoted",
+		"useSchema", "useLockTimeout", "EnableCompatBind", "SetCompatBind",
+		"EnableWireCompression", "dsn", NULL };
+
+	const char *size = properties->findValue( "poolSize", NULL );
+	const char *access = properties->findValue( "databaseAccess", NULL );
+
+	if ( !size || atoi( size ) <= 0 || ( access && *access != '0' ) )
+		return false;
+
+	key.assign( dbName );
+
+	for ( const char **name = names; *name; ++name )
+	{
+		const char *value = properties->findValue( *name, "" );
+		bool fold = name < names + 4;
+
+		key += '\0';
+
+		for ( ; *value; ++value )
+			key += fold ? UPPER( *value ) : *value;
+	}
+
+	return true;
+}
+
+//
+// An idle attachment made with the key that still answers, or NULL.
+//
+Attachment* AttachmentPool::take( const std::string &key )
+{
+	std::vector<Attachment*> expired;
+	Attachment *attachment;
+
+	while ( ( attachment = pop( key, expired ) ) && !attachment->ping() )
+		expired.push_back( attachment );
+
+	{
+		std::lock_guard<std::mutex> guard( mutex );
+
+		if ( attachment )
+			++hits;
+		else
+			++misses;
+	}
+
+	for ( Attachment *item : expired )
+		item->release();
+
+	return attachment;
+}
+
+Attachment* AttachmentPool::pop( const std::string &key, std::vector<Attachment*> &expired )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	expire( time( NULL ), expired );
+
+	auto it = idle.find( key );
+
+	if ( it == idle.end() )
+		return NULL;
+
+	// the most recently used is the least likely to have been dropped
+	Attachment *attachment = it->second.back();
+	it->second.pop_back();
+	--count;
+
+	if ( it->second.empty() )
+		idle.erase( it );
+
+	return attachment;
+}
+
+//
+// Keeps an attachment its connection is done with. Returns false when it
+// is not kept, the caller releases it then.
+//
+bool AttachmentPool::give( Attachment *attachment )
+{
+	time_t now = time( NULL );
+
+	if ( attachment->poolLifetime && now - attachment->attachTime >= attachment->poolLifetime )
+		return false;
+
+	if ( !attachment->resetSession() )
+		return false;
+
+	std::vector<Attachment*> expired;
+	bool kept = false;
+
+	{
+		std::lock_guard<std::mutex> guard( mutex );
+
+		expire( now, expired );
+
+		std::list<Attachment*> &list = idle[attachment->poolKey];
+
+		if ( (int)list.size() < attachment->poolSize )
+		{
+			attachment->idleTime = now;
+			list.push_back( attachment );
+			++count;
+			kept = true;
+		}
+		else if ( list.empty() )
+			idle.erase( attachment->poolKey );
+	}
+
+	for ( Attachment *item : expired )
+		item->release();
+
+	return kept;
+}
+
+//
+// Takes out the attachments idle or attached for longer than they may be,
+// to be released once the pool is unlocked.
+//
+void AttachmentPool::expire( time_t now, std::vector<Attachment*> &expired )
+{
+	for ( auto it = idle.begin(); it != idle.end(); )
+	{
+		std::list<Attachment*> &list = it->second;
+
+		for ( auto item = list.begin(); item != list.end(); )
+		{
+			Attachment *attachment = *item;
+
+			if ( now - attachment->idleTime >= attachment->poolIdleTimeout
+				|| ( attachment->poolLifetime && now - attachment->attachTime >= attachment->poolLifetime ) )
+			{
+				expired.push_back( attachment );
+				item = list.erase( item );
+				--count;
+			}
+			else
+				++item;
+		}
+
+		if ( list.empty() )
+			it = idle.erase( it );
+		else
+			++it;
+	}
+}
+
+void AttachmentPool::getStatistics( int &hitCount, int &missCount, int &idleCount )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	hitCount = hits;
+	missCount = misses;
+	idleCount = count;
+}
+
+}; // end namespace IscDbcLibrary
@@ -0,0 +1,59 @@
+// AttachmentPool.h: interface for the AttachmentPool class.
+//
+//	Attachments that connections are done with, kept for the process by
+//	the database and the parameters they were made with, so that a later
+//	connection with the same ones skips the attach, the authentication
+//	and the database info. An attachment goes back rolled back and, from
+//	Firebird 4 on, with its session reset; it is checked with a ping
+//	before it is handed out again. Those idle for too long or attached
+//	for too long are detached whenever the pool is used, all of them when
+//	the driver lets its last environment go. The pool is never destroyed:
+//	detaching from a static destructor would run in the unload of the
+//	driver, under the lock of the loader on Windows.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ATTACHMENTPOOL_H_)
+#define _ATTACHMENTPOOL_H_
+
+#include <time.h>
+#include <string>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+namespace IscDbcLibrary {
+
+class Attachment;
+class Properties;
+
+#define DEFAULT_POOL_IDLE_TIMEOUT	60	// seconds
+
+class AttachmentPool
+{
+public:
+	AttachmentPool();
+
+	static bool	makeKey( const char *dbName, Properties *properties, std::string &key );
+	Attachment*	take( const std::string &key );
+	bool		give( Attachment *attachment );
+	void		getStatistics( int &hitCount, int &missCount, int &idleCount );
+	void		clear();
+
+private:
+	Attachment*	pop( const std::string &key, std::vector<Attachment*> &expired );
+	void		expire( time_t now, std::vector<Attachment*> &expired );
+
+	std::mutex	mutex;
+	std::unordered_map<std::string, std::list<Attachment*>> idle;	// the longest idle first
+	int			count;
+	int			hits;
+	int			misses;
+};
+
+extern AttachmentPool &attachmentPool;
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ATTACHMENTPOOL_H_)
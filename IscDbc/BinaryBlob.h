@@ -54,6 +54,9 @@ public:
 	virtual bool  directGetSegmentToHexStr( char * bufData, int lenData, int &lenRead ) { return false; }
 	virtual void  directWriteBlob( char *data, int length ) {};
 	virtual void  directCloseBlob() {};
+	virtual void  directCreateStreamBlob() {};
+	virtual void  directCloseStreamBlob( char * sqldata ) {};
+	virtual void  directCancelStreamBlob() {};
 	virtual int	  getOffset() { return offset; }
 	void putSegment (int length, const char *data, bool copyFlag);
 	void putLongSegment(int length, const char * data);
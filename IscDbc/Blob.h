@@ -36,6 +36,9 @@ public:
 	virtual bool	directGetSegmentToHexStr( char * bufData, int lenData, int &lenRead ) = 0;
 	virtual void	directWriteBlob( char *data, int length ) = 0;
 	virtual void	directCloseBlob() = 0;
+	virtual void	directCreateStreamBlob() = 0;
+	virtual void	directCloseStreamBlob( char * sqldata ) = 0;
+	virtual void	directCancelStreamBlob() = 0;
 	virtual int		getOffset() = 0;
 
 	virtual void	bind(Statement *stmt, char * sqldata) = 0;
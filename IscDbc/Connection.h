@@ -39,6 +39,7 @@
 #if !defined(_CONNECTION_H_)
 #define _CONNECTION_H_
 
+#include <stdint.h>
 #include "BinaryBlob.h"
 #include "Properties.h"
 #include "SQLException.h"
@@ -252,6 +253,10 @@ public:
 	virtual int			getConnectionCharsetCode() = 0;
 	virtual WCSTOMBS	getConnectionWcsToMbs() = 0;
 	virtual MBSTOWCS	getConnectionMbsToWcs() = 0;
+	virtual void		getStatementCacheStatistics( int &hits, int &misses, int &entries ) = 0;
+	virtual void		getNativeSqlCacheStatistics( int &hits, int &misses, int &entries ) = 0;
+	virtual void		getConnectionPoolStatistics( int &hits, int &misses, int &idle ) = 0;
+	virtual void		getClientLibraryStatistics( int &loads, int &users ) = 0;
 
 	virtual void		addRef() = 0;
 	virtual int			release() = 0;
@@ -470,7 +475,7 @@ public:
 	virtual int			getMaxFieldSize() = 0;
 	virtual int			getMaxRows() = 0;
 	virtual int			getQueryTimeout() = 0;
-	virtual void		cancel() = 0;
+	virtual bool		cancel() = 0;
 //	virtual void		clearWarnings() = 0;
 //	virtual void		getWarnings() = 0;
 	virtual void		close() = 0;
@@ -682,12 +687,16 @@ public:
 	virtual void		setPosRowInSet(int posRow) = 0;
 	virtual int			getPosRowInSet() = 0;
 	virtual size_t*		getSqlDataOffsetPtr() = 0;
+	virtual size_t*		getSqlIndOffsetPtr() = 0;
 	virtual bool		readStaticCursor() = 0;
 	virtual bool		nextFetch() = 0;
+	virtual int			nextFetchBlock(int maxRows, intptr_t *offsetFirstRow, size_t *lengthRow) = 0;
 	virtual bool		setCurrentRowInBufferStaticCursor(int nRow) = 0;
 	virtual void		copyNextSqldaInBufferStaticCursor() = 0;
 	virtual void		copyNextSqldaFromBufferStaticCursor() = 0;
+	virtual void		nextRowInBufferStaticCursor() = 0;
 	virtual int			getCountRowsStaticCursor() = 0;
+	virtual size_t		getMemoryStaticCursor() = 0;
 	virtual bool		getDataFromStaticCursor (int column/*, Blob * pointerBlobData*/) = 0;
 	virtual bool		nextFromProcedure() = 0;
 	virtual int			release() = 0;
@@ -829,6 +838,7 @@ public:
 };
 
 #define INTERNALSTATEMENT_VERSION	1
+#define DEFAULT_BLOB_CACHE_MEMORY	16	// megabytes of BLOB contents kept by a static cursor
 
 class InternalStatement : public Statement
 {
@@ -838,6 +848,8 @@ public:
 	virtual void		prepareStatement(const char * sqlString) = 0;
 	virtual bool		executeStatement() = 0;
 	virtual bool		executeProcedure() = 0;
+	virtual bool		prepareDirect(const char * sqlString, bool selectCursor) = 0;
+	virtual bool		executeDirect() = 0;
 	virtual void		rollbackLocal() = 0;
 	virtual void		commitLocal() = 0;
 	virtual StatementMetaData*	
@@ -848,6 +860,19 @@ public:
 	virtual void		drop() = 0;
 	virtual Statement*	getStatement() = 0;
 	virtual int			objectVersion() = 0;
+	virtual void		setReadAheadRows(int rows) = 0;
+	virtual void		setScrollableCursor(bool scrollable) = 0;
+	virtual bool		isScrollableCursor() = 0;
+	virtual void		setStaticCursorMemory(int megabytes) = 0;
+	virtual void		setBlobCacheMemory(int megabytes) = 0;
+	virtual void		setKeysetCursor(bool keyset) = 0;
+	virtual bool		isKeysetCursor() = 0;
+	virtual bool		beginBatch() = 0;
+	virtual void		addBatch() = 0;
+	virtual void		executeBatch() = 0;
+	virtual void		cancelBatch() = 0;
+	virtual int			getBatchRows() = 0;
+	virtual int			getBatchUpdateCount(int row) = 0;
 };
 
 class PropertiesEvents
@@ -52,6 +52,7 @@ IscBlob::IscBlob()
 	directBlobHandle = NULL;
 	fetched = false;
 	directBlob = false;
+	batchBlob = false;
 	offset = 0;
 
 	enType = enTypeBlob;
@@ -59,14 +60,17 @@ IscBlob::IscBlob()
 
 IscBlob::IscBlob(IscStatement *stmt, char* buf, short sqlsubtype)
 {
+	directBlobHandle = NULL;
 	directBlob = false;
+	batchBlob = false;
 	bind (stmt, buf);
 	setType(sqlsubtype);
 }
 
 IscBlob::~IscBlob()
 {
-
+	if ( directBlobHandle )
+		directBlobHandle->release();
 }
 
 void IscBlob::setType(short sqlsubtype)
@@ -86,11 +90,14 @@ void IscBlob::bind(Statement *stmt, char * sqldata)
 	offset = 0;
 }
 
+//
+// Shares the content the static cursor keeps for the blob id at pointBlob;
+// it is read from the server the first time it is needed.
+//
 void IscBlob::attach(char * pointBlob, bool bFetched, bool clear)
 {
-	IscBlob * ptBlob = (IscBlob *)*(intptr_t*)pointBlob;
+	IscBlob * ptBlob = statement->outputSqlda.getBlobStaticCursor( pointBlob );
 
-	statement = ptBlob->statement;
 	memcpy(&blobId,&ptBlob->blobId, sizeof(blobId));
 	fetched = bFetched;
 	Stream::attach(*((Stream *)((BinaryBlob*)ptBlob)),clear);
@@ -177,6 +184,14 @@ void* IscBlob::getSegment(int pos)
 
 void IscBlob::writeBlob(char * sqldata)
 {
+	if ( statement->isBatchingBlobs() )
+	{
+		statement->addBatchBlob( sqldata );
+		for ( int len, offset = 0; len = getSegmentLength (offset); offset += len )
+			statement->appendBatchBlob( (char*) getSegment (offset), len );
+		return;
+	}
+
 	IscConnection * connection = statement->connection;
 	CFbDll * GDS = connection->GDS;
 	IBlob* blobHandle = nullptr;
@@ -204,6 +219,14 @@ void IscBlob::writeBlob(char * sqldata)
 
 void IscBlob::writeStreamHexToBlob(char * sqldata)
 {
+	if ( statement->isBatchingBlobs() )
+	{
+		statement->addBatchBlob( sqldata );
+		for ( int len, offset = 0; len = getSegmentLength (offset); offset += len )
+			statement->appendBatchBlob( convStrHexToBinary ( (char*)getSegment (offset), len ), len/2 );
+		return;
+	}
+
 	IscConnection * connection = statement->connection;
 	CFbDll * GDS = connection->GDS;
 	IBlob* blobHandle = NULL;
@@ -231,6 +254,17 @@ void IscBlob::writeStreamHexToBlob(char * sqldata)
 
 void IscBlob::writeBlob(char * sqldata, char *data, int length)
 {
+	// a parameter set going to IBatch takes the contents with it
+	if ( statement->isBatchingBlobs() )
+	{
+		statement->addBatchBlob( sqldata );
+		for ( int len, offset = 0; len = getSegmentLength (offset); offset += len )
+			statement->appendBatchBlob( convStrHexToBinary ( (char*)getSegment (offset), len ), len/2 );
+		if ( length > 0 )
+			statement->appendBatchBlob( data, length );
+		return;
+	}
+
 	IscConnection * connection = statement->connection;
 	CFbDll * GDS = connection->GDS;
 	IBlob* blobHandle = nullptr;
@@ -416,6 +450,8 @@ bool IscBlob::directGetSegmentToHexStr( char * bufData, int lenData, int &lenRea
 
 void IscBlob::directCloseBlob()
 {
+	batchBlob = false;
+
 	if ( directBlobHandle )
 	{
 		ThrowStatusWrapper status( statement->connection->GDS->_status );
@@ -445,6 +481,8 @@ void IscBlob::directCreateBlob( char * sqldata )
 	CFbDll * GDS = connection->GDS;
 	ThrowStatusWrapper status( GDS->_status );
 
+	batchBlob = statement->isBatchingBlobs();
+
 	if ( directBlobHandle )
 		try
 		{
@@ -459,6 +497,12 @@ void IscBlob::directCreateBlob( char * sqldata )
 			}
 		}
 
+	if ( batchBlob )
+	{
+		statement->addBatchBlob( sqldata );
+		return;
+	}
+
 	ITransaction* transactionHandle = statement->startTransaction();
 
 	try
@@ -473,6 +517,13 @@ void IscBlob::directCreateBlob( char * sqldata )
 
 void IscBlob::directWriteBlob( char *data, int length )
 {
+	if ( batchBlob && !directBlobHandle )
+	{
+		if ( length > 0 )
+			statement->appendBatchBlob( data, length );
+		return;
+	}
+
 	IscConnection * connection = statement->connection;
 	CFbDll * GDS = connection->GDS;
 	ThrowStatusWrapper status( GDS->_status );
@@ -499,4 +550,95 @@ void IscBlob::directWriteBlob( char *data, int length )
 	}
 }
 
+//
+// Block direct operations at SQLPutData: a stream blob is created when
+// the transfer begins, each chunk the application puts is written to it
+// with directWriteBlob, and the blob id goes to the parameter once it is
+// closed. Nothing of the data is kept in the driver.
+//
+void IscBlob::directCreateStreamBlob()
+{
+	static const unsigned char bpb[] = { isc_bpb_version1, isc_bpb_type, 1, isc_bpb_type_stream };
+
+	IscConnection * connection = statement->connection;
+	CFbDll * GDS = connection->GDS;
+	ThrowStatusWrapper status( GDS->_status );
+
+	// a transfer the application gave up on
+	directCancelStreamBlob();
+
+	// the blob lives in the transaction that is going to execute the
+	// statement: streamBlobs keeps commitAuto of the other statements
+	// from ending it before the parameter gets the blob id
+	std::lock_guard<std::recursive_mutex> guard( connection->transactionMutex );
+	ITransaction* transactionHandle = statement->startTransaction();
+
+	try
+	{
+		directBlobHandle = connection->databaseHandle->createBlob( &status, transactionHandle, &blobId, sizeof( bpb ), bpb );
+	}
+	catch( const FbException& error )
+	{
+		THROW_ISC_EXCEPTION ( connection, error.getStatus() );
+	}
+
+	++statement->streamBlobs;
+}
+
+void IscBlob::directCloseStreamBlob( char * sqldata )
+{
+	if ( !directBlobHandle )
+		throw SQLEXCEPTION ( RUNTIME_ERROR, "the BLOB parameter transfer was not started or was canceled" );
+
+	IscConnection * connection = statement->connection;
+	CFbDll * GDS = connection->GDS;
+	ThrowStatusWrapper status( GDS->_status );
+	std::lock_guard<std::recursive_mutex> guard( connection->transactionMutex );
+
+	--statement->streamBlobs;
+
+	try
+	{
+		directBlobHandle->close( &status );
+		directBlobHandle = nullptr;
+	}
+	catch( const FbException& error )
+	{
+		directBlobHandle->release();
+		directBlobHandle = nullptr;
+		THROW_ISC_EXCEPTION ( connection, error.getStatus() );
+	}
+
+	*(ISC_QUAD*)sqldata = blobId;
+}
+
+//
+// Drops the stream blob of a transfer that ends without a value: the
+// application sent NULL, canceled, or executed the statement again.
+//
+void IscBlob::directCancelStreamBlob()
+{
+	if ( !directBlobHandle )
+		return;
+
+	IscConnection * connection = statement->connection;
+	ThrowStatusWrapper status( connection->GDS->_status );
+	std::lock_guard<std::recursive_mutex> guard( connection->transactionMutex );
+
+	--statement->streamBlobs;
+
+	try
+	{
+		directBlobHandle->cancel( &status );
+		directBlobHandle = nullptr;
+	}
+	catch( ... )
+	{
+		if( directBlobHandle ) {
+			directBlobHandle->release();
+			directBlobHandle = nullptr;
+		}
+	}
+}
+
 }; // end namespace IscDbcLibrary
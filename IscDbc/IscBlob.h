@@ -61,12 +61,16 @@ public:
 	bool directGetSegmentToHexStr( char * bufData, int lenData, int &lenRead );
 	void directWriteBlob( char *data, int length );
 	void directCloseBlob();
+	void directCreateStreamBlob();
+	void directCloseStreamBlob( char * sqldata );
+	void directCancelStreamBlob();
 
 	IscStatement	*statement;
 	ISC_QUAD		blobId;
 	Firebird::IBlob* directBlobHandle;
 	bool			fetched;
 	bool			directBlob;
+	bool			batchBlob;		// created by directCreateBlob in the statement's batch
 };
 
 }; // end namespace IscDbcLibrary
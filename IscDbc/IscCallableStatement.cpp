@@ -119,7 +119,8 @@ bool IscCallableStatement::execute()
 
 	resultsCount	= 1;
 	resultsSequence = 0;
-	getUpdateCounts();
+	summaryUpdateCount = 0;
+	updateCountPending = true;
 
     Value *value = values.values;
 
@@ -60,6 +60,10 @@
 #include "Parameters.h"
 #include "ParametersEvents.h"
 #include "Attachment.h"
+#include "AttachmentPool.h"
+#include "IscStatementCache.h"
+#include "IscNativeSqlCache.h"
+#include "IscSqlLexer.h"
 #include "Mlist.h"
 #include "SupportFunctions.h"
 #include "../SetupAttributes.h"
@@ -92,6 +96,11 @@ InfoTransaction::InfoTransaction()
 	transactionPending = false;
 	autoCommit = true;
 	transactionExtInit = 0;
+	serverAutoCommit = false;
+	tpbIsolation = 0;
+	tpbExtInit = 0;
+	tpbLockTimeout = 0;
+	tpbAutoCommit = false;
 	nodeParamTransaction = NULL;
 }
 
@@ -121,10 +130,19 @@ void IscConnection::init()
 	userEvents = NULL;
 	useAppOdbcVersion = 3; // SQL_OV_ODBC3
 	tmpParamTransaction = NULL;
+	readOnlyQueries = false;
+	queryTransactionInfo.transactionIsolation = 0x00000002L; // SQL_TXN_READ_COMMITTED
+	queryTransactionInfo.transactionExtInit = TRA_ro | TRA_nw;
+	statementCache = new IscStatementCache( this );
+	nativeSqlCache = new IscNativeSqlCache;
 }
 
 IscConnection::~IscConnection()
 {
+	// the kept statements go while the attachment is still there
+	delete statementCache;
+	delete nativeSqlCache;
+
 	if (metaData)
 		delete metaData;
 
@@ -144,18 +162,62 @@ bool IscConnection::isConnected()
 
 void IscConnection::close()
 {
+	// the attachment goes back to the pool unless something else may still use it
+	bool pooled = attachment && !attachment->poolKey.empty() && attachment->useCount == 1
+		&& !shareConnected && !userEvents;
+
 	FOR_OBJECTS (IscStatement*, statement, &statements)
+		if ( statement->transactionInfo.transactionHandle )
+			pooled = false;
 		statement->close();
 		statement->freeStatementHandle();
 		statement->connection = NULL; // NOMEY
 	END_FOR;
 
+	endQueryTransaction();
+
 	if ( shareConnected )
 		connectionFromEnvShare();
 
+	if ( pooled )
+		releaseToPool();
+
 	delete this;
 }
 
+//
+// Rolls back what the connection left open and hands the attachment to
+// the pool. When that fails it is detached as usual.
+//
+void IscConnection::releaseToPool()
+{
+	InfoTransaction	&tr = transactionInfo;
+
+	// kept statements belong to the connection, not to the attachment
+	statementCache->clear();
+
+	if ( tr.transactionHandle )
+	{
+		ThrowStatusWrapper status( GDS->_status );
+		try
+		{
+			tr.transactionHandle->rollback( &status );
+			tr.transactionHandle = nullptr;
+		}
+		catch( const FbException& )
+		{
+			status.clearException();
+			return;
+		}
+	}
+
+	if ( attachmentPool.give( attachment ) )
+	{
+		attachment = NULL;
+		databaseHandle = NULL;
+	}
+}
+
 PreparedStatement* IscConnection::prepareStatement(const char * sqlString)
 {
 	IscPreparedStatement *statement = NULL;
@@ -172,6 +234,7 @@ PreparedStatement* IscConnection::prepareStatement(const char * sqlString)
 		throw;
 	}
 
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	statements.append (statement);
 
 	return statement;
@@ -200,6 +263,7 @@ UserEvents* IscConnection::prepareUserEvents( PropertiesEvents *context, callbac
 
 void IscConnection::commit()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if ( tr.transactionHandle )
@@ -221,6 +285,7 @@ void IscConnection::commit()
 
 void IscConnection::rollback()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if ( tr.transactionHandle )
@@ -245,6 +310,7 @@ void IscConnection::rollback()
 
 void IscConnection::prepareTransaction()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if ( tr.transactionHandle )
@@ -273,6 +339,7 @@ Firebird::IAttachment* IscConnection::getHandleDb()
 
 Firebird::ITransaction* IscConnection::startTransaction()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if ( shareConnected )
@@ -290,6 +357,56 @@ Firebird::ITransaction* IscConnection::startTransaction()
     if ( tr.transactionHandle )
         return tr.transactionHandle;
 
+	bool serverAutoCommit;
+	const std::vector<unsigned char> &tpb = getTpb( tr, serverAutoCommit );
+
+	ThrowStatusWrapper status( GDS->_status );
+	try
+	{
+		tr.transactionHandle =
+			attachment->databaseHandle->startTransaction( &status, (unsigned)tpb.size(), tpb.data() );
+	}
+	catch( const FbException& error )
+	{
+		THROW_ISC_EXCEPTION ( this, error.getStatus() );
+	}
+
+	tr.serverAutoCommit = serverAutoCommit;
+
+	if ( !tr.autoCommit )
+		tr.transactionPending = true;
+
+    return tr.transactionHandle;
+}
+
+//
+// The parameter buffer for a transaction with the settings of tr. It is
+// built once and kept until the settings change, rather than through
+// IXpbBuilder for every transaction autocommit starts. With the
+// ServerAutoCommit option a read committed transaction in autocommit
+// mode asks for isc_tpb_autocommit: the server commits every statement
+// as it completes and the transaction stays open, so the driver neither
+// commits nor starts another. A snapshot would keep seeing the data of
+// its start, and goes on being committed by the driver.
+//
+const std::vector<unsigned char>& IscConnection::getTpb( InfoTransaction &tr, bool &serverAutoCommit )
+{
+	int lockTimeout = 0;
+
+	if ( !(tr.transactionExtInit & TRA_nw) && attachment->isFirebirdVer2_0() )
+		lockTimeout = attachment->getUseLockTimeoutWaitTransactions();
+
+	serverAutoCommit = (tr.transactionExtInit & TRA_autocommit) && tr.autoCommit
+		&& tr.transactionIsolation != 0x00000008L		// SQL_TXN_SERIALIZABLE
+		&& tr.transactionIsolation != 0x00000004L;		// SQL_TXN_REPEATABLE_READ
+
+	if ( !tr.tpb.empty()
+		&& tr.tpbIsolation == tr.transactionIsolation
+		&& tr.tpbExtInit == tr.transactionExtInit
+		&& tr.tpbLockTimeout == lockTimeout
+		&& tr.tpbAutoCommit == serverAutoCommit )
+		return tr.tpb;
+
 	IUtil* utl    = GDS->_master->getUtilInterface();
 	IXpbBuilder* tpb = nullptr;
 	ThrowStatusWrapper status( GDS->_status );
@@ -327,15 +444,14 @@ Firebird::ITransaction* IscConnection::startTransaction()
 				break;
 		}
 
-		if ( !(tr.transactionExtInit & TRA_nw)
-			&& attachment->isFirebirdVer2_0()
-			&& attachment->getUseLockTimeoutWaitTransactions() )
-		{
-			tpb->insertInt(&status, isc_tpb_lock_timeout, attachment->getUseLockTimeoutWaitTransactions() );
-		}
+		if ( lockTimeout )
+			tpb->insertInt( &status, isc_tpb_lock_timeout, lockTimeout );
 
-		tr.transactionHandle =
-			attachment->databaseHandle->startTransaction(&status, tpb->getBufferLength(&status), tpb->getBuffer(&status));
+		if ( serverAutoCommit )
+			tpb->insertTag( &status, isc_tpb_autocommit );
+
+		const unsigned char *buffer = tpb->getBuffer( &status );
+		tr.tpb.assign( buffer, buffer + tpb->getBufferLength( &status ) );
 
 		tpb->dispose();
 		tpb = nullptr;
@@ -343,18 +459,89 @@ Firebird::ITransaction* IscConnection::startTransaction()
 	catch( const FbException& error )
 	{
 		if( tpb ) tpb->dispose();
+		tr.tpb.clear();
 		THROW_ISC_EXCEPTION ( this, error.getStatus() );
 	}
 
-	if ( !tr.autoCommit )
-		tr.transactionPending = true;
+	tr.tpbIsolation = tr.transactionIsolation;
+	tr.tpbExtInit = tr.transactionExtInit;
+	tr.tpbLockTimeout = lockTimeout;
+	tr.tpbAutoCommit = serverAutoCommit;
 
-    return tr.transactionHandle;
+	return tr.tpb;
+}
+
+//
+// Whether a SELECT executed now reads in the read-only transaction of the
+// connection: the ReadOnlyQueries option is on, autocommit is, and the
+// transaction the statement would otherwise run in is an ordinary read
+// committed one, rather than a snapshot or one set by SET TRANSACTION.
+//
+bool IscConnection::useQueryTransaction()
+{
+	InfoTransaction	&tr = transactionInfo;
+
+	return readOnlyQueries && !shareConnected && tr.autoCommit && !tr.nodeParamTransaction
+		&& tr.transactionIsolation != 0x00000008L		// SQL_TXN_SERIALIZABLE
+		&& tr.transactionIsolation != 0x00000004L;		// SQL_TXN_REPEATABLE_READ
+}
+
+//
+// A read-only read committed transaction is committed by the server as
+// it starts, so it neither counts as active nor holds back garbage
+// collection; one is kept open for the life of the connection.
+//
+ITransaction* IscConnection::startQueryTransaction()
+{
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
+	InfoTransaction	&tr = queryTransactionInfo;
+
+	if ( tr.transactionHandle )
+		return tr.transactionHandle;
+
+	bool serverAutoCommit;
+	const std::vector<unsigned char> &tpb = getTpb( tr, serverAutoCommit );
+
+	ThrowStatusWrapper status( GDS->_status );
+	try
+	{
+		tr.transactionHandle =
+			attachment->databaseHandle->startTransaction( &status, (unsigned)tpb.size(), tpb.data() );
+	}
+	catch( const FbException& error )
+	{
+		THROW_ISC_EXCEPTION ( this, error.getStatus() );
+	}
+
+	return tr.transactionHandle;
+}
+
+void IscConnection::endQueryTransaction()
+{
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
+	InfoTransaction	&tr = queryTransactionInfo;
+
+	if ( !tr.transactionHandle || !attachment )
+		return;
+
+	ThrowStatusWrapper status( GDS->_status );
+	try
+	{
+		tr.transactionHandle->commit( &status );
+		tr.transactionHandle = nullptr;
+	}
+	catch( const FbException& )
+	{
+		status.clearException();
+		tr.transactionHandle->release();
+		tr.transactionHandle = nullptr;
+	}
 }
 
 Statement* IscConnection::createStatement()
 {
 	IscStatement *statement = new IscStatement (this);
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	statements.append (statement);
 
 	return statement;
@@ -363,6 +550,7 @@ Statement* IscConnection::createStatement()
 InternalStatement* IscConnection::createInternalStatement()
 {
 	IscOdbcStatement *statement = new IscOdbcStatement (this);
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	statements.append (statement);
 
 	return statement;
@@ -382,6 +570,12 @@ void IscConnection::freeHTML(const char * html)
 }
 ***/
 
+//
+// Fills the arguments of {call} left empty with parameter markers and
+// drops those past the input parameters of the procedure. Returns 1 when
+// output arguments were dropped, with string past the argument list,
+// 0 when the list is as it should be and -1 when it cannot be read.
+//
 int IscConnection::buildParamProcedure ( char *& string, int numInputParam )
 {
 	char * ptSrc = string;
@@ -400,8 +594,7 @@ int IscConnection::buildParamProcedure ( char *& string, int numInputParam )
 	{
 		char * ptCh = ptSrc++; // '('
 
-		while ( *ptSrc && *ptSrc != ')' )
-			ptSrc++;
+		ptSrc = (char*)IscSqlLexer::findSymbol( ptSrc, ")" );
 
 		if ( *ptSrc != ')' )
 			return -1;
@@ -415,108 +608,43 @@ int IscConnection::buildParamProcedure ( char *& string, int numInputParam )
 
 	int i = 0;
 	bool nextParam = false;
-	char * ptCh;
 
-	while( *ptSrc && i < numInputParam )
+	while( i < numInputParam )
 	{
 		SKIP_WHITE ( ptSrc );
 
-		if ( *ptSrc == ')' )
-		{
-			return 0;
-		}
-
-		if ( *ptSrc == ',' )
-		{
-			if ( nextParam == true )
-			{
-				nextParam = false;
-				ptSrc++;
-			}
-			else
-			{
-				i++;
-				memmove(ptSrc + 1, ptSrc, strlen(ptSrc) + 1 );
-				*ptSrc = '?';
-				ptSrc += 2;
-			}
-			continue;
-		}
-
-		char delimiter;
-
-		ptCh = ptSrc;
+		if ( !*ptSrc )
+			return -1;
 
-		if ( *ptCh == '\'' )
+		if ( *ptSrc == ',' || ( *ptSrc == ')' && nextParam ) )
 		{
-			delimiter = *ptCh;
-			++ptCh; // '\''
-			ptSrc = ptCh;
-			while ( *ptCh )
-			{
-				if ( *ptCh == delimiter )
-				{
-					if ( *(ptCh+1) == delimiter )
-					{
-						ptCh += 2;
-						continue;
-					}
-					break;
-				}
-				++ptCh;
-			}
-
-			if ( *ptCh == delimiter )
-				++ptCh;
-
-			if ( *ptCh && *ptCh != ',' )
-			{
-				ptSrc = ptCh;
-				i++;
-				break;
-			}
-
-			if ( !*ptCh )
-				break;
-
-			nextParam = true;
+			// an empty argument is a parameter
+			memmove(ptSrc + 1, ptSrc, strlen(ptSrc) + 1 );
+			*ptSrc++ = '?';
 		}
+		else if ( *ptSrc == ')' )
+			return 0;
 		else
-		{
-			delimiter = ',';
-			ptSrc = ptCh;
-			while ( *ptCh && *ptCh != delimiter && *ptCh != ')' )
-				++ptCh;
-
-			if ( *ptCh && *ptCh != delimiter )
-			{
-				ptSrc = ptCh;
-				i++;
-				break;
-			}
+			ptSrc = (char*)IscSqlLexer::findSymbol( ptSrc, ",)" );
 
-			if ( !*ptCh )
-				break;
+		i++;
 
-			nextParam = false;
-		}
+		if ( *ptSrc != ',' )
+			break;
 
-		if( ptCh == ptSrc )
-			ptSrc++;
-		else
-		{
-			ptSrc = ptCh + 1;
-			i++;
-		}
+		ptSrc++; // ','
+		nextParam = true;
 	}
 
-	if ( *(ptSrc-1) == ',' )
+	if ( i == numInputParam && *(ptSrc-1) == ',' )
 	{
-		ptCh = --ptSrc;
+		char * ptCh = --ptSrc;
 		//  ok, it's output param
 
-		while ( *ptCh && *ptCh != ')' )
-			ptCh++;
+		ptCh = (char*)IscSqlLexer::findSymbol( ptCh + 1, ")" );
+
+		if ( *ptCh != ')' )
+			return -1;
 
 		memmove(ptSrc, ptCh, strlen(ptCh) + 1 );
 		string = ptSrc + 1;
@@ -1035,13 +1163,9 @@ bool IscConnection::removeSchemaFromSQL( char *strSql, int lenSql, char *strSqlO
 	ListSchemaIdentifier listSchemaIdentifierTbl;
 	int countNodesShema = 0;
 	int countTblNodesShema = 0;
-	int statysModify = 0;
-	int statusQuote = 0;
 	char *beg = strSql;
 	char *ptIn = strSql;
-	char *ptInEnd = strSql + lenSql;
 	char *ptOut = strSqlOut;
-	char quote;
 	char chUpper;
 	bool success = true;
 	bool defTable = false;
@@ -1058,165 +1182,100 @@ bool IscConnection::removeSchemaFromSQL( char *strSql, int lenSql, char *strSqlO
 		|| ( chUpper == 'D' && !IS_MATCH( ptIn, "DELETE" ) ) )
 		return false;
 
-	while ( ptIn < ptInEnd )
+	IscSqlLexer lexer( strSql, lenSql );
+	SqlToken token;
+
+	while ( lexer.next( token ) )
 	{
-		if ( !statusQuote )
+		if ( token.kind == 'w' )
 		{
-			chUpper = UPPER( *ptIn );
-
-			switch ( chUpper )
-			{
-			case 'S':
-				if ( IS_MATCH( ptIn, "SELECT" ) )
-				{
-					ptIn += 6;
-					defTable = false;
-				}
-				else if ( IS_MATCH( ptIn, "SET" ) )
-				{
-					ptIn += 3;
-					defTable = false;
-				}
-				break;
+			if ( lexer.isWord( token, "INSERT" ) || lexer.isWord( token, "UPDATE" ) || lexer.isWord( token, "FROM" ) )
+				defTable = true;
+			else if ( lexer.isWord( token, "SELECT" ) || lexer.isWord( token, "SET" ) || lexer.isWord( token, "VALUES" )
+					|| lexer.isWord( token, "WHERE" ) || lexer.isWord( token, "ON" ) )
+				defTable = false;
+			continue;
+		}
 
-			case 'I':
-				if ( IS_MATCH( ptIn, "INSERT" ) )
-				{
-					ptIn += 6;
-					defTable = true;
-				}
-				break;
+		ptIn = strSql + token.begin;
 
-			case 'U':
-				if ( IS_MATCH( ptIn, "UPDATE" ) )
-				{
-					ptIn += 6;
-					defTable = true;
-				}
-				break;
+		if ( token.kind != '.' || ptIn == beg || ptIn[1] == '*' )
+			continue;
 
-			case 'F':
-				if ( IS_MATCH( ptIn, "FROM" ) )
-				{
-					ptIn += 4;
-					defTable = true;
-				}
-				break;
+		do
+		{
+			bool digit = true;
+			char quoteTmp = 0;
+			char *pt = ptIn - 1;
 
-			case 'V':
-				if ( IS_MATCH( ptIn, "VALUES" ) )
+			if ( IS_QUOTE( *pt ) )
+			{
+				quoteTmp = *pt--;
+				digit = false;
+				while ( pt >= beg && IS_IDENT( *pt ) )
 				{
-					ptIn += 6;
-					defTable = false;
+					--pt;
 				}
-				break;
-
-			case 'W':
-				if ( IS_MATCH( ptIn, "WHERE" ) )
+				if ( pt < beg || *pt != quoteTmp )
 				{
-					ptIn += 5;
-					defTable = false;
+					success = false;
+					break;
 				}
-				break;
-
-			case 'O':
-				if ( IS_MATCH( ptIn, "ON" ) )
+			}
+			else
+			{
+				while ( pt >= beg && IS_IDENT( *pt ) )
 				{
-					ptIn += 2;
-					defTable = false;
+					if ( digit && !ISDIGIT( *pt ) )
+						digit = false;
+					--pt;
 				}
-				break;
-
-			case '.':
-				if ( (*ptIn + 1) != '*' )
-				{
-					do
-					{
-						bool digit = true;
-						char quoteTmp = 0;
-						char *pt = ptIn - 1;
-
-						if ( IS_QUOTE( *pt ) )
-						{
-							quoteTmp = *pt--;
-							digit = false;
-							while ( pt >= beg && IS_IDENT( *pt ) )
-							{
-								--pt;
-							}
-							if ( *pt != quoteTmp )
-							{
-								success = false;
-								break;
-							}
-						}
-						else
-						{
-							while ( pt >= beg && IS_IDENT( *pt ) )
-							{
-								if ( digit && !ISDIGIT( *pt ) )
-									digit = false;
-								--pt;
-							}
-
-							++pt;
-						}
 
-						if ( !digit )
-						{
-							bool deleteNode = false;
-							char *ptEnd = pt;
+				++pt;
+			}
 
-							pt = ptIn + 1;
+			if ( !digit )
+			{
+				bool deleteNode = false;
+				char *ptEnd = pt;
 
-							while ( !(IS_END_TOKEN( *pt )) )
-							{
-								if ( IS_POINT( *pt ) && !deleteNode )
-								{
-									deleteNode = true;
-
-									if ( defTable )
-										ptIn = pt;
-								}
-								++pt;
-							}
+				pt = ptIn + 1;
 
-							CSchemaIdentifier &node = listSchemaIdentifierAll( countNodesShema++ );
+				while ( !(IS_END_TOKEN( *pt )) )
+				{
+					if ( IS_POINT( *pt ) && !deleteNode )
+					{
+						deleteNode = true;
 
-							node.stringSql = strSql;
-							node.deleteNode = deleteNode;
-							node.quotedNode = !!quoteTmp;
-							node.begNameNode = ptEnd - beg;
-							node.lengthNameNode = ptIn - ptEnd;
+						if ( defTable )
+							ptIn = pt;
+					}
+					++pt;
+				}
 
-							if ( defTable )
-							{
-								CSchemaIdentifier &nodeDef = listSchemaIdentifierTbl( countTblNodesShema++ );
-								nodeDef = node;
-								node.deleteNode = true;
-							}
+				CSchemaIdentifier &node = listSchemaIdentifierAll( countNodesShema++ );
 
-							ptIn = pt;
-						}
+				node.stringSql = strSql;
+				node.deleteNode = deleteNode;
+				node.quotedNode = !!quoteTmp;
+				node.begNameNode = ptEnd - beg;
+				node.lengthNameNode = ptIn - ptEnd;
 
-					} while ( false );
+				if ( defTable )
+				{
+					CSchemaIdentifier &nodeDef = listSchemaIdentifierTbl( countTblNodesShema++ );
+					nodeDef = node;
+					node.deleteNode = true;
 				}
-				break;
 
-			case '\"':
-			case '\'':
-				quote = *ptIn;
-				statusQuote ^= 1;
-				break;
+				ptIn = pt;
 			}
-		}
-		else if ( quote == *ptIn )
-		{
-			quote = 0;
-			statusQuote ^= 1;
-		}
 
-		++ptIn;
+		} while ( false );
+
+		// go on from the end of the qualified name
+		if ( ptIn > strSql + token.begin )
+			lexer.moveTo( ptIn - beg );
 	}
 
 	if ( countTblNodesShema )
@@ -1285,9 +1344,66 @@ bool IscConnection::removeSchemaFromSQL( char *strSql, int lenSql, char *strSqlO
 	return success;
 }
 
+//
+// Statements the driver runs itself or rewrites besides escape sequences:
+// transaction control, CREATE DATABASE, TINYINT columns and queries in
+// parentheses.
+//
+static bool isDriverStatement( const char *sql )
+{
+	SKIP_WHITE ( sql );
+
+	return *sql == '('
+		|| IS_MATCH( sql, "COMMIT" ) || IS_MATCH( sql, "ROLLBACK" ) || IS_MATCH( sql, "SET" )
+		|| IS_MATCH( sql, "DECLARE" ) || IS_MATCH( sql, "CREATE" ) || IS_MATCH( sql, "ALTER" );
+}
+
+//
+// A word starting in upper case with lower case letters in it, or the
+// other way round, keeps its case in quotes.
+//
+static bool isMixedCase( const char *word, size_t length )
+{
+	const char *end = word + length;
+	bool upper = ISUPPER( *word );
+
+	for ( const char *p = word; p < end; ++p )
+		if ( upper ? ISLOWER( *p ) : ISUPPER( *p ) )
+			return true;
+
+	return false;
+}
+
+//
+// Text prepared over and over is translated once: the translation is
+// kept with the options it depends on. Statements the driver runs itself
+// are translated every time for what that does to the connection.
+//
 int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 								char * outStatementText, int bufferLength,
 								int * textLength2Ptr)
+{
+	const char options[] = { (char)( '0' + attachment->databaseDialect ),
+							 attachment->autoQuotedIdentifier ? 'Q' : '-',
+							 (char)( '0' + attachment->useSchemaIdentifier ), 0 };
+	int ret;
+
+	if ( nativeSqlCache->find( inStatementText, textLength1, options,
+							   outStatementText, bufferLength, textLength2Ptr, ret ) )
+		return ret;
+
+	ret = translateNativeSql( inStatementText, textLength1, outStatementText, bufferLength, textLength2Ptr );
+
+	if ( ret >= 0 )
+		nativeSqlCache->add( inStatementText, textLength1, options, outStatementText,
+							 textLength2Ptr ? *textLength2Ptr : (int)strlen( outStatementText ), ret );
+
+	return ret;
+}
+
+int IscConnection::translateNativeSql (const char * inStatementText, int textLength1,
+								char * outStatementText, int bufferLength,
+								int * textLength2Ptr)
 {
 	int statysModify = 0;
 	char * ptIn = (char*)inStatementText;
@@ -1296,8 +1412,6 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 	char * ptEndBracket = NULL;
 	int ignoreBracket = 0;
 	int statusQuote = 0;
-	int statusBracket = 0;
-	char quote;
 	char delimiter = *metaData->getIdentifierQuoteString();
 	delimiter = delimiter == ' ' || attachment->databaseDialect < 3 ? 0 : delimiter;
 
@@ -1312,121 +1426,87 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 
 		if ( statysModify )
 		{
-			ptIn = ptOut;
-			textLength1= *textLength2Ptr;
+			// read it from the end of the buffer, so that quoting identifiers
+			// cannot overwrite the text still to be read
+			textLength1 = *textLength2Ptr;
+			ptIn = outStatementText + bufferLength - textLength1 - 1;
+			memmove( ptIn, outStatementText, textLength1 + 1 );
 			ptInEnd = ptIn + textLength1;
 		}
 	}
 
+	if ( !statysModify && !autoQuoted && !IscSqlLexer::findEscape( ptIn, textLength1 ) && !isDriverStatement( ptIn ) )
+	{
+		// nothing to translate, the text is used as it is
+		if ( textLength2Ptr )
+			*textLength2Ptr = textLength1;
+		return statysModify;
+	}
+
 	SKIP_WHITE ( ptIn );
 
 	bool externalBracket = *ptIn == '(';
+	std::vector<size_t> braces;		// offsets of '{' in the output
+	IscSqlLexer lexer( ptIn, ptInEnd - ptIn );
+	SqlToken token;
 
-	while ( ptIn < ptInEnd )
+	while ( lexer.next( token ) )
 	{
-		if ( !statusQuote )
+		const char *start = ptIn + token.begin;
+		size_t length = token.end - token.begin;
+
+		switch ( token.kind )
 		{
-			if ( IS_QUOTE( *ptIn ) )
+		case '\'':
+		case '"':
+			if ( !token.closed )
+				statusQuote = 1;
+			break;
+
+		case '{':
+			braces.push_back( ptOut - outStatementText );
+			break;
+
+		case 'w':
+		case 'n':
+			if ( externalBracket && !token.depth && !lexer.isWord( token, "UNION" )
+					&& !lexer.isWord( token, "ALL" ) && !lexer.isWord( token, "DISTINCT" ) )
+				externalBracket = false;
+
+			if ( autoQuoted && isMixedCase( start, length ) )
 			{
-				quote = *ptIn;
-				statusQuote ^= 1;
+				*ptOut++ = delimiter;
+				memmove( ptOut, start, length );
+				ptOut += length;
+				*ptOut++ = delimiter;
+				statysModify++;
+				continue;
 			}
-			else if ( *ptIn == '{' )
-				ptEndBracket = ptOut;
-			else if ( autoQuoted && IS_IDENT ( *ptIn ) )
-			{
-				bool mixed = false;
-				char * pt = ptIn;
-				
-				if ( ISUPPER ( *ptIn ) )
-				{
-					while ( IS_IDENT ( *pt ) )
-					{
-						if ( ISLOWER ( *pt ) )
-						{
-							mixed = true;
-							break;
-						}
-						pt++;
-					}
-				}
-				else
-				{
-					while ( IS_IDENT ( *pt ) )
-					{
-						if ( ISUPPER ( *pt ) )
-						{
-							mixed = true;
-							break;
-						}
-						pt++;
-					}
-				}
-
-				if ( mixed )
-				{
-					*ptOut++ = delimiter;
-					 
-					while ( IS_IDENT ( *ptIn ) )
-						*ptOut++ = *ptIn++;
+			break;
 
-					*ptOut++ = delimiter;
-					statysModify++;
-				}
-				else
-					while ( IS_IDENT ( *ptIn ) )
-						*ptOut++ = *ptIn++;
+		case '(':
+		case ')':
+			// Probably it "(select ...) union (select ...)"
+			// convert to  " select ...  union  select ... "
+			if ( externalBracket && token.depth == ( token.kind == '(' ? 0 : 1 ) )
+			{
+				*ptOut++ = ' ';
+				++statysModify;
 				continue;
 			}
-			else if ( externalBracket )	// Probably it "(select ...) union (select ...)"
-			{							// convert to  " select ...  union  select ... "
-				if ( !statusBracket )
-				{
-					while ( IS_WHITE ( *ptIn ) )
-						*ptOut++ = *ptIn++;
-
-					if ( *ptIn == '(' )
-					{
-						*ptIn = ' ';
-						++statusBracket;
-						++statysModify;
-					}
-					else
-						externalBracket = false;
-				}
-				else
-				{
-					if ( *ptIn == ')' )
-					{
-						if ( !--statusBracket )
-						{
-							*ptIn = ' ';
-							++statysModify;
-							externalBracket = false;
+			break;
 
-							while ( IS_WHITE ( *ptIn ) )
-								*ptOut++ = *ptIn++;
+		case ' ':
+		case 'c':
+			break;
 
-							if ( IS_MATCH( ptIn, "UNION" ) )
-							{
-								externalBracket = true;
-
-								while ( IS_IDENT ( *ptIn ) )
-									*ptOut++ = *ptIn++;
-							}
-							continue;
-						}
-					}
-				}
-			}
-		}
-		else if ( quote == *ptIn )
-		{
-			quote = 0;
-			statusQuote ^= 1;
+		default:
+			if ( !token.depth )
+				externalBracket = false;
 		}
 
-		*ptOut++ = *ptIn++;
+		memmove( ptOut, start, length );
+		ptOut += length;
 	}
 
 	if ( statusQuote ) // There is no '"' or '\'' a syntactic mistake
@@ -1438,7 +1518,7 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 
 	*ptOut = '\0';
 
-	if ( !ptEndBracket )
+	if ( braces.empty() )
 	{
 		if ( textLength2Ptr )
 			*textLength2Ptr = ptOut - outStatementText;
@@ -1522,8 +1602,11 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 	}
 	else
 	{
-		while ( ptEndBracket )
+		// the last first, the text before it stays where it is
+		while ( !braces.empty() )
 		{
+			ptEndBracket = outStatementText + braces.back();
+			braces.pop_back();
 			ptIn = ptEndBracket;
 
 			ptIn++; // '{'
@@ -1658,31 +1741,14 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 
 				ptOut = ptIn;
 
-				statusQuote = 0;
-				quote = 0;
-
 				do
 				{
-					while( *ptIn )
-					{
-						if ( !statusQuote )
-						{
-							if ( IS_QUOTE( *ptIn ) )
-							{
-								quote = *ptIn;
-								statusQuote ^= 1;
-							}
-							else if ( *ptIn == '}' )
-								break;
-						}
-						else if ( quote == *ptIn )
-						{
-							quote = 0;
-							statusQuote ^= 1;
-						}
+					char *close = (char*)IscSqlLexer::findSymbol( ptIn, "}" );
+					size_t length = close - ptIn;
 
-						*ptOut++ = *ptIn++;
-					}
+					memmove( ptOut, ptIn, length );
+					ptOut += length;
+					ptIn = close;
 
 					if( ignoreBr )
 						*ptOut++ = *ptIn++;
@@ -1730,31 +1796,15 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 				}
 
 				int ignoreBr = ignoreBracket;
-				statusQuote = 0;
-				quote = 0;
 
 				do
 				{
-					while( *ptIn )
-					{
-						if ( !statusQuote )
-						{
-							if ( IS_QUOTE( *ptIn ) )
-							{
-								quote = *ptIn;
-								statusQuote ^= 1;
-							}
-							else if ( *ptIn == '}' )
-								break;
-						}
-						else if ( quote == *ptIn )
-						{
-							quote = 0;
-							statusQuote ^= 1;
-						}
+					char *close = (char*)IscSqlLexer::findSymbol( ptIn, "}" );
+					size_t length = close - ptIn;
 
-						*ptOut++ = *ptIn++;
-					}
+					memmove( ptOut, ptIn, length );
+					ptOut += length;
+					ptIn = close;
 
 					if( ignoreBr )
 						*ptOut++ = *ptIn++;
@@ -1772,35 +1822,6 @@ int IscConnection::getNativeSql (const char * inStatementText, int textLength1,
 				*ptOut = '\0';
 				statysModify = 1;
 			}
-
-			--ptEndBracket; // '{'
-
-			statusQuote = 0;
-			quote = 0;
-
-			while ( ptEndBracket > outStatementText )
-			{
-				if ( !statusQuote )
-				{
-					if ( IS_QUOTE( *ptEndBracket ) )
-					{
-						quote = *ptEndBracket;
-						statusQuote ^= 1;
-					}
-					else if ( *ptEndBracket == '{' )
-						break;
-				}
-				else if ( quote == *ptEndBracket )
-				{
-					quote = 0;
-					statusQuote ^= 1;
-				}
-
-				--ptEndBracket;
-			}
-
-			if(*ptEndBracket != '{')
-				ptEndBracket = NULL;
 		}
 
 		if ( textLength2Ptr )
@@ -1852,6 +1873,27 @@ WCSTOMBS IscConnection::getConnectionWcsToMbs()
 	return adressWcsToMbs( attachment->charsetCode );
 }
 
+void IscConnection::getStatementCacheStatistics( int &hits, int &misses, int &entries )
+{
+	statementCache->getStatistics( hits, misses, entries );
+}
+
+void IscConnection::getNativeSqlCacheStatistics( int &hits, int &misses, int &entries )
+{
+	nativeSqlCache->getStatistics( hits, misses, entries );
+}
+
+void IscConnection::getConnectionPoolStatistics( int &hits, int &misses, int &idle )
+{
+	attachmentPool.getStatistics( hits, misses, idle );
+}
+
+void IscConnection::getClientLibraryStatistics( int &loads, int &users )
+{
+	if ( GDS )
+		GDS->getStatistics( loads, users );
+}
+
 MBSTOWCS IscConnection::getConnectionMbsToWcs()
 {
 	return adressMbsToWcs( attachment->charsetCode );
@@ -1925,12 +1967,33 @@ void IscConnection::openDatabase(const char * dbName, Properties * properties)
 {
 	try
 	{
-		attachment = new Attachment;
-		attachment->openDatabase (dbName, properties);
+		std::string poolKey;
+		bool pooled = false;
+
+		if ( AttachmentPool::makeKey( dbName, properties, poolKey ) )
+			pooled = ( attachment = attachmentPool.take( poolKey ) ) != NULL;
+
+		if ( !pooled )
+		{
+			attachment = new Attachment;
+			attachment->openDatabase (dbName, properties);
+			attachment->poolKey = poolKey;
+		}
+
 		databaseHandle = attachment->databaseHandle;
 		GDS = attachment->GDS;
 
-		if ( databaseHandle && !attachment->isRoles && !attachment->admin )
+		const char *cacheSize = properties->findValue ("statementCache", NULL);
+		const char *cacheMemory = properties->findValue ("statementCacheMemory", NULL);
+
+		if ( cacheSize && *cacheSize )
+			statementCache->setLimits( atoi( cacheSize ),
+				cacheMemory && *cacheMemory ? atoi( cacheMemory ) : DEFAULT_STATEMENT_CACHE_MEMORY );
+
+		const char *readOnly = properties->findValue ("readOnlyQueries", NULL);
+		readOnlyQueries = readOnly && *readOnly == 'Y';
+
+		if ( !pooled && databaseHandle && !attachment->isRoles && !attachment->admin )
 		{
 			IscTablePrivilegesResultSet resultSet ( (IscDatabaseMetaData *)getMetaData() );
 			resultSet.allTablesAreSelectable = true;
@@ -1977,6 +2040,7 @@ void IscConnection::openDatabase(const char * dbName, Properties * properties)
 void IscConnection::deleteStatement(IscStatement * statement)
 {
 //From R. Milharcic
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
  	statements.deleteItem (statement);
 }
 
@@ -2061,11 +2125,16 @@ Connection* IscConnection::clone()
 
 void IscConnection::setAutoCommit(bool setting)
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if( !tr.autoCommit && setting && tr.transactionPending )
 		commitAuto();
 
+	// the server would go on committing every statement of the transaction
+	if( tr.autoCommit && !setting && tr.serverAutoCommit && tr.transactionHandle )
+		commit();
+
 	tr.autoCommit = setting;
 }
 
@@ -2087,6 +2156,12 @@ void IscConnection::setCatalog(const char* catalog)
 
 void IscConnection::setTransactionIsolation(int level)
 {
+	InfoTransaction	&tr = transactionInfo;
+
+	// nothing else would end the transaction the server commits
+	if ( tr.serverAutoCommit && tr.transactionHandle && level != tr.transactionIsolation )
+		commit();
+
 	transactionInfo.transactionIsolation = level;
 }
 
@@ -2184,22 +2259,28 @@ CallableStatement* IscConnection::prepareCall(const char * sqlString)
 		throw;
 		}
 
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	statements.append (statement);
 	return statement;
 }
 
 void IscConnection::commitAuto()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	bool callRetaining = false;
 
+	// an open cursor or a BLOB parameter still being sent needs the transaction
 	FOR_OBJECTS (IscStatement*, statement, &statements)
-		if ( statement->isActiveCursor() )
+		if ( ( statement->isActiveCursor() || statement->streamBlobs ) && !statement->queryTransaction )
 			callRetaining = true;
 		else if ( statement->isActiveLocalTransaction() )
 			statement->commitLocal();
 	END_FOR;
 
-	if ( callRetaining )
+	// the server has committed the statement itself
+	if ( transactionInfo.serverAutoCommit && transactionInfo.transactionHandle )
+		transactionInfo.transactionPending = false;
+	else if ( callRetaining )
 		commitRetaining();
 	else
 		commit();
@@ -2207,16 +2288,21 @@ void IscConnection::commitAuto()
 
 void IscConnection::rollbackAuto()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	bool callRetaining = false;
 
 	FOR_OBJECTS (IscStatement*, statement, &statements)
-		if ( statement->isActiveCursor() )
+		if ( ( statement->isActiveCursor() || statement->streamBlobs ) && !statement->queryTransaction )
 			callRetaining = true;
 		else if ( statement->isActiveLocalTransaction() )
 			statement->rollbackLocal();
 	END_FOR;
 
-	if ( callRetaining )
+	// a statement that failed has been undone by the server, the ones
+	// before it are committed
+	if ( transactionInfo.serverAutoCommit && transactionInfo.transactionHandle )
+		transactionInfo.transactionPending = false;
+	else if ( callRetaining )
 		rollbackRetaining();
 	else
 		rollback();
@@ -2229,6 +2315,7 @@ int IscConnection::getDatabaseDialect()
 
 void IscConnection::commitRetaining()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if ( tr.transactionHandle )
@@ -2249,6 +2336,7 @@ void IscConnection::commitRetaining()
 
 void IscConnection::rollbackRetaining()
 {
+	std::lock_guard<std::recursive_mutex> guard( transactionMutex );
 	InfoTransaction	&tr = transactionInfo;
 
 	if ( tr.transactionHandle )
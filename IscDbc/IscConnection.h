@@ -28,6 +28,8 @@
 #include "Connection.h"
 #include "LinkedList.h"
 #include "JString.h"	// Added by ClassView
+#include <vector>
+#include <mutex>
 
 namespace IscDbcLibrary {
 
@@ -54,6 +56,13 @@ public:
 	int				transactionExtInit;
 	bool			autoCommit;
 	bool			transactionPending;
+	bool			serverAutoCommit;	// started with isc_tpb_autocommit, the server commits every statement
+
+	std::vector<unsigned char> tpb;		// built for the settings below, again when they change
+	int				tpbIsolation;
+	int				tpbExtInit;
+	int				tpbLockTimeout;
+	bool			tpbAutoCommit;
 
 	CNodeParamTransaction *nodeParamTransaction;
 };
@@ -62,6 +71,8 @@ class IscStatement;
 class IscDatabaseMetaData;
 class Attachment;
 class IscUserEvents;
+class IscStatementCache;
+class IscNativeSqlCache;
 
 class IscConnection : public Connection  
 {
@@ -119,7 +130,15 @@ public:
 	virtual int getNativeSql (const char * inStatementText, int textLength1,
 								char * outStatementText, int bufferLength,
 								int * textLength2Ptr);
+	int translateNativeSql (const char * inStatementText, int textLength1,
+								char * outStatementText, int bufferLength,
+								int * textLength2Ptr);
 	Firebird::ITransaction* startTransaction();
+	const std::vector<unsigned char>& getTpb( InfoTransaction &tr, bool &serverAutoCommit );
+	bool useQueryTransaction();
+	Firebird::ITransaction* startQueryTransaction();
+	void endQueryTransaction();
+	void releaseToPool();
 	void deleteStatement (IscStatement *statement);
 	IscConnection();
 	~IscConnection();
@@ -130,6 +149,10 @@ public:
 	virtual int getConnectionCharsetCode();
 	virtual WCSTOMBS getConnectionWcsToMbs();
 	virtual MBSTOWCS getConnectionMbsToWcs();
+	virtual void getStatementCacheStatistics( int &hits, int &misses, int &entries );
+	virtual void getNativeSqlCacheStatistics( int &hits, int &misses, int &entries );
+	virtual void getConnectionPoolStatistics( int &hits, int &misses, int &idle );
+	virtual void getClientLibraryStatistics( int &loads, int &users );
 	virtual int hasRole (const char *schemaName, const char *roleName);
 	virtual PropertiesEvents* allocPropertiesEvents();
 	virtual UserEvents* prepareUserEvents( PropertiesEvents *context, callbackEvent astRoutine, void *userAppData = 0 );
@@ -154,9 +177,15 @@ public:
 	CFbDll			*GDS;
 	Firebird::IAttachment* databaseHandle;
 	InfoTransaction	transactionInfo;
+	InfoTransaction	queryTransactionInfo;	// read-only, read committed, shared by the SELECTs in autocommit mode
+	bool			readOnlyQueries;
 	LinkedList		statements;
+	std::recursive_mutex	transactionMutex;	// the transactions and the statements, for the statements used from several threads
+	std::mutex		cancelMutex;		// the cancels sent and the end of the calls to the server they are meant for
 	IscDatabaseMetaData	*metaData;
 	IscUserEvents	*userEvents;
+	IscStatementCache	*statementCache;
+	IscNativeSqlCache	*nativeSqlCache;
 	bool			shareConnected;
 	int				useAppOdbcVersion;
 	int				useCount;
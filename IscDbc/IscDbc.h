@@ -182,6 +182,7 @@ void getStatInformations(IscConnection *connection, char bVanCall);
 int getStatInformations(IscConnection *connection, const void * info_buffer, int bufferLength,short *lengthPtr);
 int findCharsetsCode( const char *charset );
 int getCharsetSize( int charsetCode );
+const char* getCharsetName( int charsetCode );
 }; // end namespace IscDbcLibrary
 
 #endif
@@ -0,0 +1,523 @@
+// IscExecuteBlock.cpp: implementation of the IscExecuteBlock class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include "IscDbc.h"
+#include "IscExecuteBlock.h"
+#include "IscSqlLexer.h"
+#include "IscStatement.h"
+#include "IscConnection.h"
+#include "SQLError.h"
+
+using namespace Firebird;
+
+namespace IscDbcLibrary {
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscExecuteBlock::IscExecuteBlock( IscStatement *stmt )
+{
+	statement = stmt;
+	rowMeta = NULL;
+	countParams = 0;
+	lengthRow = 0;
+	rowsPerBlock = 1;
+	countRows = 0;
+}
+
+IscExecuteBlock::~IscExecuteBlock()
+{
+	clearBlocks();
+
+	if ( rowMeta )
+		rowMeta->release();
+}
+
+void IscExecuteBlock::releaseBlock( Block &block )
+{
+	if ( block.output )
+		block.output->release();
+	if ( block.input )
+		block.input->release();
+	block.output = block.input = NULL;
+
+	if ( !block.statement )
+		return;
+
+	// once the connection is gone only the interface is left to release
+	if ( statement->connection )
+	{
+		ThrowStatusWrapper status( statement->connection->GDS->_status );
+		try
+		{
+			block.statement->free( &status );
+			block.statement = NULL;
+			return;
+		}
+		catch( const FbException& )
+		{
+			status.clearException();
+		}
+	}
+
+	block.statement->release();
+	block.statement = NULL;
+}
+
+void IscExecuteBlock::clearBlocks()
+{
+	for ( auto &entry : blocks )
+		releaseBlock( entry.second );
+
+	blocks.clear();
+}
+
+//
+// Splits the statement text at its parameter markers, dropping comments
+// so that the text can be repeated on the lines of a block.
+//
+bool IscExecuteBlock::split()
+{
+	IscSqlLexer lexer( statement->sql );
+	SqlToken token;
+	std::string piece;
+
+	pieces.clear();
+
+	while ( lexer.next( token ) )
+	{
+		if ( token.kind == 'c' )
+			piece += ' ';
+		else if ( token.kind == '?' )
+		{
+			pieces.push_back( piece );
+			piece.clear();
+		}
+		else
+			piece.append( lexer.text + token.begin, token.end - token.begin );
+	}
+
+	size_t end = piece.find_last_not_of( " \t\r\n;" );
+	piece.erase( end == std::string::npos ? 0 : end + 1 );
+	pieces.push_back( piece );
+
+	return pieces.size() == (size_t)statement->inputSqlda.columnsCount + 1;
+}
+
+//
+// Works out the declarations of the parameters of a block from the
+// message layout of one parameter set and how many sets a block takes.
+// A set the block cannot declare leaves rowsPerBlock at 1.
+//
+void IscExecuteBlock::design( IMessageMetadata *meta )
+{
+	clearBlocks();
+
+	if ( rowMeta )
+		rowMeta->release();
+	meta->addRef();
+	rowMeta = meta;
+
+	rowsPerBlock = 1;
+	offsetData.clear();
+	offsetNull.clear();
+	lengthData.clear();
+	types.clear();
+
+	ThrowStatusWrapper status( statement->connection->GDS->_status );
+	try
+	{
+		countParams = meta->getCount( &status );
+		lengthRow = meta->getMessageLength( &status );
+
+		for ( unsigned n = 0; n < countParams; ++n )
+		{
+			unsigned type = meta->getType( &status, n ) & ~1;
+			int scale = meta->getScale( &status, n );
+			unsigned length = meta->getLength( &status, n );
+			int charset = meta->getCharSet( &status, n );
+			const char *charsetName = getCharsetName( charset );
+			char declaration[128];
+
+			switch ( type )
+			{
+			case SQL_TEXT:
+			case SQL_VARYING:
+				{
+					int size = getCharsetSize( charset );
+
+					if ( !charsetName || !length || length % size )
+						return;
+
+					sprintf( declaration, "%s(%u) CHARACTER SET %s",
+							 type == SQL_TEXT ? "CHAR" : "VARCHAR", length / size, charsetName );
+				}
+				break;
+
+			case SQL_SHORT:
+			case SQL_LONG:
+			case SQL_INT64:
+				if ( scale < 0 )
+					sprintf( declaration, "NUMERIC(%d, %d)", type == SQL_SHORT ? 4 : type == SQL_LONG ? 9 : 18, -scale );
+				else
+					strcpy( declaration, type == SQL_SHORT ? "SMALLINT" : type == SQL_LONG ? "INTEGER" : "BIGINT" );
+				break;
+
+			case SQL_FLOAT:
+				strcpy( declaration, "FLOAT" );
+				break;
+
+			case SQL_DOUBLE:
+			case SQL_D_FLOAT:
+				strcpy( declaration, "DOUBLE PRECISION" );
+				break;
+
+			case SQL_TIMESTAMP:
+				strcpy( declaration, "TIMESTAMP" );
+				break;
+
+			case SQL_TYPE_DATE:
+				strcpy( declaration, "DATE" );
+				break;
+
+			case SQL_TYPE_TIME:
+				strcpy( declaration, "TIME" );
+				break;
+
+			case SQL_BOOLEAN:
+				strcpy( declaration, "BOOLEAN" );
+				break;
+
+			case SQL_BLOB:
+				{
+					int subType = meta->getSubType( &status, n );
+
+					if ( subType == 1 && charsetName )
+						sprintf( declaration, "BLOB SUB_TYPE TEXT CHARACTER SET %s", charsetName );
+					else
+						sprintf( declaration, "BLOB SUB_TYPE %d", subType );
+				}
+				break;
+
+			default:
+				return;
+			}
+
+			types.push_back( declaration );
+			offsetData.push_back( meta->getOffset( &status, n ) );
+			offsetNull.push_back( meta->getNullOffset( &status, n ) );
+			lengthData.push_back( type == SQL_VARYING ? length + sizeof( short ) : length );
+		}
+	}
+	catch( const FbException& error )
+	{
+		THROW_ISC_EXCEPTION( statement->connection, error.getStatus() );
+	}
+
+	// every set adds its parameters and an update count to the block, and
+	// its message, with alignment, to the block message
+	unsigned rows = EXECUTE_BLOCK_MAX_PARAMS / ( countParams + 1 );
+	rows = MIN( rows, EXECUTE_BLOCK_MESSAGE_BYTES / ( lengthRow + 8 ) );
+
+	std::string blockSql;
+
+	while ( rows > 1 )
+	{
+		buildSql( rows, blockSql );
+
+		if ( blockSql.length() <= EXECUTE_BLOCK_TEXT_BYTES )
+			break;
+
+		rows = (unsigned)( (size_t)rows * EXECUTE_BLOCK_TEXT_BYTES / blockSql.length() );
+	}
+
+	rowsPerBlock = MAX( rows, 1 );
+}
+
+//
+// EXECUTE BLOCK (P1_1 type = ?, ..., P2_1 type = ?, ...)
+// RETURNS (R1 INTEGER, R2 INTEGER, ...)
+// AS
+// BEGIN
+// statement with :P1_1, ...;
+// R1 = ROW_COUNT;
+// ...
+// SUSPEND;
+// END
+//
+// The update counts come back as the single row the block returns.
+//
+void IscExecuteBlock::buildSql( unsigned rows, std::string &blockSql )
+{
+	char name[48];
+
+	blockSql = "EXECUTE BLOCK";
+
+	if ( countParams )
+	{
+		blockSql += " (";
+
+		for ( unsigned r = 1; r <= rows; ++r )
+			for ( unsigned n = 0; n < countParams; ++n )
+			{
+				sprintf( name, "%sP%u_%u ", r == 1 && !n ? "" : ", ", r, n + 1 );
+				blockSql += name;
+				blockSql += types[n];
+				blockSql += " = ?";
+			}
+
+		blockSql += ")";
+	}
+
+	blockSql += "\nRETURNS (";
+
+	for ( unsigned r = 1; r <= rows; ++r )
+	{
+		sprintf( name, "%sR%u INTEGER", r == 1 ? "" : ", ", r );
+		blockSql += name;
+	}
+
+	blockSql += ")\nAS\nBEGIN\n";
+
+	for ( unsigned r = 1; r <= rows; ++r )
+	{
+		blockSql += pieces[0];
+
+		for ( unsigned n = 0; n < countParams; ++n )
+		{
+			sprintf( name, ":P%u_%u", r, n + 1 );
+			blockSql += name;
+			blockSql += pieces[n + 1];
+		}
+
+		sprintf( name, ";\nR%u = ROW_COUNT;\n", r );
+		blockSql += name;
+	}
+
+	blockSql += "SUSPEND;\nEND";
+}
+
+//
+// Returns the block taking the given number of sets, preparing it the
+// first time. A block the server refuses is not tried again: the sets
+// are executed one at a time from then on.
+//
+IscExecuteBlock::Block* IscExecuteBlock::getBlock( unsigned rows )
+{
+	auto it = blocks.find( rows );
+
+	if ( it != blocks.end() )
+		return &it->second;
+
+	IscConnection *connection = statement->connection;
+	ITransaction *transHandle = statement->startTransaction();
+	IMetadataBuilder *builder = NULL;
+	std::string blockSql;
+	Block block = {};
+
+	buildSql( rows, blockSql );
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		block.statement = connection->databaseHandle->prepare( &status, transHandle, 0, blockSql.c_str(),
+		                                                       connection->getDatabaseDialect(), IStatement::PREPARE_PREFETCH_METADATA );
+
+		// the block gets its parameters in the layout of the sets
+		if ( countParams )
+		{
+			builder = connection->GDS->_master->getMetadataBuilder( &status, rows * countParams );
+
+			for ( unsigned index = 0; index < rows * countParams; ++index )
+			{
+				unsigned n = index % countParams;
+				unsigned type = rowMeta->getType( &status, n ) & ~1;
+
+				builder->setType( &status, index, type | 1 );
+				builder->setSubType( &status, index, type == SQL_TEXT || type == SQL_VARYING ? 0 : rowMeta->getSubType( &status, n ) );
+				builder->setCharSet( &status, index, rowMeta->getCharSet( &status, n ) );
+				builder->setScale( &status, index, rowMeta->getScale( &status, n ) );
+				builder->setLength( &status, index, rowMeta->getLength( &status, n ) );
+			}
+
+			block.input = builder->getMetadata( &status );
+			builder->release();
+			builder = NULL;
+
+			for ( unsigned index = 0; index < rows * countParams; ++index )
+			{
+				block.offsetData.push_back( block.input->getOffset( &status, index ) );
+				block.offsetNull.push_back( block.input->getNullOffset( &status, index ) );
+			}
+
+			block.inputBuffer.resize( block.input->getMessageLength( &status ) );
+		}
+
+		block.output = block.statement->getOutputMetadata( &status );
+
+		for ( unsigned r = 0; r < rows; ++r )
+			block.offsetCounts.push_back( block.output->getOffset( &status, r ) );
+
+		block.outputBuffer.resize( block.output->getMessageLength( &status ) );
+	}
+	catch( const FbException& )
+	{
+		status.clearException();
+		if ( builder )
+			builder->release();
+		releaseBlock( block );
+		rowsPerBlock = 1;
+		return NULL;
+	}
+
+	return &( blocks[rows] = std::move( block ) );
+}
+
+//
+// Prepares for a new array of parameter sets. Returns false when the
+// statement is better executed set by set.
+//
+bool IscExecuteBlock::open()
+{
+	countRows = 0;
+
+	if ( !rowMeta )
+	{
+		if ( !split() )
+			return false;
+
+		design( statement->inputSqlda.meta );
+	}
+
+	return rowsPerBlock > 1;
+}
+
+void IscExecuteBlock::add( IMessageMetadata *meta, const char *message )
+{
+	// bindings changed the message layout, the sets added so far go first
+	if ( meta != rowMeta )
+	{
+		send();
+		design( meta );
+	}
+
+	messages.resize( MAX( messages.size(), ( countRows + 1 ) * lengthRow ) );
+	memcpy( messages.data() + countRows * lengthRow, message, lengthRow );
+
+	if ( ++countRows >= rowsPerBlock )
+		send();
+}
+
+//
+// Executes the sets added since the last call, a block at a time. The
+// last few sets go in a smaller block, a single one on its own.
+//
+void IscExecuteBlock::send()
+{
+	unsigned first = 0;
+
+	while ( countRows - first > 1 && rowsPerBlock > 1 )
+	{
+		Block *block = getBlock( MIN( rowsPerBlock, countRows - first ) );
+
+		if ( !block )
+			break;
+
+		executeBlock( block, first );
+		first += (unsigned)block->offsetCounts.size();
+	}
+
+	if ( first < countRows )
+		executeRows( first, countRows - first );
+
+	countRows = 0;
+}
+
+void IscExecuteBlock::executeBlock( Block *block, unsigned first )
+{
+	IscConnection *connection = statement->connection;
+	ITransaction *transHandle = statement->startTransaction();
+	unsigned count = (unsigned)block->offsetCounts.size();
+	char *input = block->inputBuffer.data();
+	char *output = block->outputBuffer.data();
+
+	for ( unsigned r = 0; r < count; ++r )
+	{
+		const char *message = messages.data() + ( first + r ) * lengthRow;
+
+		for ( unsigned n = 0; n < countParams; ++n )
+		{
+			unsigned index = r * countParams + n;
+			memcpy( input + block->offsetNull[index], message + offsetNull[n], sizeof( short ) );
+			memcpy( input + block->offsetData[index], message + offsetData[n], lengthData[n] );
+		}
+	}
+
+	IResultSet *cursor = NULL;
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		cursor = block->statement->openCursor( &status, transHandle, block->input, input, block->output, 0 );
+		cursor->fetchNext( &status, output );
+		cursor->close( &status );
+	}
+	catch( const FbException& error )
+	{
+		if ( cursor )
+			cursor->release();
+
+		// a cancelled block is not run again row by row
+		if ( error.getStatus()->getErrors()[1] == isc_cancelled || statement->timedOut )
+		{
+			countRows = 0;
+			statement->throwExecuteError( error.getStatus() );
+		}
+
+		// the block is undone as a whole; its sets run one at a time
+		// find the one that fails and apply the ones before it
+		status.clearException();
+		executeRows( first, count );
+		return;
+	}
+
+	for ( unsigned r = 0; r < count; ++r )
+	{
+		int updateCount;
+		memcpy( &updateCount, output + block->offsetCounts[r], sizeof( updateCount ) );
+		statement->batchCounts.push_back( updateCount );
+		statement->summaryUpdateCount += updateCount;
+	}
+}
+
+void IscExecuteBlock::executeRows( unsigned first, unsigned count )
+{
+	IscConnection *connection = statement->connection;
+	ITransaction *transHandle = statement->startTransaction();
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+
+	for ( unsigned r = first; r < first + count; ++r )
+	{
+		try
+		{
+			statement->statementHandle->execute( &status, transHandle, rowMeta, messages.data() + r * lengthRow, NULL, NULL );
+
+			int updateCount = (int)statement->statementHandle->getAffectedRecords( &status );
+			statement->batchCounts.push_back( updateCount );
+			statement->summaryUpdateCount += updateCount;
+		}
+		catch( const FbException& error )
+		{
+			statement->batchCounts.push_back( -1 );
+			countRows = 0;
+			statement->throwExecuteError( error.getStatus() );
+		}
+	}
+}
+
+}; // end namespace IscDbcLibrary
@@ -0,0 +1,76 @@
+// IscExecuteBlock.h: interface for the IscExecuteBlock class.
+//
+//	Executes the parameter sets of an INSERT, UPDATE or DELETE several at
+//	a time where IBatch is not available, rewriting the statement into an
+//	EXECUTE BLOCK that takes the parameters of a number of sets and runs
+//	the statement once for each of them. The prepared blocks are kept for
+//	every number of sets they were built for.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCEXECUTEBLOCK_H_)
+#define _ISCEXECUTEBLOCK_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace IscDbcLibrary {
+
+class IscStatement;
+
+#define EXECUTE_BLOCK_MAX_PARAMS		255		// input parameters and update counts of one block
+#define EXECUTE_BLOCK_MESSAGE_BYTES		65535
+#define EXECUTE_BLOCK_TEXT_BYTES		65535
+
+class IscExecuteBlock
+{
+public:
+	IscExecuteBlock( IscStatement *stmt );
+	~IscExecuteBlock();
+
+	bool	open();
+	void	add( Firebird::IMessageMetadata *meta, const char *message );
+	void	send();
+	void	cancel() { countRows = 0; }
+
+private:
+	struct Block
+	{
+		Firebird::IStatement		*statement;
+		Firebird::IMessageMetadata	*input;
+		Firebird::IMessageMetadata	*output;
+		std::vector<unsigned>		offsetData;		// of every parameter in the block message
+		std::vector<unsigned>		offsetNull;
+		std::vector<unsigned>		offsetCounts;	// of the update count of every set
+		std::vector<char>			inputBuffer;
+		std::vector<char>			outputBuffer;
+	};
+
+	bool	split();
+	void	design( Firebird::IMessageMetadata *meta );
+	void	buildSql( unsigned rows, std::string &blockSql );
+	Block*	getBlock( unsigned rows );
+	void	executeBlock( Block *block, unsigned first );
+	void	executeRows( unsigned first, unsigned count );
+	void	clearBlocks();
+	void	releaseBlock( Block &block );
+
+	IscStatement				*statement;
+	std::vector<std::string>	pieces;				// statement text around its parameter markers
+	Firebird::IMessageMetadata	*rowMeta;			// message layout of one parameter set
+	unsigned					countParams;
+	unsigned					lengthRow;
+	std::vector<unsigned>		offsetData;			// in the message of one set
+	std::vector<unsigned>		offsetNull;
+	std::vector<unsigned>		lengthData;
+	std::vector<std::string>	types;				// declaration of every parameter
+	unsigned					rowsPerBlock;		// 1 - the sets are executed one at a time
+	std::map<unsigned, Block>	blocks;				// prepared for rowsPerBlock sets and the remainders
+	std::vector<char>			messages;			// sets added and not yet executed, lengthRow bytes each
+	unsigned					countRows;
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCEXECUTEBLOCK_H_)
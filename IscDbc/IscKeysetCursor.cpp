@@ -0,0 +1,518 @@
+// IscKeysetCursor.cpp: implementation of the IscKeysetCursor class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "IscDbc.h"
+#include "IscKeysetCursor.h"
+#include "IscSqlLexer.h"
+#include "IscStatement.h"
+#include "IscConnection.h"
+#include "IscBlob.h"
+#include "SQLError.h"
+
+using namespace Firebird;
+
+namespace IscDbcLibrary {
+
+namespace {
+
+bool isWordOf( const char *sql, const SqlToken &token, const char * const *words )
+{
+	for ( ; *words; ++words )
+		if ( IscSqlLexer::isWord( sql, token, *words ) )
+			return true;
+	return false;
+}
+
+const char * const endTableReference[] = { "WHERE", "ORDER", "PLAN", "ROWS", "FOR", "WITH", "OFFSET", "FETCH", NULL };
+const char * const rejectedClauses[] = { "GROUP", "HAVING", "UNION", "WINDOW", NULL };
+const char * const aggregates[] = { "COUNT", "SUM", "AVG", "MIN", "MAX", "LIST", NULL };
+
+}; // end namespace
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscKeysetCursor::IscKeysetCursor( IscStatement *stmt )
+{
+	statement = stmt;
+	keysetStatement = NULL;
+	rowsetStatement = NULL;
+	keysetOutput = NULL;
+	rowsetInput = NULL;
+	rowsetOutput = NULL;
+	recordVersion = false;
+	lengthKey = 0;
+	offsetKey = offsetVersion = 0;
+	countRows = 0;
+	curRow = -1;
+	batchFirst = 0;
+	batchCount = 0;
+	lengthRow = 0;
+}
+
+IscKeysetCursor::~IscKeysetCursor()
+{
+	try
+	{
+		clearBlobs();
+	}
+	catch ( ... )
+	{
+	}
+
+	releaseStatements();
+}
+
+void IscKeysetCursor::releaseStatements()
+{
+	if ( rowsetOutput )
+		rowsetOutput->release();
+	if ( rowsetInput )
+		rowsetInput->release();
+	if ( keysetOutput )
+		keysetOutput->release();
+	rowsetOutput = rowsetInput = keysetOutput = NULL;
+
+	IStatement *handles[] = { rowsetStatement, keysetStatement };
+	rowsetStatement = keysetStatement = NULL;
+
+	for ( IStatement *handle : handles )
+	{
+		if ( !handle )
+			continue;
+
+		// once the connection is gone only the interface is left to release
+		if ( statement->connection )
+		{
+			ThrowStatusWrapper status( statement->connection->GDS->_status );
+			try
+			{
+				handle->free( &status );
+				continue;
+			}
+			catch( const FbException& )
+			{
+				status.clearException();
+			}
+		}
+
+		handle->release();
+	}
+}
+
+//
+// Builds the statement reading the keys and the one reading rows by key
+// from the query of the statement. Only a SELECT from a single table
+// qualifies, without DISTINCT, aggregates, GROUP BY or UNION, since its
+// rows must map one to one onto the rows of the table.
+//
+bool IscKeysetCursor::buildQueries( std::string &keysetSql, std::string &rowsetSql )
+{
+	const char *sql = statement->sql;
+	std::vector<SqlToken> tokens;
+	IscSqlLexer::tokenize( sql, tokens );
+
+	size_t count = tokens.size();
+
+	if ( count < 4 || !IscSqlLexer::isWord( sql, tokens[0], "SELECT" )
+		|| IscSqlLexer::isWord( sql, tokens[1], "DISTINCT" ) || IscSqlLexer::isWord( sql, tokens[1], "FIRST" ) || IscSqlLexer::isWord( sql, tokens[1], "SKIP" ) )
+		return false;
+
+	size_t n = 1;
+
+	for ( ; n < count && !( tokens[n].depth == 0 && IscSqlLexer::isWord( sql, tokens[n], "FROM" ) ); ++n )
+	{
+		const SqlToken &token = tokens[n];
+
+		if ( token.kind == '?' )
+			return false;
+
+		if ( token.depth == 0 && ( IscSqlLexer::isWord( sql, token, "OVER" )
+				|| ( isWordOf( sql, token, aggregates ) && n + 1 < count && tokens[n + 1].kind == '(' ) ) )
+			return false;
+	}
+
+	if ( n == 1 || n + 1 >= count )
+		return false;
+
+	std::string selectList( sql + tokens[1].begin, tokens[n - 1].end - tokens[1].begin );
+
+	// table reference: name[.name] [[AS] alias]
+	size_t table = ++n;
+
+	if ( tokens[n].kind != 'w' && tokens[n].kind != '"' )
+		return false;
+
+	if ( ++n + 1 < count && tokens[n].kind == '.' && ( tokens[n + 1].kind == 'w' || tokens[n + 1].kind == '"' ) )
+		n += 2;
+
+	std::string qualifier( sql + tokens[table].begin, tokens[n - 1].end - tokens[table].begin );
+
+	if ( n < count && IscSqlLexer::isWord( sql, tokens[n], "AS" ) )
+		++n;
+
+	if ( n < count && ( tokens[n].kind == '"' || ( tokens[n].kind == 'w' && !isWordOf( sql, tokens[n], endTableReference ) ) ) )
+	{
+		qualifier.assign( sql + tokens[n].begin, tokens[n].end - tokens[n].begin );
+		++n;
+	}
+
+	if ( n < count && tokens[n].kind != ';' && !isWordOf( sql, tokens[n], endTableReference ) )
+		return false;
+
+	std::string tableReference( sql + tokens[table].begin, tokens[n - 1].end - tokens[table].begin );
+
+	for ( size_t tail = n; tail < count; ++tail )
+	{
+		const SqlToken &token = tokens[tail];
+
+		if ( token.depth )
+			continue;
+
+		if ( isWordOf( sql, token, rejectedClauses ) )
+			return false;
+
+		// ORDER BY 2 refers to the select list the keyset query does not have
+		if ( token.kind == 'n' && tail > 1 && ( tokens[tail - 1].kind == ',' || IscSqlLexer::isWord( sql, tokens[tail - 1], "BY" ) ) )
+			return false;
+	}
+
+	if ( selectList == "*" )
+		selectList = qualifier + ".*";
+
+	std::string keys = qualifier + ".RDB$DB_KEY";
+	if ( recordVersion )
+		keys += ", " + qualifier + ".RDB$RECORD_VERSION";
+
+	keysetSql = "SELECT " + keys + " FROM " + std::string( sql + tokens[table].begin );
+
+	rowsetSql = "SELECT " + selectList + ", " + keys + " FROM " + tableReference
+				+ " WHERE " + qualifier + ".RDB$DB_KEY IN (?";
+	for ( int k = 1; k < KEYSET_BATCH_ROWS; ++k )
+		rowsetSql += ", ?";
+	rowsetSql += ")";
+
+	return true;
+}
+
+bool IscKeysetCursor::prepare( const char *keysetSql, const char *rowsetSql )
+{
+	IscConnection *connection = statement->connection;
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		ITransaction *transHandle = statement->startTransaction();
+		int dialect = connection->getDatabaseDialect();
+
+		keysetStatement =
+			connection->databaseHandle->prepare( &status, transHandle, 0, keysetSql, dialect, IStatement::PREPARE_PREFETCH_METADATA );
+		rowsetStatement =
+			connection->databaseHandle->prepare( &status, transHandle, 0, rowsetSql, dialect, IStatement::PREPARE_PREFETCH_METADATA );
+
+		keysetOutput = keysetStatement->getOutputMetadata( &status );
+		rowsetInput = rowsetStatement->getInputMetadata( &status );
+		rowsetOutput = rowsetStatement->getOutputMetadata( &status );
+	}
+	catch( const FbException& )
+	{
+		// the query is not one the keyset can be built for
+		status.clearException();
+		releaseStatements();
+		return false;
+	}
+
+	return true;
+}
+
+//
+// Prepares the keyset and reads it. Returns false when the query does
+// not qualify, the caller reads a static cursor instead.
+//
+bool IscKeysetCursor::open()
+{
+	std::string keysetSql, rowsetSql;
+	Sqlda &outputSqlda = statement->outputSqlda;
+	Sqlda &inputSqlda = statement->inputSqlda;
+
+	recordVersion = statement->connection->attachment->majorFb >= 3;
+
+	if ( !buildQueries( keysetSql, rowsetSql ) || !prepare( keysetSql.c_str(), rowsetSql.c_str() ) )
+		return false;
+
+	ThrowStatusWrapper status( statement->connection->GDS->_status );
+	try
+	{
+		unsigned countKeys = recordVersion ? 2 : 1;
+		unsigned countColumns = outputSqlda.columnsCount;
+		IMessageMetadata *keysetInput = keysetStatement->getInputMetadata( &status );
+		unsigned countParams = keysetInput->getCount( &status );
+		keysetInput->release();
+
+		if ( keysetOutput->getCount( &status ) != countKeys
+			|| rowsetOutput->getCount( &status ) != countColumns + countKeys
+			|| rowsetInput->getCount( &status ) != KEYSET_BATCH_ROWS
+			|| countParams != ( inputSqlda.meta ? inputSqlda.meta->getCount( &status ) : 0 ) )
+		{
+			releaseStatements();
+			return false;
+		}
+
+		lengthKey = keysetOutput->getLength( &status, 0 );
+
+		// the rows read by key must fit the message of the statement as is
+		for ( unsigned n = 0; n < countColumns; ++n )
+		{
+			auto &var = outputSqlda.sqlvar.at( n );
+			unsigned type = outputSqlda.meta->getType( &status, n ) & ~1;
+			unsigned length = outputSqlda.meta->getLength( &status, n );
+
+			if ( type == SQL_ARRAY
+				|| ( rowsetOutput->getType( &status, n ) & ~1 ) != type
+				|| rowsetOutput->getLength( &status, n ) != length )
+			{
+				releaseStatements();
+				return false;
+			}
+
+			columns.push_back( { var.offsetData, var.offsetNull,
+								 rowsetOutput->getOffset( &status, n ), rowsetOutput->getNullOffset( &status, n ),
+								 type == SQL_VARYING ? length + (unsigned)sizeof(short) : length } );
+		}
+
+		offsetKey = rowsetOutput->getOffset( &status, countColumns );
+		if ( recordVersion )
+			offsetVersion = rowsetOutput->getOffset( &status, countColumns + 1 );
+
+		for ( unsigned n = 0; n < KEYSET_BATCH_ROWS; ++n )
+		{
+			if ( rowsetInput->getLength( &status, n ) != lengthKey )
+			{
+				releaseStatements();
+				return false;
+			}
+
+			offsetParams.push_back( rowsetInput->getOffset( &status, n ) );
+			offsetParamsNull.push_back( rowsetInput->getNullOffset( &status, n ) );
+		}
+
+		inputBuffer.resize( rowsetInput->getMessageLength( &status ) );
+		outputBuffer.resize( rowsetOutput->getMessageLength( &status ) );
+	}
+	catch( const FbException& error )
+	{
+		THROW_ISC_EXCEPTION( statement->connection, error.getStatus() );
+	}
+
+	lengthRow = outputSqlda.buffer.size();
+	batchRows.resize( lengthRow * KEYSET_BATCH_ROWS );
+	batchStates.resize( KEYSET_BATCH_ROWS );
+
+	readKeys();
+
+	return true;
+}
+
+void IscKeysetCursor::readKeys()
+{
+	IscConnection *connection = statement->connection;
+	Sqlda &inputSqlda = statement->inputSqlda;
+	IResultSet *cursor = NULL;
+	std::vector<char> message;
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		auto *_imeta = inputSqlda.useExecBufferMeta ? inputSqlda.execMeta   : inputSqlda.meta;
+		auto &_ibuf  = inputSqlda.useExecBufferMeta ? inputSqlda.execBuffer : inputSqlda.buffer;
+
+		unsigned offsetKeyset = keysetOutput->getOffset( &status, 0 );
+		unsigned offsetVersionKeyset = recordVersion ? keysetOutput->getOffset( &status, 1 ) : 0;
+		message.resize( keysetOutput->getMessageLength( &status ) );
+
+		cursor = keysetStatement->openCursor( &status, statement->startTransaction(),
+											  _imeta, _ibuf.data(), keysetOutput, 0 );
+
+		while ( cursor->fetchNext( &status, message.data() ) != IStatus::RESULT_NO_DATA )
+		{
+			keys.insert( keys.end(), message.data() + offsetKeyset, message.data() + offsetKeyset + lengthKey );
+
+			int64_t version = 0;
+			if ( recordVersion )
+				memcpy( &version, message.data() + offsetVersionKeyset, sizeof(version) );
+			versions.push_back( version );
+
+			++countRows;
+		}
+
+		cursor->close( &status );
+		cursor = NULL;
+	}
+	catch( const FbException& error )
+	{
+		if ( cursor )
+			cursor->release();
+		THROW_ISC_EXCEPTION( connection, error.getStatus() );
+	}
+}
+
+//
+// Reads the rows of the batch starting at the row first. A key the
+// statement does not return any more belongs to a deleted row, which
+// is left with every column NULL.
+//
+void IscKeysetCursor::fetchBatch( int first )
+{
+	IscConnection *connection = statement->connection;
+	IResultSet *cursor = NULL;
+
+	clearBlobs();
+
+	batchFirst = first;
+	batchCount = MIN( KEYSET_BATCH_ROWS, countRows - first );
+
+	for ( int n = 0; n < KEYSET_BATCH_ROWS; ++n )
+	{
+		char *param = inputBuffer.data();
+
+		if ( n < batchCount )
+		{
+			memcpy( param + offsetParams[n], keys.data() + (size_t)( first + n ) * lengthKey, lengthKey );
+			*(short*)( param + offsetParamsNull[n] ) = 0;
+		}
+		else
+			*(short*)( param + offsetParamsNull[n] ) = -1;
+	}
+
+	memset( batchRows.data(), 0, batchRows.size() );
+
+	for ( int n = 0; n < batchCount; ++n )
+	{
+		char *row = batchRows.data() + (size_t)n * lengthRow;
+		for ( auto &column : columns )
+			*(short*)( row + column.offsetNull ) = -1;
+		batchStates[n] = enRowDeleted;
+	}
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		char *message = outputBuffer.data();
+
+		cursor = rowsetStatement->openCursor( &status, statement->startTransaction(),
+											  rowsetInput, inputBuffer.data(), rowsetOutput, 0 );
+
+		while ( cursor->fetchNext( &status, message ) != IStatus::RESULT_NO_DATA )
+		{
+			const char *key = keys.data() + (size_t)first * lengthKey;
+			int n = 0;
+
+			while ( n < batchCount && memcmp( key, message + offsetKey, lengthKey ) )
+			{
+				key += lengthKey;
+				++n;
+			}
+
+			if ( n == batchCount )
+				continue;
+
+			char *row = batchRows.data() + (size_t)n * lengthRow;
+
+			for ( auto &column : columns )
+			{
+				memcpy( row + column.offsetData, message + column.offsetDataFrom, column.length );
+				*(short*)( row + column.offsetNull ) = *(short*)( message + column.offsetNullFrom );
+			}
+
+			int64_t version = 0;
+			if ( recordVersion )
+				memcpy( &version, message + offsetVersion, sizeof(version) );
+
+			batchStates[n] = version != versions[first + n] ? enRowUpdated : enRowSuccess;
+		}
+
+		cursor->close( &status );
+		cursor = NULL;
+	}
+	catch( const FbException& error )
+	{
+		if ( cursor )
+			cursor->release();
+		batchCount = 0;
+		THROW_ISC_EXCEPTION( connection, error.getStatus() );
+	}
+}
+
+void IscKeysetCursor::nextRow( char *buffer )
+{
+	int nRow = ++curRow;
+
+	if ( nRow < 0 || nRow >= countRows )
+		return;
+
+	if ( nRow < batchFirst || nRow >= batchFirst + batchCount )
+		fetchBatch( nRow );
+
+	memcpy( buffer, batchRows.data() + (size_t)( nRow - batchFirst ) * lengthRow, lengthRow );
+}
+
+IscKeysetCursor::RowState IscKeysetCursor::getRowState()
+{
+	if ( curRow < batchFirst || curRow >= batchFirst + batchCount )
+		return enRowSuccess;
+
+	return batchStates[curRow - batchFirst];
+}
+
+//
+// Blob contents are read on demand and kept until the next batch is read.
+//
+IscBlob* IscKeysetCursor::getBlob( const char *sqldata )
+{
+	uint64_t key;
+	memcpy( &key, sqldata, sizeof(key) );
+
+	auto it = blobs.find( key );
+
+	if ( it != blobs.end() )
+		return it->second;
+
+	IscBlob *blob = new IscBlob( statement, (char*)sqldata, 0 );
+
+	try
+	{
+		blob->fetchBlob();
+	}
+	catch ( ... )
+	{
+		delete blob;
+		throw;
+	}
+
+	blobs[key] = blob;
+
+	return blob;
+}
+
+void IscKeysetCursor::clearBlobs()
+{
+	for ( auto &entry : blobs )
+		delete entry.second;
+
+	blobs.clear();
+}
+
+size_t IscKeysetCursor::getMemory()
+{
+	size_t memory = keys.capacity() + versions.capacity() * sizeof(int64_t)
+					+ batchRows.capacity() + inputBuffer.capacity() + outputBuffer.capacity();
+
+	for ( auto &entry : blobs )
+		memory += sizeof(IscBlob) + entry.second->length();
+
+	return memory;
+}
+
+}; // end namespace IscDbcLibrary
@@ -0,0 +1,90 @@
+// IscKeysetCursor.h: interface for the IscKeysetCursor class.
+//
+//	Keyset-driven cursor for single-table SELECTs. Only the RDB$DB_KEY
+//	of every row (and its RDB$RECORD_VERSION on Firebird 3 and later)
+//	is read when the cursor is opened; the rows themselves are read a
+//	batch at a time with a prepared WHERE RDB$DB_KEY IN (...) statement,
+//	so rows changed or deleted since the cursor was opened are seen.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCKEYSETCURSOR_H_)
+#define _ISCKEYSETCURSOR_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace IscDbcLibrary {
+
+class IscStatement;
+class IscBlob;
+
+#define KEYSET_BATCH_ROWS		32
+
+class IscKeysetCursor
+{
+public:
+	enum RowState { enRowSuccess, enRowUpdated, enRowDeleted };
+
+	IscKeysetCursor( IscStatement *stmt );
+	~IscKeysetCursor();
+
+	bool	open();
+	void	current( int nRow ) { curRow = nRow - 1; }
+	void	refresh() { batchCount = 0; }
+	void	nextRow( char *buffer );
+	IscBlob* getBlob( const char *sqldata );
+	int		getCountRows() { return countRows; }
+	size_t	getMemory();
+	RowState getRowState();
+
+private:
+	bool	buildQueries( std::string &keysetSql, std::string &rowsetSql );
+	bool	prepare( const char *keysetSql, const char *rowsetSql );
+	void	readKeys();
+	void	fetchBatch( int first );
+	void	clearBlobs();
+	void	releaseStatements();
+
+	struct Column {
+		unsigned	offsetData;			// in Sqlda::buffer
+		unsigned	offsetNull;
+		unsigned	offsetDataFrom;		// in the rowset message
+		unsigned	offsetNullFrom;
+		unsigned	length;
+	};
+
+	IscStatement				*statement;
+	Firebird::IStatement		*keysetStatement;
+	Firebird::IStatement		*rowsetStatement;
+	Firebird::IMessageMetadata	*keysetOutput;
+	Firebird::IMessageMetadata	*rowsetInput;
+	Firebird::IMessageMetadata	*rowsetOutput;
+	bool						recordVersion;		// RDB$RECORD_VERSION is read, Firebird 3 and later
+	unsigned					lengthKey;
+	std::vector<Column>			columns;
+	unsigned					offsetKey;			// RDB$DB_KEY in the rowset message
+	unsigned					offsetVersion;
+	std::vector<unsigned>		offsetParams;		// RDB$DB_KEY parameters of the rowset statement
+	std::vector<unsigned>		offsetParamsNull;
+	std::vector<char>			inputBuffer;
+	std::vector<char>			outputBuffer;
+
+	std::vector<char>			keys;				// lengthKey bytes per row
+	std::vector<int64_t>		versions;
+	int							countRows;
+	int							curRow;
+
+	int							batchFirst;
+	int							batchCount;
+	std::vector<char>			batchRows;			// lengthRow bytes per row, laid out like Sqlda::buffer
+	std::vector<RowState>		batchStates;
+	size_t						lengthRow;
+	std::unordered_map<uint64_t, IscBlob*> blobs;	// contents read for the batch, by blob id
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCKEYSETCURSOR_H_)
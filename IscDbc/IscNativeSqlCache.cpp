@@ -0,0 +1,120 @@
+// IscNativeSqlCache.cpp: implementation of the IscNativeSqlCache class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "IscDbc.h"
+#include "IscNativeSqlCache.h"
+
+namespace IscDbcLibrary {
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscNativeSqlCache::IscNativeSqlCache()
+{
+	hits = 0;
+	misses = 0;
+}
+
+void IscNativeSqlCache::makeKey( const char *sql, int length, const char *options, std::string &key )
+{
+	key.assign( options );
+	key += '\0';
+	key.append( sql, length );
+}
+
+//
+// Copies the translation of the text, if there is one, the way
+// IscConnection::getNativeSql returns it.
+//
+bool IscNativeSqlCache::find( const char *sql, int length, const char *options,
+							  char *nativeSql, int bufferLength, int *nativeLength, int &result )
+{
+	if ( length > NATIVE_SQL_CACHE_MAX_TEXT )
+		return false;
+
+	std::string key;
+	makeKey( sql, length, options, key );
+
+	std::lock_guard<std::mutex> guard( mutex );
+	auto it = index.find( key );
+
+	if ( it == index.end() || (int)it->second->nativeSql.size() >= bufferLength )
+	{
+		++misses;
+		return false;
+	}
+
+	++hits;
+	items.splice( items.begin(), items, it->second );
+
+	const Item &item = items.front();
+	result = item.result;
+
+	if ( !result )
+	{
+		if ( nativeLength )
+			*nativeLength = length;
+		return true;
+	}
+
+	memcpy( nativeSql, item.nativeSql.c_str(), item.nativeSql.size() + 1 );
+
+	if ( nativeLength )
+		*nativeLength = (int)item.nativeSql.size();
+
+	return true;
+}
+
+void IscNativeSqlCache::add( const char *sql, int length, const char *options,
+							 const char *nativeSql, int nativeLength, int result )
+{
+	if ( length > NATIVE_SQL_CACHE_MAX_TEXT )
+		return;
+
+	Item item;
+	makeKey( sql, length, options, item.key );
+	item.result = result;
+
+	if ( result )
+		item.nativeSql.assign( nativeSql, nativeLength );
+
+	std::lock_guard<std::mutex> guard( mutex );
+
+	if ( index.find( item.key ) != index.end() )
+		return;
+
+	items.push_front( item );
+	index[items.front().key] = items.begin();
+
+	if ( items.size() > NATIVE_SQL_CACHE_ENTRIES )
+	{
+		index.erase( items.back().key );
+		items.pop_back();
+	}
+}
+
+//
+// Translations of {call} depend on the procedures in the database, so
+// they go when the metadata changes.
+//
+void IscNativeSqlCache::clear()
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	items.clear();
+	index.clear();
+}
+
+void IscNativeSqlCache::getStatistics( int &hitCount, int &missCount, int &entries )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	hitCount = hits;
+	missCount = misses;
+	entries = (int)items.size();
+}
+
+}; // end namespace IscDbcLibrary
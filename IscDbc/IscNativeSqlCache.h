@@ -0,0 +1,56 @@
+// IscNativeSqlCache.h: interface for the IscNativeSqlCache class.
+//
+//	Native SQL translations of a connection, kept by the statement text
+//	and the connection options the translation depends on, so that text
+//	prepared over and over is translated once. The least recently used
+//	are dropped first.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCNATIVESQLCACHE_H_)
+#define _ISCNATIVESQLCACHE_H_
+
+#include <string>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace IscDbcLibrary {
+
+#define NATIVE_SQL_CACHE_ENTRIES	256
+#define NATIVE_SQL_CACHE_MAX_TEXT	16384	// longer texts are translated every time
+
+class IscNativeSqlCache
+{
+public:
+	IscNativeSqlCache();
+
+	bool	find( const char *sql, int length, const char *options,
+				  char *nativeSql, int bufferLength, int *nativeLength, int &result );
+	void	add( const char *sql, int length, const char *options,
+				 const char *nativeSql, int nativeLength, int result );
+	void	clear();
+	void	getStatistics( int &hitCount, int &missCount, int &entries );
+
+private:
+	struct Item
+	{
+		std::string	key;
+		std::string	nativeSql;	// empty when the text is used as it is
+		int			result;		// of IscConnection::getNativeSql
+	};
+
+	typedef std::list<Item> ListItems;
+
+	void	makeKey( const char *sql, int length, const char *options, std::string &key );
+
+	std::mutex			mutex;
+	ListItems			items;				// most recently used first
+	std::unordered_map<std::string, ListItems::iterator> index;
+	int					hits;
+	int					misses;
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCNATIVESQLCACHE_H_)
@@ -32,6 +32,7 @@
 #include "BinaryBlob.h"
 #include "Value.h"
 #include "IscStatementMetaData.h"
+#include "IscSqlLexer.h"
 
 using namespace Firebird;
 
@@ -192,15 +193,14 @@ int IscOdbcStatement::replacementArrayParamForStmtUpdate( char *& tempSql, int *
 			        memset ( offsetNameParam, 0, sizeof(int) * numberColumns );
 
 					int *param = offsetParam;
-
-					ch = strSql;
-
-					while ( *ch )
-					{
-						if ( *ch == '?' )
-							*param++ = ch - strSql;
-						ch++;
-					}
+					int *paramEnd = offsetParam + numberColumns;
+					IscSqlLexer lexer( strSql );
+					SqlToken token;
+
+					// markers in literals and comments are not parameters
+					while ( param < paramEnd && lexer.next( token ) )
+						if ( token.kind == '?' )
+							*param++ = (int)token.begin;
 				}
 
 				const char *end = strSql + offsetParam[n];
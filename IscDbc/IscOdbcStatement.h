@@ -39,10 +39,12 @@ class IscOdbcStatement : public IscStatement, public InternalStatement
 {
 public:
 //{{{ class InternalStatement specification jdbc
-	virtual bool		isActive() { return !!statementHandle; }
+	virtual bool		isActive() { return statementHandle || direct; }
 	virtual void		prepareStatement(const char * sqlString);
 	virtual bool		executeStatement() { return IscStatement::execute(); }
 	virtual bool		executeProcedure(){ return IscStatement::executeProcedure(); }
+	virtual bool		prepareDirect(const char * sqlString, bool selectCursor) { return IscStatement::prepareDirect( sqlString, selectCursor ); }
+	virtual bool		executeDirect() { return IscStatement::executeDirect(); }
 	virtual StatementMetaData*	
 						getStatementMetaDataIPD();
 	virtual StatementMetaData*	
@@ -64,7 +66,7 @@ public:
 	virtual int			getMaxFieldSize(){ return IscStatement::getMaxFieldSize(); }
 	virtual int			getMaxRows(){ return IscStatement::getMaxRows(); }
 	virtual int			getQueryTimeout(){ return IscStatement::getQueryTimeout(); }
-	virtual void		cancel(){ IscStatement::cancel(); }
+	virtual bool		cancel(){ return IscStatement::cancel(); }
 //	virtual void		clearWarnings(){ IscStatement::clearWarnings(); }
 //	virtual void		getWarnings(){ IscStatement::getWarnings(); }
 	virtual void		close(){ IscStatement::close(); }
@@ -93,6 +95,19 @@ public:
 	virtual void		delActiveLocalParamTransaction(){ IscStatement::delActiveLocalParamTransaction(); }
 	virtual void		declareLocalParamTransaction(){ IscStatement::declareLocalParamTransaction(); }
 	virtual void		switchTransaction(bool local){ IscStatement::switchTransaction( local ); }
+	virtual void		setReadAheadRows(int rows){ IscStatement::setReadAheadRows( rows ); }
+	virtual void		setScrollableCursor(bool scrollable){ IscStatement::setScrollableCursor( scrollable ); }
+	virtual bool		isScrollableCursor(){ return IscStatement::isScrollableCursor(); }
+	virtual void		setStaticCursorMemory(int megabytes){ IscStatement::setStaticCursorMemory( megabytes ); }
+	virtual void		setBlobCacheMemory(int megabytes){ IscStatement::setBlobCacheMemory( megabytes ); }
+	virtual void		setKeysetCursor(bool keyset){ IscStatement::setKeysetCursor( keyset ); }
+	virtual bool		isKeysetCursor(){ return IscStatement::isKeysetCursor(); }
+	virtual bool		beginBatch(){ return IscStatement::beginBatch(); }
+	virtual void		addBatch(){ IscStatement::addBatch(); }
+	virtual void		executeBatch(){ IscStatement::executeBatch(); }
+	virtual void		cancelBatch(){ IscStatement::cancelBatch(); }
+	virtual int			getBatchRows(){ return IscStatement::getBatchRows(); }
+	virtual int			getBatchUpdateCount(int row){ return IscStatement::getBatchUpdateCount( row ); }
 
 //}}} end class Statement without specification jdbc
 
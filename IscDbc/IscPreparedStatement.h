@@ -82,7 +82,7 @@ public:
 	virtual int			getMaxFieldSize(){ return IscStatement::getMaxFieldSize(); }
 	virtual int			getMaxRows(){ return IscStatement::getMaxRows(); }
 	virtual int			getQueryTimeout(){ return IscStatement::getQueryTimeout(); }
-	virtual void		cancel(){ IscStatement::cancel(); }
+	virtual bool		cancel(){ return IscStatement::cancel(); }
 //	virtual void		clearWarnings(){ IscStatement::clearWarnings(); }
 //	virtual void		getWarnings(){ IscStatement::getWarnings(); }
 	virtual void		close(){ IscStatement::close(); }
@@ -119,7 +119,7 @@ bool IscProceduresResultSet::canSelectFromProcedure()
 	int countSUSPEND = 0;
 	//XSQLVAR *var = sqlda->Var(10);
 	auto *var = sqlda->Var(10);
-	IscBlob * blob = (IscBlob *)*(intptr_t*)var->sqldata;
+	IscBlob * blob = sqlda->getBlobStaticCursor( var->sqldata );
 	int length = blob->length();
 	
 	char * buffer = (char*)malloc (length);
@@ -0,0 +1,155 @@
+// IscQueryTimer.cpp: implementation of the IscQueryTimer class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "IscDbc.h"
+#include "IscQueryTimer.h"
+#include "IscStatement.h"
+
+namespace IscDbcLibrary {
+
+IscQueryTimer &queryTimer = *new IscQueryTimer;
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscQueryTimer::IscQueryTimer()
+{
+	wakeUp = Clock::time_point::max();
+	firing = NULL;
+	running = false;
+	stopping = false;
+}
+
+//
+// Stops the thread, when no statement is left that could be executing.
+// The next deadline starts it again.
+//
+void IscQueryTimer::shutdown()
+{
+	std::unique_lock<std::mutex> lock( mutex );
+
+	stopping = true;
+	changed.notify_one();
+
+	std::thread stopped;
+	stopped.swap( worker );
+	lock.unlock();
+
+	if ( stopped.joinable() )
+		stopped.join();
+
+	lock.lock();
+	stopping = false;
+}
+
+void IscQueryTimer::arm( IscStatement *statement, int seconds )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	statement->timerDeadline = Clock::now() + std::chrono::seconds( seconds );
+	deadlines.emplace( statement->timerDeadline, statement );
+
+	if ( !running )
+	{
+		// the thread that was idle for too long has ended, or is about to
+		if ( worker.joinable() )
+			worker.join();
+
+		running = true;
+		wakeUp = statement->timerDeadline;
+		worker = std::thread( &IscQueryTimer::run, this );
+	}
+	else if ( statement->timerDeadline < wakeUp )
+	{
+		// the fetches of a row each are later than the deadline waited for
+		wakeUp = statement->timerDeadline;
+		changed.notify_one();
+	}
+}
+
+//
+// Takes the deadline of the statement out. One the thread is cancelling
+// is waited for, the statement must outlive the cancel.
+//
+void IscQueryTimer::disarm( IscStatement *statement )
+{
+	std::unique_lock<std::mutex> lock( mutex );
+
+	deadlines.erase( std::make_pair( statement->timerDeadline, statement ) );
+	fired.wait( lock, [this, statement]{ return firing != statement; } );
+}
+
+//
+// Cancels each statement past its deadline. The cancel goes to the server
+// out of the lock, the deadlines of the other statements are kept and
+// taken out meanwhile.
+//
+void IscQueryTimer::run()
+{
+	std::unique_lock<std::mutex> lock( mutex );
+
+	while ( !stopping )
+	{
+		if ( deadlines.empty() )
+		{
+			wakeUp = Clock::time_point::max();
+
+			if ( !changed.wait_for( lock, std::chrono::seconds( QUERY_TIMER_IDLE_TIMEOUT ),
+									[this]{ return stopping || !deadlines.empty(); } ) )
+				break;
+
+			continue;
+		}
+
+		auto first = deadlines.begin();
+
+		if ( Clock::now() < first->first )
+		{
+			wakeUp = first->first;
+			changed.wait_until( lock, wakeUp );
+			continue;
+		}
+
+		IscStatement *statement = first->second;
+		deadlines.erase( first );
+
+		statement->timedOut = true;
+		firing = statement;
+
+		lock.unlock();
+		statement->cancel();
+		lock.lock();
+
+		firing = NULL;
+		fired.notify_all();
+	}
+
+	running = false;
+}
+
+//////////////////////////////////////////////////////////////////////
+// IscExecution
+//////////////////////////////////////////////////////////////////////
+
+IscExecution::IscExecution( IscStatement *stmt )
+{
+	statement = stmt;
+	armed = statement->queryTimeout > 0 && !statement->serverTimeout;
+	statement->timedOut = false;
+	statement->executing = true;
+
+	if ( armed )
+		queryTimer.arm( statement, statement->queryTimeout );
+}
+
+IscExecution::~IscExecution()
+{
+	if ( armed )
+		queryTimer.disarm( statement );
+
+	statement->endExecution();
+}
+
+}; // end namespace IscDbcLibrary
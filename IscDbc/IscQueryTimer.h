@@ -0,0 +1,74 @@
+// IscQueryTimer.h: interface for the IscQueryTimer class.
+//
+//	Query timeouts the server cannot keep, before Firebird 4 or through
+//	a client library without IStatement::setTimeout. The deadlines of
+//	the statements being executed are kept in order by one thread of the
+//	process, which cancels the operation of the attachment of each one
+//	that runs past its own. The thread is started by the first deadline
+//	and ends once none has been left for a while, or when the driver
+//	lets its last environment go. The timer is never destroyed, so that
+//	no static destructor joins the thread while the driver is unloaded.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCQUERYTIMER_H_)
+#define _ISCQUERYTIMER_H_
+
+#include <set>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace IscDbcLibrary {
+
+class IscStatement;
+
+#define QUERY_TIMER_IDLE_TIMEOUT	30	// seconds
+
+class IscQueryTimer
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	IscQueryTimer();
+
+	void	arm( IscStatement *statement, int seconds );
+	void	disarm( IscStatement *statement );
+	void	shutdown();
+
+private:
+	void	run();
+
+	std::set< std::pair<Clock::time_point, IscStatement*> > deadlines;	// the nearest first
+	std::mutex				mutex;
+	std::condition_variable	changed;
+	std::condition_variable	fired;
+	IscStatement			*firing;	// cancelled by the thread, out of the lock
+	std::thread				worker;
+	Clock::time_point		wakeUp;		// when the thread looks at the deadlines next
+	bool					running;
+	bool					stopping;
+};
+
+extern IscQueryTimer &queryTimer;
+
+//
+// Marks a statement as running a call to the server for as long as it
+// lives, so that a cancel from another thread reaches the server, and
+// keeps the deadline of the query timeout when the server does not.
+//
+class IscExecution
+{
+public:
+	IscExecution( IscStatement *stmt );
+	~IscExecution();
+
+private:
+	IscStatement	*statement;
+	bool			armed;
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCQUERYTIMER_H_)
@@ -0,0 +1,162 @@
+// IscReadAhead.cpp: implementation of the IscReadAhead class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "IscDbc.h"
+#include "IscReadAhead.h"
+#include "IscStatement.h"
+#include "IscConnection.h"
+#include "SQLError.h"
+
+using namespace Firebird;
+
+namespace IscDbcLibrary {
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscReadAhead::IscReadAhead( IscStatement *stmt, int rows )
+{
+	statement = stmt;
+	cursor = statement->fbResultSet;
+	status = NULL;
+	lengthMessage = statement->outputSqlda.buffer.size();
+	head = tail = count = 0;
+	eof = false;
+	stopping = false;
+
+	// Bound the ring both in rows and in bytes; wide rows get fewer slots
+	size_t slots = MIN( rows, READ_AHEAD_MAX_ROWS );
+	if ( lengthMessage && slots * lengthMessage > READ_AHEAD_MAX_BYTES )
+		slots = READ_AHEAD_MAX_BYTES / lengthMessage;
+	if ( slots < 2 )
+		slots = 2;
+
+	ring.resize( slots );
+	for ( auto& slot : ring )
+		slot.resize( lengthMessage );
+}
+
+IscReadAhead::~IscReadAhead()
+{
+	stop();
+}
+
+void IscReadAhead::start()
+{
+	status = statement->connection->GDS->_master->getStatus();
+	worker = std::thread( &IscReadAhead::run, this );
+}
+
+//
+// Asks the worker to finish and waits for it. A fetch that is already
+// on the wire completes first, so the IResultSet is idle on return and
+// the caller may close it safely.
+//
+void IscReadAhead::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		stopping = true;
+	}
+
+	notFull.notify_all();
+	notEmpty.notify_all();
+
+	if ( worker.joinable() )
+		worker.join();
+
+	if ( status )
+	{
+		status->dispose();
+		status = NULL;
+	}
+}
+
+void IscReadAhead::run()
+{
+	ThrowStatusWrapper statusWrapper( status );
+	std::unique_lock<std::mutex> lock( mutex );
+
+	try
+	{
+		while ( true )
+		{
+			notFull.wait( lock, [this]{ return stopping || count < ring.size(); } );
+
+			if ( stopping )
+				break;
+
+			// slot at tail belongs to the worker until count is incremented
+			char *slot = ring[tail].data();
+			lock.unlock();
+
+			int ret = cursor->fetchNext( &statusWrapper, slot );
+
+			lock.lock();
+
+			if ( ret == IStatus::RESULT_NO_DATA )
+				break;
+
+			tail = ( tail + 1 ) % ring.size();
+			++count;
+			notEmpty.notify_one();
+		}
+	}
+	catch ( const FbException& fbError )
+	{
+		try
+		{
+			THROW_ISC_EXCEPTION( statement->connection, fbError.getStatus() );
+		}
+		catch ( ... )
+		{
+			if ( !lock.owns_lock() )
+				lock.lock();
+			error = std::current_exception();
+		}
+	}
+
+	if ( !lock.owns_lock() )
+		lock.lock();
+
+	eof = true;
+	notEmpty.notify_all();
+}
+
+//
+// Copies the next prefetched message into message.
+// Returns false at end of cursor; errors raised by the worker
+// are rethrown here, in the order they happened.
+//
+bool IscReadAhead::fetch( char *message )
+{
+	std::unique_lock<std::mutex> lock( mutex );
+
+	notEmpty.wait( lock, [this]{ return count > 0 || eof || stopping; } );
+
+	if ( !count )
+	{
+		if ( error )
+		{
+			std::exception_ptr pending = error;
+			error = nullptr;
+			std::rethrow_exception( pending );
+		}
+
+		return false;
+	}
+
+	memcpy( message, ring[head].data(), lengthMessage );
+	head = ( head + 1 ) % ring.size();
+	--count;
+
+	lock.unlock();
+	notFull.notify_one();
+
+	return true;
+}
+
+}; // end namespace IscDbcLibrary
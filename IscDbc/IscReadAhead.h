@@ -0,0 +1,58 @@
+// IscReadAhead.h: interface for the IscReadAhead class.
+//
+//	Background read-ahead for forward-only cursors. A worker thread
+//	fetches Firebird messages into a bounded ring of buffers laid out
+//	exactly like Sqlda::buffer, so the consumer only has to copy an
+//	already received row instead of waiting on the wire.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCREADAHEAD_H_)
+#define _ISCREADAHEAD_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace IscDbcLibrary {
+
+class IscStatement;
+
+#define READ_AHEAD_MAX_ROWS			4096
+#define READ_AHEAD_MAX_BYTES		( 16 * 1024 * 1024 )
+
+class IscReadAhead
+{
+public:
+	IscReadAhead( IscStatement *stmt, int rows );
+	~IscReadAhead();
+
+	void	start();
+	void	stop();
+	bool	fetch( char *message );
+
+private:
+	void	run();
+
+	IscStatement					*statement;
+	Firebird::IResultSet			*cursor;
+	Firebird::IStatus				*status;	// owned by the worker thread
+	std::vector< std::vector<char> > ring;
+	size_t							lengthMessage;
+	size_t							head;
+	size_t							tail;
+	size_t							count;
+	bool							eof;
+	bool							stopping;
+	std::exception_ptr				error;
+	std::mutex						mutex;
+	std::condition_variable			notEmpty;
+	std::condition_variable			notFull;
+	std::thread						worker;
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCREADAHEAD_H_)
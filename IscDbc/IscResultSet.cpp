@@ -38,6 +38,7 @@
 #include "IscArray.h"
 #include "IscBlob.h"
 #include "IscConnection.h"
+#include "IscReadAhead.h"
 #include "SQLError.h"
 #include "Value.h"
 
@@ -79,6 +80,7 @@ void IscResultSet::initResultSet(IscStatement *iscStatement)
 	sqlda		= NULL;
 	numberColumns = 0;
 	sqldataOffsetPtr = 0;
+	sqlindOffsetPtr = 0;
 
 	if (statement)
 	{
@@ -97,14 +99,34 @@ void IscResultSet::initResultSet(IscStatement *iscStatement)
 // Is used only for cursors OdbcFb
 // It is forbidden to use in IscDbc
 bool IscResultSet::nextFetch()
+{
+	return fetchMessage( sqlda->buffer.data() );
+}
+
+//
+// Fetches the next message of the cursor into message, which must be
+// laid out like sqlda->buffer. Closes the result set at end of cursor.
+//
+bool IscResultSet::fetchMessage(char *message)
 {
 	if (!statement || !statement->fbResultSet)
 		throw SQLEXCEPTION (RUNTIME_ERROR, "resultset is not active");
 
+	if ( statement->readAhead )
+	{
+		if ( !statement->readAhead->fetch( message ) )
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
 	ThrowStatusWrapper status( statement->connection->GDS->_status );
 	try
 	{
-		auto fetch_stat = statement->fbResultSet->fetchNext( &status, sqlda->buffer.data() );
+		IscExecution execution( statement );
+		auto fetch_stat = statement->fbResultSet->fetchNext( &status, message );
 
 		if( fetch_stat == IStatus::RESULT_NO_DATA ) {
 			close();
@@ -113,12 +135,42 @@ bool IscResultSet::nextFetch()
 	}
 	catch( const FbException& error )
 	{
-		THROW_ISC_EXCEPTION( statement->connection, error.getStatus() );
+		statement->throwExecuteError( error.getStatus() );
 	}
 
 	return true;
 }
 
+//
+// Fetches up to maxRows messages into one contiguous block.
+// Row n of the block starts at sqlda->buffer + *offsetFirstRow + n * *lengthRow,
+// so the address of any sqlvar of that row is its sqldata plus the same offset.
+// The messages are fetched straight into the block; only the last one is
+// copied to sqlda->buffer, so that it holds the current row as after nextFetch.
+// Overrides of nextFetch are bypassed, catalog result sets must not use it.
+//
+int IscResultSet::nextFetchBlock(int maxRows, intptr_t *offsetFirstRow, size_t *lengthRow)
+{
+	size_t length = sqlda->buffer.size();
+	size_t stride = ROUNDUP( length, 8 );
+
+	if ( blockBuffer.size() < stride * maxRows )
+		blockBuffer.resize( stride * maxRows );
+
+	int nRow = 0;
+
+	while ( nRow < maxRows && fetchMessage( blockBuffer.data() + nRow * stride ) )
+		++nRow;
+
+	if ( nRow )
+		memcpy( sqlda->buffer.data(), blockBuffer.data() + ( nRow - 1 ) * stride, length );
+
+	*offsetFirstRow = (intptr_t)blockBuffer.data() - (intptr_t)sqlda->buffer.data();
+	*lengthRow = stride;
+
+	return nRow;
+}
+
 bool IscResultSet::next()
 {
 	if (!statement || !statement->fbResultSet)
@@ -131,6 +183,7 @@ bool IscResultSet::next()
 	ThrowStatusWrapper status( statement->connection->GDS->_status );
 	try
 	{
+		IscExecution execution( statement );
 		auto fetch_stat = statement->fbResultSet->fetchNext( &status, sqlda->buffer.data() );
 
 		if( fetch_stat == IStatus::RESULT_NO_DATA ) {
@@ -140,7 +193,7 @@ bool IscResultSet::next()
 	}
 	catch( const FbException& error )
 	{
-		THROW_ISC_EXCEPTION( statement->connection, error.getStatus() );
+		statement->throwExecuteError( error.getStatus() );
 	}
 
     Value *value = values.values;
@@ -153,6 +206,8 @@ bool IscResultSet::next()
 
 bool IscResultSet::setCurrentRowInBufferStaticCursor(int nRow)
 {
+	// every rowset of a keyset-driven cursor reads its rows afresh
+	sqlda->refreshKeysetCursor();
 	return sqlda->setCurrentRowInBufferStaticCursor(nRow);
 }
 
@@ -161,7 +216,8 @@ bool IscResultSet::readFromSystemCatalog()
 	if (!statement)
 		throw SQLEXCEPTION(RUNTIME_ERROR, "resultset is not active");
 
-	sqlda->initStaticCursor(statement);
+	// the catalog transaction ends once the rows are read, its BLOBs are read with them
+	sqlda->initStaticCursor(statement, true);
 
 	while (true)
 	{
@@ -182,12 +238,23 @@ bool IscResultSet::readStaticCursor()
 	if (!statement || !statement->fbResultSet)
 		throw SQLEXCEPTION (RUNTIME_ERROR, "resultset is not active");
 
+	// a keyset-driven cursor reads the keys with a statement of its own
+	if ( statement->keysetCursor && sqlda->openKeysetCursor(statement) )
+	{
+		statement->closeFbResultSet();
+		sqlda->setCurrentRowInBufferStaticCursor(0);
+		return true;
+	}
+
 	CFbDll * GDS = statement->connection->GDS;
 	sqlda->initStaticCursor(statement);
 
 	ThrowStatusWrapper status( GDS->_status );
 	try
 	{
+		// reading the whole cursor counts against the query timeout as well
+		IscExecution execution( statement );
+
 		while( true )
 		{
 			sqlda->restoreOrgAdressFieldsStaticCursor(); //need to restore pointers to sqlda buffer
@@ -199,7 +266,7 @@ bool IscResultSet::readStaticCursor()
 	catch( const FbException& error )
 	{
 		sqlda->restoreOrgAdressFieldsStaticCursor();
-		THROW_ISC_EXCEPTION( statement->connection, error.getStatus() );
+		statement->throwExecuteError( error.getStatus() );
 	}
 
 	sqlda->restoreOrgAdressFieldsStaticCursor();
@@ -217,6 +284,18 @@ void IscResultSet::copyNextSqldaInBufferStaticCursor()
 void IscResultSet::copyNextSqldaFromBufferStaticCursor()
 {
 	sqlda->copyNextSqldaFromBufferStaticCursor();
+	sqldataOffsetPtr = sqlindOffsetPtr = 0;
+}
+
+//
+// Makes the next row of the static cursor current for the conversions.
+// A row stored at full width is not copied: the data and indicator
+// offsets are pointed from the message buffer to the stored row.
+//
+void IscResultSet::nextRowInBufferStaticCursor()
+{
+	char *row = sqlda->nextRowInBufferStaticCursor();
+	sqldataOffsetPtr = sqlindOffsetPtr = row ? row - sqlda->buffer.data() : 0;
 }
 
 int IscResultSet::getCountRowsStaticCursor()
@@ -224,13 +303,18 @@ int IscResultSet::getCountRowsStaticCursor()
 	return sqlda->getCountRowsStaticCursor();
 }
 
+size_t IscResultSet::getMemoryStaticCursor()
+{
+	return sqlda->getMemoryStaticCursor();
+}
+
 bool IscResultSet::getDataFromStaticCursor (int column/*, Blob * pointerBlobData*/)
 {
 	if ( !(activePosRowInSet >= 0 && activePosRowInSet < sqlda->getCountRowsStaticCursor()) )
 		return false;
 
 	sqlda->setCurrentRowInBufferStaticCursor(activePosRowInSet);
-	sqlda->copyNextSqldaFromBufferStaticCursor();
+	nextRowInBufferStaticCursor();
 	return true;
 }
 
@@ -527,6 +611,11 @@ size_t* IscResultSet::getSqlDataOffsetPtr()
 	return &sqldataOffsetPtr;
 }	
 
+size_t* IscResultSet::getSqlIndOffsetPtr()
+{
+	return &sqlindOffsetPtr;
+}
+
 bool IscResultSet::isBeforeFirst()
 {
 	return statysPositionRow == enBEFORE_FIRST;
@@ -571,14 +660,12 @@ void IscResultSet::currRowsetStart()
 
 bool IscResultSet::first()
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return fetchScroll( enSCROLL_FIRST, 0 );
 }
 
 bool IscResultSet::last()
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return fetchScroll( enSCROLL_LAST, 0 );
 }
 
 int IscResultSet::getRow()
@@ -589,20 +676,65 @@ int IscResultSet::getRow()
 
 bool IscResultSet::absolute (int row)
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return fetchScroll( enSCROLL_ABSOLUTE, row );
 }
 
 bool IscResultSet::relative (int rows)
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return fetchScroll( enSCROLL_RELATIVE, rows );
 }
 
 bool IscResultSet::previous()
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return fetchScroll( enSCROLL_PRIOR, 0 );
+}
+
+//
+// Moves a server-side scrollable cursor (see IscStatement::isScrollableCursor)
+// and fetches the row it lands on into sqlda->buffer. Unlike nextFetch the
+// result set stays open when the move runs off either end of the cursor.
+//
+bool IscResultSet::fetchScroll(enScrollDirection direction, int offset)
+{
+	if (!statement || !statement->fbResultSet)
+		throw SQLEXCEPTION (RUNTIME_ERROR, "resultset is not active");
+
+	if ( !statement->isScrollableCursor() )
+		throw SQLEXCEPTION (RUNTIME_ERROR, "cursor is not scrollable");
+
+	IResultSet *cursor = statement->fbResultSet;
+	void *message = sqlda->buffer.data();
+	int fetch_stat;
+
+	ThrowStatusWrapper status( statement->connection->GDS->_status );
+	try
+	{
+		switch ( direction )
+		{
+		case enSCROLL_FIRST:
+			fetch_stat = cursor->fetchFirst( &status, message );
+			break;
+		case enSCROLL_LAST:
+			fetch_stat = cursor->fetchLast( &status, message );
+			break;
+		case enSCROLL_PRIOR:
+			fetch_stat = cursor->fetchPrior( &status, message );
+			break;
+		case enSCROLL_ABSOLUTE:
+			fetch_stat = cursor->fetchAbsolute( &status, offset, message );
+			break;
+		default:
+			fetch_stat = offset == 1 ? cursor->fetchNext( &status, message )
+									 : cursor->fetchRelative( &status, offset, message );
+			break;
+		}
+	}
+	catch( const FbException& error )
+	{
+		THROW_ISC_EXCEPTION( statement->connection, error.getStatus() );
+	}
+
+	return fetch_stat == IStatus::RESULT_OK;
 }
 
 void IscResultSet::setFetchDirection (int direction)
@@ -630,8 +762,7 @@ int IscResultSet::getType()
 
 bool IscResultSet::rowUpdated()
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return sqlda->rowUpdatedStaticCursor();
 }
 
 bool IscResultSet::rowInserted()
@@ -642,8 +773,7 @@ bool IscResultSet::rowInserted()
 
 bool IscResultSet::rowDeleted()
 {
-	NOT_YET_IMPLEMENTED;
-	return 0;
+	return sqlda->rowDeletedStaticCursor();
 }
 
 void IscResultSet::updateNull (int columnIndex)
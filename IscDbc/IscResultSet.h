@@ -40,6 +40,7 @@ class IscStatement;
 class IscDatabaseMetaData;
 
 enum enStatysActivePositionRow { enSUCCESS, enUNKNOWN, enINSERT_ROW, enAFTER_LAST, enBEFORE_FIRST };
+enum enScrollDirection { enSCROLL_FIRST, enSCROLL_LAST, enSCROLL_PRIOR, enSCROLL_ABSOLUTE, enSCROLL_RELATIVE };
 
 class IscResultSet : public ResultSet, public IscStatementMetaData
 {
@@ -173,13 +174,19 @@ public:
 	virtual void		setPosRowInSet(int posRow);
 	virtual int			getPosRowInSet();
 	virtual size_t		*getSqlDataOffsetPtr();
+	virtual size_t		*getSqlIndOffsetPtr();
 	virtual bool		readStaticCursor();
 	virtual bool		readFromSystemCatalog();
 	virtual bool		nextFetch();
+	virtual int			nextFetchBlock(int maxRows, intptr_t *offsetFirstRow, size_t *lengthRow);
+	bool				fetchMessage(char *message);
+	bool				fetchScroll(enScrollDirection direction, int offset);
 	virtual bool		setCurrentRowInBufferStaticCursor(int nRow);
 	virtual void		copyNextSqldaInBufferStaticCursor();
 	virtual void		copyNextSqldaFromBufferStaticCursor();
+	virtual void		nextRowInBufferStaticCursor();
 	virtual int			getCountRowsStaticCursor();
+	virtual size_t		getMemoryStaticCursor();
 	virtual bool		getDataFromStaticCursor (int column);
 	virtual bool		nextFromProcedure();
 
@@ -198,6 +205,8 @@ public:
 	LinkedList		clobs;
 	int				activePosRowInSet;
 	size_t			sqldataOffsetPtr;
+	size_t			sqlindOffsetPtr;
+	std::vector<char> blockBuffer;		// rowset of messages for nextFetchBlock
 	enStatysActivePositionRow statysPositionRow;
 };
 
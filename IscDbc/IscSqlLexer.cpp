@@ -0,0 +1,230 @@
+// IscSqlLexer.cpp: implementation of the IscSqlLexer class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "IscSqlLexer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define SQL_LEXER_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SQL_LEXER_NEON
+#endif
+
+namespace IscDbcLibrary {
+
+static inline bool isWhite( char c )
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
+}
+
+static inline bool isIdent( char c )
+{
+	return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || isDigit( c ) || c == '_' || c == '$';
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscSqlLexer::IscSqlLexer( const char *sql )
+{
+	text = sql;
+	length = strlen( sql );
+	offset = 0;
+	depth = 0;
+}
+
+IscSqlLexer::IscSqlLexer( const char *sql, size_t len )
+{
+	text = sql;
+	length = len;
+	offset = 0;
+	depth = 0;
+}
+
+bool IscSqlLexer::next( SqlToken &token )
+{
+	if ( offset >= length )
+		return false;
+
+	const char *end = text + length;
+	const char *p = text + offset;
+	char c = *p;
+
+	token.begin = offset;
+	token.depth = depth;
+	token.closed = true;
+
+	if ( isWhite( c ) )
+	{
+		while ( ++p < end && isWhite( *p ) )
+			;
+		token.kind = ' ';
+	}
+	else if ( c == '-' && p + 1 < end && p[1] == '-' )
+	{
+		p += 2;
+		while ( p < end && *p != '\n' )
+			++p;
+		token.kind = 'c';
+	}
+	else if ( c == '/' && p + 1 < end && p[1] == '*' )
+	{
+		p += 2;
+		while ( p + 1 < end && !( p[0] == '*' && p[1] == '/' ) )
+			++p;
+
+		if ( p + 1 < end )
+			p += 2;
+		else
+		{
+			p = end;
+			token.closed = false;
+		}
+		token.kind = 'c';
+	}
+	else if ( c == '\'' || c == '"' )
+	{
+		// a doubled quote stands for itself
+		token.closed = false;
+		while ( ++p < end )
+			if ( *p == c )
+			{
+				if ( p + 1 < end && p[1] == c )
+				{
+					++p;
+					continue;
+				}
+				++p;
+				token.closed = true;
+				break;
+			}
+		token.kind = c;
+	}
+	else if ( isIdent( c ) )
+	{
+		while ( ++p < end && isIdent( *p ) )
+			;
+		token.kind = isDigit( c ) ? 'n' : 'w';
+	}
+	else
+	{
+		if ( c == '(' )
+			++depth;
+		else if ( c == ')' )
+			--depth;
+		++p;
+		token.kind = c;
+	}
+
+	offset = p - text;
+	token.end = offset;
+
+	return true;
+}
+
+//
+// The next token that is neither white space nor a comment.
+//
+bool IscSqlLexer::nextSignificant( SqlToken &token )
+{
+	while ( next( token ) )
+		if ( token.kind != ' ' && token.kind != 'c' )
+			return true;
+
+	return false;
+}
+
+void IscSqlLexer::moveTo( size_t position )
+{
+	offset = position < length ? position : length;
+}
+
+bool IscSqlLexer::isWord( const char *sql, const SqlToken &token, const char *word )
+{
+	if ( token.kind != 'w' )
+		return false;
+
+	const char *p = sql + token.begin;
+	const char *end = sql + token.end;
+
+	for ( ; p < end && *word; ++p, ++word )
+	{
+		char c = *p >= 'a' && *p <= 'z' ? *p - 'a' + 'A' : *p;
+		char w = *word >= 'a' && *word <= 'z' ? *word - 'a' + 'A' : *word;
+
+		if ( c != w )
+			return false;
+	}
+
+	return p == end && !*word;
+}
+
+//
+// Every token of the text but white space and comments.
+//
+void IscSqlLexer::tokenize( const char *sql, std::vector<SqlToken> &tokens )
+{
+	IscSqlLexer lexer( sql );
+	SqlToken token;
+
+	while ( lexer.nextSignificant( token ) )
+		tokens.push_back( token );
+}
+
+//
+// The first '{' of the text, or NULL. Text without one has no escape
+// sequence to translate, and most of what applications prepare has
+// none, so it is looked for sixteen bytes at a time.
+//
+const char* IscSqlLexer::findEscape( const char *sql, size_t length )
+{
+	const char *p = sql;
+	const char *end = sql + length;
+
+#if defined(SQL_LEXER_SSE2)
+	const __m128i brace = _mm_set1_epi8( '{' );
+
+	for ( ; end - p >= 16; p += 16 )
+		if ( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*)p ), brace ) ) )
+			break;
+#elif defined(SQL_LEXER_NEON)
+	const uint8x16_t brace = vdupq_n_u8( '{' );
+
+	for ( ; end - p >= 16; p += 16 )
+		if ( vmaxvq_u8( vceqq_u8( vld1q_u8( (const uint8_t*)p ), brace ) ) )
+			break;
+#endif
+
+	for ( ; p < end; ++p )
+		if ( *p == '{' )
+			return p;
+
+	return NULL;
+}
+
+//
+// The first of the symbols outside literals, comments and parentheses
+// opened after the start of the text, or the end of the text.
+//
+const char* IscSqlLexer::findSymbol( const char *sql, const char *symbols )
+{
+	IscSqlLexer lexer( sql );
+	SqlToken token;
+
+	while ( lexer.next( token ) )
+		if ( !token.depth && token.end - token.begin == 1 && strchr( symbols, token.kind ) )
+			return sql + token.begin;
+
+	return sql + lexer.length;
+}
+
+}; // end namespace IscDbcLibrary
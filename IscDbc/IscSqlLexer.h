@@ -0,0 +1,57 @@
+// IscSqlLexer.h: interface for the IscSqlLexer class.
+//
+//	Splits SQL text into tokens in a single pass: words, numbers, quoted
+//	strings and identifiers, comments, white space and single character
+//	symbols, each with the parenthesis depth it is at. Escape processing,
+//	schema removal, procedure call translation and parameter counting all
+//	read the text through it, so that they agree on what is inside a
+//	literal or a comment. It uses nothing but the C library, so it can be
+//	benchmarked on its own.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCSQLLEXER_H_)
+#define _ISCSQLLEXER_H_
+
+#include <stddef.h>
+#include <vector>
+
+namespace IscDbcLibrary {
+
+struct SqlToken
+{
+	size_t	begin;		// offsets in the text
+	size_t	end;
+	int		depth;		// of parentheses around the token
+	char	kind;		// 'w' - word, 'n' - number, '\'' or '"' - quoted, ' ' - white space,
+						// 'c' - comment, else the symbol
+	bool	closed;		// a quoted token or comment has its end
+};
+
+class IscSqlLexer
+{
+public:
+	IscSqlLexer( const char *sql );
+	IscSqlLexer( const char *sql, size_t length );
+
+	bool	next( SqlToken &token );
+	bool	nextSignificant( SqlToken &token );
+	void	moveTo( size_t offset );
+	bool	isWord( const SqlToken &token, const char *word ) const { return isWord( text, token, word ); }
+
+	static bool			isWord( const char *sql, const SqlToken &token, const char *word );
+	static void			tokenize( const char *sql, std::vector<SqlToken> &tokens );
+	static const char*	findEscape( const char *sql, size_t length );
+	static const char*	findSymbol( const char *sql, const char *symbols );
+
+	const char	*text;
+	size_t		length;
+
+private:
+	size_t		offset;
+	int			depth;
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCSQLLEXER_H_)
@@ -80,6 +80,8 @@
 //////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include <time.h>
 #include "IscDbc.h"
 #include "ListParamTransaction.h"
@@ -89,6 +91,11 @@
 #include "Attachment.h"
 #include "IscBlob.h"
 #include "IscArray.h"
+#include "IscExecuteBlock.h"
+#include "IscReadAhead.h"
+#include "IscStatementCache.h"
+#include "IscNativeSqlCache.h"
+#include "IscSqlLexer.h"
 
 #include "SQLError.h"
 #include "Value.h"
@@ -114,6 +121,27 @@ IscStatement::IscStatement(IscConnection *connect) :
 	numberColumns = 0;
 	statementHandle = NULL;
 	fbResultSet = nullptr;
+	readAhead = NULL;
+	readAheadRows = 0;
+	scrollableCursor = false;
+	scrollableCursorOpen = false;
+	staticCursorMemory = 0;
+	blobCacheMemory = DEFAULT_BLOB_CACHE_MEMORY;
+	keysetCursor = false;
+	executeBlockBatch = false;
+	streamBlobs = 0;
+	batch = NULL;
+	batchMeta = NULL;
+	batchBlobs = false;
+	batchRows = 0;
+	batchBytes = 0;
+	batchBlobIds = 0;
+	executeBlock = NULL;
+	preparedType = 0;
+	cursorNamed = false;
+	direct = false;
+	readOnlyQuery = false;
+	queryTransaction = false;
 	transactionLocal = false;
 	transactionStatusChange = false;
 	transactionStatusChangingToLocal = false;
@@ -123,6 +151,12 @@ IscStatement::IscStatement(IscConnection *connect) :
 	resultsCount = 0;
 	resultsSequence	= 0;
 	summaryUpdateCount = 0;
+	updateCountPending = false;
+	queryTimeout = 0;
+	serverTimeout = false;
+	executing = false;
+	timedOut = false;
+	cancelSent = false;
 }
 
 IscStatement::~IscStatement()
@@ -131,8 +165,14 @@ IscStatement::~IscStatement()
 		resultSet->close();
 	END_FOR;
 
+	delete readAhead;
+
 	try
 	{
+		cancelBatch();
+		delete executeBlock;
+		executeBlock = NULL;
+
 		if (statementHandle)
 			freeStatementHandle();
 
@@ -280,6 +320,11 @@ void IscStatement::switchTransaction( bool local )
 
 ITransaction* IscStatement::startTransaction()
 {
+	std::lock_guard<std::recursive_mutex> guard( connection->transactionMutex );
+
+	if ( queryTransaction )
+		return connection->startQueryTransaction();
+
 	if ( connection->shareConnected )
 		return connection->startTransaction();
 
@@ -323,79 +368,36 @@ ITransaction* IscStatement::startTransaction()
 			return tr->transactionHandle;
 	}
 
-	IUtil* utl    = connection->GDS->_master->getUtilInterface();
-	IXpbBuilder* tpb = nullptr;
+	bool serverAutoCommit = false;
+	const unsigned char *tpbBuffer;
+	unsigned count;
+
+	if ( !tr->nodeParamTransaction )
+	{
+		const std::vector<unsigned char> &tpb = connection->getTpb( *tr, serverAutoCommit );
+		tpbBuffer = tpb.data();
+		count = (unsigned)tpb.size();
+	}
+	else
+	{
+		tpbBuffer = (const unsigned char*)tr->nodeParamTransaction->tpbBuffer;
+		count = tr->nodeParamTransaction->lengthTpbBuffer;
+		tr->autoCommit = tr->nodeParamTransaction->autoCommit;
+	}
+
 	ThrowStatusWrapper status( connection->GDS->_status );
 	try
 	{
-		char *tpbBuffer;
-		int count;
-
-		if ( !tr->nodeParamTransaction )
-		{
-			tpb = utl->getXpbBuilder(&status, IXpbBuilder::TPB, NULL, 0);
-
-			tpb->insertTag( &status, (tr->transactionExtInit & TRA_ro) ? isc_tpb_read   : isc_tpb_write );
-			tpb->insertTag( &status, (tr->transactionExtInit & TRA_nw) ? isc_tpb_nowait : isc_tpb_wait  );
-
-			/* Isolation level */
-			switch( tr->transactionIsolation )
-			{
-				case 0x00000008L:
-					// SQL_TXN_SERIALIZABLE:
-					tpb->insertTag( &status, isc_tpb_consistency );
-					break;
-
-				case 0x00000004L:
-					// SQL_TXN_REPEATABLE_READ:
-					tpb->insertTag( &status, isc_tpb_concurrency );
-					break;
-
-				case 0x00000001L:
-					// SQL_TXN_READ_UNCOMMITTED:
-					tpb->insertTag( &status, isc_tpb_read_committed );
-					tpb->insertTag( &status, isc_tpb_no_rec_version );
-					break;
-
-				case 0x00000002L:
-				default:
-					// SQL_TXN_READ_COMMITTED:
-					tpb->insertTag( &status, isc_tpb_read_committed );
-					tpb->insertTag( &status, isc_tpb_rec_version );
-					break;
-			}
-
-			if ( !(tr->transactionExtInit & TRA_nw) 
-				&& connection->attachment->isFirebirdVer2_0()
-				&& connection->attachment->getUseLockTimeoutWaitTransactions() )
-			{
-				tpb->insertInt(&status, isc_tpb_lock_timeout, connection->attachment->getUseLockTimeoutWaitTransactions() );
-			}
-			
-			count = tpb->getBufferLength(&status);
-			tpbBuffer = (char*)tpb->getBuffer(&status);
-		}
-		else
-		{
-			tpbBuffer = tr->nodeParamTransaction->tpbBuffer;
-			count = tr->nodeParamTransaction->lengthTpbBuffer;
-			tr->autoCommit = tr->nodeParamTransaction->autoCommit;
-		}
-
 		tr->transactionHandle =
-			connection->attachment->databaseHandle->startTransaction( &status, count, (const unsigned char*)tpbBuffer );
-
-		if( tpb ) {
-			tpb->dispose();
-			tpb = nullptr;
-		}
+			connection->attachment->databaseHandle->startTransaction( &status, count, tpbBuffer );
 	}
 	catch( const FbException& error )
 	{
-		if( tpb ) tpb->dispose();
 		THROW_ISC_EXCEPTION ( connection, error.getStatus() );
 	}
 
+	tr->serverAutoCommit = serverAutoCommit;
+
 	if ( !tr->autoCommit )
 		tr->transactionPending = true;
 
@@ -441,7 +443,7 @@ void IscStatement::setMaxRows(int max)
 
 void IscStatement::setQueryTimeout(int seconds)
 {
-	NOT_YET_IMPLEMENTED;
+	queryTimeout = MAX( seconds, 0 );
 }
 
 bool IscStatement::execute(const char * sqlString)
@@ -474,14 +476,105 @@ int	IscStatement::getMaxRows()
 
 int	IscStatement::getQueryTimeout()
 {
-	NOT_YET_IMPLEMENTED;
+	return queryTimeout;
+}
 
-	return 0;
+//
+// Cancels the execution or fetch running in another thread. Returns false
+// when nothing is running, there is nothing the server could cancel then.
+// The call cannot end in the meantime: endExecution waits for the lock.
+//
+bool IscStatement::cancel()
+{
+	std::lock_guard<std::mutex> guard( connection->cancelMutex );
+
+	if ( !executing )
+		return false;
+
+	cancelSent = true;
+	cancelOperation( fb_cancel_raise );
+
+	return true;
 }
 
-void IscStatement::cancel()
+//
+// Firebird cancels what the attachment is running, whichever statement
+// of the connection that is.
+//
+void IscStatement::cancelOperation( int option )
 {
-	NOT_YET_IMPLEMENTED;
+	CheckStatusWrapper status( connection->GDS->_status );
+	connection->databaseHandle->cancelOperation( &status, option );
+}
+
+//
+// Marks the call to the server as returned. A cancel that reached the
+// server as the call was returning would be kept by the attachment and
+// fail its next call, whichever statement makes it: disabling and
+// enabling cancellation takes it back.
+//
+void IscStatement::endExecution()
+{
+	std::lock_guard<std::mutex> guard( connection->cancelMutex );
+
+	executing = false;
+
+	if ( cancelSent )
+	{
+		cancelSent = false;
+		cancelOperation( fb_cancel_disable );
+		cancelOperation( fb_cancel_enable );
+	}
+}
+
+//
+// Hands the query timeout to the server with the handle, which it keeps
+// from Firebird 4 on. Every execution sets it: a handle taken from the
+// statement cache may carry the timeout of another statement.
+//
+void IscStatement::applyQueryTimeout()
+{
+	serverTimeout = false;
+
+	if ( !statementHandle || connection->attachment->majorFb < 4 )
+		return;
+
+	// a client library before Firebird 4 has no IStatement::setTimeout
+	CheckStatusWrapper status( connection->GDS->_status );
+	statementHandle->setTimeout( &status, (unsigned)queryTimeout * 1000 );
+
+	serverTimeout = ( status.getState() & IStatus::STATE_ERRORS ) == 0;
+}
+
+//
+// The status vector carries the error code.
+//
+static bool hasError( IStatus *status, ISC_STATUS code )
+{
+	for ( const ISC_STATUS *p = status->getErrors(); *p != isc_arg_end; p += *p == isc_arg_cstring ? 3 : 2 )
+		if ( *p == isc_arg_gds && p[1] == code )
+			return true;
+
+	return false;
+}
+
+//
+// Throws the error of a failed execution or fetch. One cancelled by the
+// query timeout, of the server or of the driver, is told apart from a
+// cancel of the application.
+//
+void IscStatement::throwExecuteError(IStatus *status)
+{
+	bool timeout = timedOut;
+
+	for ( const ISC_STATUS *p = status->getErrors(); !timeout && *p != isc_arg_end; p += *p == isc_arg_cstring ? 3 : 2 )
+		if ( *p == isc_arg_gds )
+			timeout = p[1] == isc_cfg_stmt_timeout || p[1] == isc_att_stmt_timeout || p[1] == isc_req_stmt_timeout;
+
+	if ( timeout )
+		throw SQLEXCEPTION ( QUERY_TIMEOUT, "query timeout expired: %s", (const char*)connection->getIscStatusText( status ) );
+
+	THROW_ISC_EXCEPTION ( connection, status );
 }
 
 ResultList* IscStatement::search(const char * searchString)
@@ -515,6 +608,7 @@ void IscStatement::setCursorName(const char * name)
 	try
 	{
 		statementHandle->setCursorName( &status, name );
+		cursorNamed = true;
 	}
 	catch( const FbException& error )
 	{
@@ -561,6 +655,10 @@ int IscStatement::getUpdateCount()
 	if (outputSqlda.getColumnCount() > 0)
 		return -1;
 
+	// asked of the server only when someone wants to know
+	if ( updateCountPending && statementHandle )
+		getUpdateCounts();
+
 	return summaryUpdateCount;
 }
 
@@ -593,35 +691,66 @@ void IscStatement::deleteResultSet(IscResultSet * resultSet)
 void IscStatement::prepareStatement(const char * sqlString)
 {
 	clearResults();
+	delete executeBlock;
+	executeBlock = NULL;
 	sql = sqlString;
 	CFbDll * GDS = connection->GDS;
 
 	// Make sure we have a transaction started.  Allocate a statement.
 
-	ITransaction* transHandle = startTransaction();
-	ThrowStatusWrapper status( connection->GDS->_status );
-	try
+	queryTransaction = false;
+	ITransaction* transHandle = !transactionLocal && !transactionStatusChange && connection->useQueryTransaction()
+		? connection->startQueryTransaction() : startTransaction();
+	int dialect = connection->getDatabaseDialect();
+	IscStatementCache::Entry cached;
+	int statementType;
+
+	if ( connection->statementCache->take( sqlString, dialect, cached ) )
+	{
+		statementHandle = cached.statement;
+		inputSqlda.allocBuffer( this, cached.input );
+		outputSqlda.allocBuffer( this, cached.output );
+		openCursor = cached.openCursor;
+		statementType = cached.statementType;
+		summaryUpdateCount = 0;
+	}
+	else
 	{
-		int dialect = connection->getDatabaseDialect();
+		ThrowStatusWrapper status( connection->GDS->_status );
+		try
+		{
+			statementHandle =
+				connection->databaseHandle->prepare( &status, transHandle, 0, sqlString, dialect, IStatement::PREPARE_PREFETCH_METADATA );
 
-		statementHandle =
-			connection->databaseHandle->prepare( &status, transHandle, 0, sqlString, dialect, IStatement::PREPARE_PREFETCH_METADATA );
+			inputSqlda.allocBuffer( this, statementHandle->getInputMetadata( &status ) );
+			outputSqlda.allocBuffer( this, statementHandle->getOutputMetadata( &status ) );
 
-		inputSqlda.allocBuffer( this, statementHandle->getInputMetadata( &status ) );
-		outputSqlda.allocBuffer( this, statementHandle->getOutputMetadata( &status ) );
+			//OOAPI gives a 100% way to check whether stmt is selectable or not.
+			openCursor = ( statementHandle->getFlags(&status) & IStatement::FLAG_HAS_CURSOR );
 
-		//OOAPI gives a 100% way to check whether stmt is selectable or not.
-		openCursor = ( statementHandle->getFlags(&status) & IStatement::FLAG_HAS_CURSOR );
-	}
-	catch( const FbException& error )
-	{
-		THROW_ISC_EXCEPTION ( connection, error.getStatus() );
+			// prefetched with the metadata, it never changes after the prepare
+			statementType = statementHandle->getType( &status );
+		}
+		catch( const FbException& error )
+		{
+			THROW_ISC_EXCEPTION ( connection, error.getStatus() );
+		}
+
+		summaryUpdateCount = 0;
 	}
 
+	updateCountPending	= false;
+
 	typeStmt			= stmtPrepare;
 	resultsCount		= 1;
 	resultsSequence		= 0;
-	int statementType	= getUpdateCounts();
+	preparedType		= statementType;
+	cursorNamed			= false;
+	readOnlyQuery		= statementType == isc_info_sql_stmt_select && isReadOnlyQuery( sqlString );
+
+	for ( int n = 1; readOnlyQuery && n <= inputSqlda.getColumnCount(); ++n )
+		if ( inputSqlda.Var( n )->sqltype == SQL_BLOB || inputSqlda.Var( n )->sqltype == SQL_ARRAY )
+			readOnlyQuery = false;
 
 	switch ( statementType )
 	{
@@ -650,9 +779,30 @@ bool IscStatement::execute()
 	if ( isActiveSelect() && connection->transactionInfo.autoCommit && resultSets.isEmpty() )
 		clearSelect();
 
+	// statements kept by the cache would hold the objects the DDL changes
+	if ( isActiveDDL() )
+	{
+		connection->statementCache->clear();
+		connection->nativeSqlCache->clear();
+	}
+
+	if ( readAhead )
+	{
+		delete readAhead;
+		readAhead = NULL;
+	}
+
+	// a SELECT in autocommit mode reads in the read-only transaction
+	queryTransaction = readOnlyQuery && !cursorNamed && !transactionLocal && !transactionStatusChange
+		&& connection->useQueryTransaction();
+
+	applyQueryTimeout();
+
 	ThrowStatusWrapper status( connection->GDS->_status );
 	try
 	{
+		IscExecution execution( this );
+
 		// Make sure there is a transaction
 		ITransaction* transHandle = startTransaction();
 
@@ -660,28 +810,62 @@ bool IscStatement::execute()
 		auto* _imeta = inputSqlda.useExecBufferMeta ? inputSqlda.execMeta   : inputSqlda.meta;
 		auto& _ibuf  = inputSqlda.useExecBufferMeta ? inputSqlda.execBuffer : inputSqlda.buffer;
 
+		scrollableCursorOpen = false;
+
 		if( openCursor == false )
 		{
 			statementHandle->execute( &status, transHandle, _imeta, _ibuf.data(), NULL, NULL);
 		}
 		else
 		{
-			fbResultSet = statementHandle->openCursor( &status, transHandle,
-			                                           _imeta, _ibuf.data(),
-			                                           outputSqlda.meta, 0 );
+			// Scrollable cursors need Firebird 3; a server or statement that
+			// refuses one gets the plain cursor and the caller falls back to
+			// its client-side static cursor.
+			if ( scrollableCursor && connection->attachment->majorFb >= 3 )
+			{
+				try
+				{
+					fbResultSet = statementHandle->openCursor( &status, transHandle,
+					                                           _imeta, _ibuf.data(),
+					                                           outputSqlda.meta, IStatement::CURSOR_TYPE_SCROLLABLE );
+					scrollableCursorOpen = true;
+				}
+				catch( const FbException& )
+				{
+					status.clearException();
+					fbResultSet = nullptr;
+				}
+			}
+
+			if ( !fbResultSet )
+				fbResultSet = statementHandle->openCursor( &status, transHandle,
+				                                           _imeta, _ibuf.data(),
+				                                           outputSqlda.meta, 0 );
 		}
 	}
 	catch( const FbException& error )
 	{
+		// the query writes after all, through a routine isReadOnlyQuery
+		// could not tell from a table: it keeps the normal transaction
+		if ( queryTransaction && hasError( error.getStatus(), isc_read_only_trans ) )
+		{
+			status.clearException();
+			clearSelect();
+			readOnlyQuery = false;
+			return execute();
+		}
+
 		if ( connection->transactionInfo.autoCommit )
 			connection->rollbackAuto();
 		clearSelect();
-		THROW_ISC_EXCEPTION ( connection, error.getStatus() );
+		throwExecuteError( error.getStatus() );
 	}
 
 	resultsCount		= 1;
 	resultsSequence		= 0;
-	int statementType	= getUpdateCounts();
+	summaryUpdateCount	= 0;
+	updateCountPending	= true;
+	int statementType	= preparedType;
 
 	if ( isActiveSelect() )
 		typeStmt = stmtNone;
@@ -718,24 +902,399 @@ bool IscStatement::execute()
 	case isc_info_sql_stmt_insert:
 	case isc_info_sql_stmt_update:
 	case isc_info_sql_stmt_delete:
+		// the counts are read while the transaction of the request lasts
 		if ( transactionLocal )
 		{
 			if ( transactionInfo.autoCommit )
+			{
+				getUpdateCounts();
 				commitLocal();
+			}
 		}
 		else if ( connection->transactionInfo.autoCommit )
+		{
+			// a transaction the server commits is kept open
+			if ( !connection->transactionInfo.serverAutoCommit )
+				getUpdateCounts();
 			connection->commitAuto();
+		}
 		break;
 	}
 
+	// a positioned update or delete acts on the row the server cursor is
+	// on, which must be the one the application has fetched
+	if ( readAheadRows > 0 && fbResultSet && isActiveCursor() && !isActiveSelectForUpdate() && !cursorNamed )
+	{
+		readAhead = new IscReadAhead( this, readAheadRows );
+		readAhead->start();
+	}
+
 	return outputSqlda.getColumnCount() > 0;
 }
 
+//
+// SET TIME ZONE, the timeouts and the DECFLOAT rounding and traps change
+// how the session runs statements, not how their text compiles, and
+// leave the statements the caches hold valid. Binds, roles, the search
+// path, the optimizer mode and ALTER SESSION RESET do not.
+//
+static bool keepsPreparedStatements( IscSqlLexer &lexer, const SqlToken &first, const SqlToken &second )
+{
+	if ( !lexer.isWord( first, "SET" ) )
+		return false;
+
+	if ( lexer.isWord( second, "TIME" ) || lexer.isWord( second, "SESSION" )
+		|| lexer.isWord( second, "STATEMENT" ) || lexer.isWord( second, "DEBUG" ) )
+		return true;
+
+	SqlToken third;
+
+	return lexer.isWord( second, "DECFLOAT" ) && lexer.nextSignificant( third ) && !lexer.isWord( third, "BIND" );
+}
+
+//
+// Takes the text to run with no prepared handle: DDL, session settings
+// and an INSERT of a single row of literals go through
+// IAttachment::execute, a SELECT through IAttachment::openCursor, none
+// with parameter markers. The type and the row count of the first follow
+// from the text, so one round trip does the work of prepare, execute and
+// the getInfo that reads them; the SELECT is described by its cursor.
+// selectCursor tells whether a forward-only cursor without a name will
+// do for a SELECT. Returns false when the statement has to be prepared,
+// or is kept prepared by the cache.
+//
+bool IscStatement::prepareDirect(const char * sqlString, bool selectCursor)
+{
+	int dialect = connection->getDatabaseDialect();
+
+	if ( connection->statementCache->contains( sqlString, dialect ) )
+		return false;
+
+	IscSqlLexer lexer( sqlString );
+	SqlToken token;
+	int statementType;
+	bool session = false;
+
+	if ( !lexer.nextSignificant( token ) )
+		return false;
+
+	if ( lexer.isWord( token, "INSERT" ) )
+		statementType = isc_info_sql_stmt_insert;
+	else if ( lexer.isWord( token, "SELECT" ) )
+	{
+		if ( !selectCursor )
+			return false;
+
+		statementType = isc_info_sql_stmt_select;
+	}
+	else if ( lexer.isWord( token, "CREATE" ) || lexer.isWord( token, "ALTER" )
+			|| lexer.isWord( token, "DROP" ) || lexer.isWord( token, "RECREATE" )
+			|| lexer.isWord( token, "COMMENT" ) || lexer.isWord( token, "GRANT" )
+			|| lexer.isWord( token, "REVOKE" ) || lexer.isWord( token, "SET" ) )
+	{
+		SqlToken second;
+
+		// transactions and databases are not started or created this way
+		if ( !lexer.nextSignificant( second )
+			|| lexer.isWord( second, "TRANSACTION" )
+			|| lexer.isWord( second, "DATABASE" )
+			|| lexer.isWord( second, "SCHEMA" ) )
+			return false;
+
+		statementType = isc_info_sql_stmt_ddl;
+		session = keepsPreparedStatements( lexer, token, second );
+	}
+	else
+		return false;
+
+	bool values = false;
+	SqlToken previous = {};
+
+	while ( lexer.nextSignificant( token ) )
+	{
+		if ( token.kind == '?' )
+			return false;
+
+		// FOR UPDATE and WITH LOCK need the handle the cursor is named on
+		if ( statementType == isc_info_sql_stmt_select
+			&& ( ( lexer.isWord( previous, "FOR" ) && lexer.isWord( token, "UPDATE" ) )
+				|| ( lexer.isWord( previous, "WITH" ) && lexer.isWord( token, "LOCK" ) ) ) )
+			return false;
+
+		previous = token;
+
+		if ( statementType != isc_info_sql_stmt_insert || token.depth )
+			continue;
+
+		// rows of a SELECT, or a RETURNING clause, are only known executed
+		if ( lexer.isWord( token, "SELECT" ) || lexer.isWord( token, "RETURNING" ) )
+			return false;
+
+		if ( lexer.isWord( token, "VALUES" ) )
+			values = true;
+	}
+
+	if ( statementType == isc_info_sql_stmt_insert && !values )
+		return false;
+
+	freeStatementHandle();
+
+	// described again by the cursor of a SELECT
+	inputSqlda.clearSqlda();
+	outputSqlda.clearSqlda();
+
+	sql = sqlString;
+	direct = true;
+	preparedType = statementType;
+	cursorNamed = false;
+	openCursor = statementType == isc_info_sql_stmt_select;
+	readOnlyQuery = openCursor && isReadOnlyQuery( sqlString );
+	resultsCount = 1;
+	resultsSequence = 0;
+	summaryUpdateCount = 0;
+	updateCountPending = false;
+	numberColumns = 0;
+
+	// a session setting leaves the caches alone
+	switch ( statementType )
+	{
+	case isc_info_sql_stmt_ddl:
+		typeStmt = session ? stmtNone : stmtDDL;
+		break;
+	case isc_info_sql_stmt_insert:
+		typeStmt = stmtInsert | stmtModify;
+		break;
+	default:
+		typeStmt = stmtPrepare;
+		break;
+	}
+
+	return true;
+}
+
+//
+// A SELECT that takes numbers from a sequence changes the database, and
+// one WITH LOCK locks the rows it reads: neither can run in a read-only
+// transaction.
+//
+//
+// Words a parenthesis follows in a query without a procedure or function
+// of the database being called: keywords, data types and the built-in
+// functions. Sorted for bsearch.
+//
+static const char *const queryWords[] =
+{
+	"ABS", "ACOS", "ACOSH", "ALL", "AND", "ANY", "ANY_VALUE", "AS", "ASC", "ASCII_CHAR",
+	"ASCII_VAL", "ASIN", "ASINH", "AT", "ATAN", "ATAN2", "ATANH", "AVG", "BASE64_DECODE",
+	"BASE64_ENCODE", "BETWEEN", "BINARY", "BIN_AND", "BIN_NOT", "BIN_OR", "BIN_SHL",
+	"BIN_SHL_ROT", "BIN_SHR", "BIN_SHR_ROT", "BIN_XOR", "BIT_LENGTH", "BLOB_APPEND", "BY",
+	"CASE", "CAST", "CEIL", "CEILING", "CHAR", "CHARACTER", "CHARACTER_LENGTH", "CHAR_LENGTH",
+	"CHAR_TO_UUID", "COALESCE", "COMPARE_DECFLOAT", "CONTAINING", "CORR", "COS", "COSH", "COT",
+	"COUNT", "COVAR_POP", "COVAR_SAMP", "CRYPT_HASH", "CUME_DIST", "DATEADD", "DATEDIFF",
+	"DECFLOAT", "DECIMAL", "DECODE", "DECRYPT", "DENSE_RANK", "DESC", "DISTINCT", "ELSE",
+	"ENCRYPT", "ESCAPE", "EXISTS", "EXP", "EXTRACT", "FETCH", "FIRST", "FIRST_DAY",
+	"FIRST_VALUE", "FLOAT", "FLOOR", "FROM", "FULL", "GEN_UUID", "GROUP", "HASH", "HAVING",
+	"HEX_DECODE", "HEX_ENCODE", "IIF", "IN", "INNER", "IS", "JOIN", "LAG", "LAST_DAY",
+	"LAST_VALUE", "LATERAL", "LEAD", "LEFT", "LIKE", "LIST", "LN", "LOG", "LOG10", "LOWER",
+	"LPAD", "MAKE_DBKEY", "MAX", "MAXVALUE", "MIN", "MINVALUE", "MOD", "NATIONAL", "NCHAR",
+	"NORMALIZE_DECFLOAT", "NOT", "NTH_VALUE", "NTILE", "NULLIF", "NUMERIC", "OCTET_LENGTH",
+	"OFFSET", "ON", "OR", "ORDER", "OUTER", "OVER", "OVERLAY", "PARTITION", "PERCENT_RANK",
+	"PI", "POSITION", "POWER", "QUANTIZE", "RAND", "RANGE", "RANK", "RDB$ERROR",
+	"RDB$GET_CONTEXT", "RDB$GET_TRANSACTION_CN", "RDB$ROLE_IN_USE", "RDB$SET_CONTEXT",
+	"RDB$SYSTEM_PRIVILEGE", "REGR_AVGX", "REGR_AVGY", "REGR_COUNT", "REGR_INTERCEPT",
+	"REGR_R2", "REGR_SLOPE", "REGR_SXX", "REGR_SXY", "REGR_SYY", "REPLACE", "REVERSE", "RIGHT",
+	"ROUND", "ROWS", "ROW_NUMBER", "RPAD", "RSA_DECRYPT", "RSA_ENCRYPT", "RSA_PRIVATE",
+	"RSA_PUBLIC", "RSA_SIGN_HASH", "RSA_VERIFY_HASH", "SELECT", "SIGN", "SIMILAR", "SIN",
+	"SINGULAR", "SINH", "SKIP", "SOME", "SQRT", "STARTING", "STDDEV_POP", "STDDEV_SAMP",
+	"SUBSTRING", "SUM", "TAN", "TANH", "THEN", "TIME", "TIMESTAMP", "TO", "TOTALORDER", "TRIM",
+	"TRUNC", "UNICODE_CHAR", "UNICODE_VAL", "UNION", "UPPER", "USING", "UUID_TO_CHAR",
+	"VALUES", "VARBINARY", "VARCHAR", "VARYING", "VAR_POP", "VAR_SAMP", "WHEN", "WHERE",
+	"WINDOW", "WITH"
+};
+
+static int compareQueryWords( const void *word, const void *entry )
+{
+	return strcmp( (const char*)word, *(const char* const*)entry );
+}
+
+//
+// The name before a parenthesis is that of a procedure or function of
+// the database: quoted, in a package, or no keyword or built-in function.
+//
+static bool isRoutineName( const char *sqlString, const SqlToken &name, const SqlToken &before )
+{
+	if ( name.kind == '"' )
+		return true;
+
+	if ( name.kind != 'w' )
+		return false;
+
+	if ( before.kind == '.' )
+		return true;
+
+	char word[32];
+	size_t length = name.end - name.begin;
+
+	if ( length >= sizeof( word ) )
+		return true;
+
+	for ( size_t n = 0; n < length; ++n )
+		word[n] = (char)toupper( (unsigned char)sqlString[name.begin + n] );
+	word[length] = 0;
+
+	return !bsearch( word, queryWords, sizeof( queryWords ) / sizeof( *queryWords ), sizeof( *queryWords ), compareQueryWords );
+}
+
+//
+// A SELECT runs in the read-only transaction unless it writes something:
+// a generator, a lock, or whatever a procedure or function it calls does.
+// A selectable procedure without parameters reads like a table; one that
+// writes before its first row is retried by execute().
+//
+bool IscStatement::isReadOnlyQuery(const char * sqlString)
+{
+	IscSqlLexer lexer( sqlString );
+	SqlToken token;
+	SqlToken previous = {};
+	SqlToken beforePrevious = {};
+	bool next = false;
+	bool with = false;
+
+	while ( lexer.nextSignificant( token ) )
+	{
+		if ( lexer.isWord( token, "GEN_ID" ) || ( next && lexer.isWord( token, "VALUE" ) )
+			|| ( with && lexer.isWord( token, "LOCK" ) ) )
+			return false;
+
+		if ( token.kind == '(' && isRoutineName( sqlString, previous, beforePrevious ) )
+			return false;
+
+		next = lexer.isWord( token, "NEXT" );
+		with = lexer.isWord( token, "WITH" );
+		beforePrevious = previous;
+		previous = token;
+	}
+
+	return true;
+}
+
+bool IscStatement::executeDirect()
+{
+	// statements kept by the cache would hold the objects the DDL changes
+	if ( isActiveDDL() )
+	{
+		connection->statementCache->clear();
+		connection->nativeSqlCache->clear();
+	}
+
+	// no handle to keep a timeout, the driver keeps it
+	serverTimeout = false;
+
+	if ( openCursor )
+		return openDirectCursor();
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		IscExecution execution( this );
+		ITransaction* transHandle = startTransaction();
+
+		connection->databaseHandle->execute( &status, transHandle, 0, sql,
+		                                     connection->getDatabaseDialect(),
+		                                     NULL, NULL, NULL, NULL );
+	}
+	catch( const FbException& error )
+	{
+		if ( connection->transactionInfo.autoCommit )
+			connection->rollbackAuto();
+		throwExecuteError( error.getStatus() );
+	}
+
+	resultsCount		= 1;
+	resultsSequence		= 0;
+	summaryUpdateCount	= isActiveModify() ? 1 : 0;
+
+	if ( transactionLocal )
+	{
+		if ( transactionInfo.autoCommit )
+			commitLocal();
+	}
+	else if ( connection->transactionInfo.autoCommit )
+		connection->commitAuto();
+
+	return false;
+}
+
+//
+// Opens the cursor of a SELECT taken by prepareDirect and describes the
+// columns from it, as execute() does for a prepared one.
+//
+bool IscStatement::openDirectCursor()
+{
+	if ( readAhead )
+	{
+		delete readAhead;
+		readAhead = NULL;
+	}
+
+	// a SELECT in autocommit mode reads in the read-only transaction
+	queryTransaction = readOnlyQuery && !transactionLocal && !transactionStatusChange
+		&& connection->useQueryTransaction();
+	scrollableCursorOpen = false;
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		IscExecution execution( this );
+		ITransaction* transHandle = startTransaction();
+
+		fbResultSet = connection->databaseHandle->openCursor( &status, transHandle, 0, sql,
+		                                                      connection->getDatabaseDialect(),
+		                                                      NULL, NULL, NULL, NULL, 0 );
+		outputSqlda.allocBuffer( this, fbResultSet->getMetadata( &status ) );
+	}
+	catch( const FbException& error )
+	{
+		// the query writes after all, through a routine isReadOnlyQuery
+		// could not tell from a table: it keeps the normal transaction
+		if ( queryTransaction && hasError( error.getStatus(), isc_read_only_trans ) )
+		{
+			status.clearException();
+			closeFbResultSet();
+			readOnlyQuery = false;
+			return openDirectCursor();
+		}
+
+		if ( connection->transactionInfo.autoCommit )
+			connection->rollbackAuto();
+		closeFbResultSet();
+		throwExecuteError( error.getStatus() );
+	}
+
+	resultsCount		= 1;
+	resultsSequence		= 0;
+	summaryUpdateCount	= 0;
+	numberColumns		= outputSqlda.getColumnCount();
+	typeStmt			= stmtSelect;
+
+	if ( readAheadRows > 0 )
+	{
+		readAhead = new IscReadAhead( this, readAheadRows );
+		readAhead->start();
+	}
+
+	return numberColumns > 0;
+}
+
 bool IscStatement::executeProcedure()
 {
+	applyQueryTimeout();
+
 	ThrowStatusWrapper status( connection->GDS->_status );
 	try
 	{
+		IscExecution execution( this );
+
 		// Make sure there is a transaction
 		ITransaction* transHandle = startTransaction();
 
@@ -751,12 +1310,13 @@ bool IscStatement::executeProcedure()
 	{
 		if ( connection->transactionInfo.autoCommit )
 			connection->rollbackAuto();
-		THROW_ISC_EXCEPTION ( connection, error.getStatus() );
+		throwExecuteError( error.getStatus() );
 	}
 
 	resultsCount		= 1;
 	resultsSequence		= 0;
-	getUpdateCounts();
+	summaryUpdateCount	= 0;
+	updateCountPending	= true;
 
 	return outputSqlda.getColumnCount() > 0;
 }
@@ -783,6 +1343,8 @@ int IscStatement::getUpdateCounts()
 	char buffer [128];
 	CFbDll * GDS = connection->GDS;
 
+	updateCountPending = false;
+
 	ThrowStatusWrapper status( GDS->_status );
 	try
 	{
@@ -988,10 +1550,389 @@ void IscStatement::clearSelect()
 	}
 }
 
+//
+// Starts collecting parameter sets to be sent with IBatch, which needs
+// Firebird 4 on both the client and the server, or else several at a
+// time in an EXECUTE BLOCK, which can also be asked for. Returns false when the statement has to be
+// executed once per parameter set instead.
+//
+bool IscStatement::beginBatch()
+{
+	cancelBatch();
+	batchCounts.clear();
+	summaryUpdateCount = 0;
+	updateCountPending = false;
+
+	if ( !statementHandle )
+		return false;
+
+	batchBlobs = false;
+
+	for ( auto &var : inputSqlda.sqlvar )
+	{
+		if ( var.sqltype == SQL_ARRAY )
+			return false;
+		if ( var.sqltype == SQL_BLOB )
+			batchBlobs = true;
+	}
+
+	if ( connection->attachment->majorFb < 4 || executeBlockBatch )
+		return beginExecuteBlock();
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		createBatch( status, inputSqlda.meta );
+	}
+	catch( const FbException& )
+	{
+		// a Firebird 3 client library has no IBatch
+		status.clearException();
+		cancelBatch();
+		return beginExecuteBlock();
+	}
+
+	return true;
+}
+
+bool IscStatement::beginExecuteBlock()
+{
+	if ( !isActiveModify() || outputSqlda.getColumnCount() > 0 )
+		return false;
+
+	if ( !executeBlock )
+		executeBlock = new IscExecuteBlock( this );
+
+	return executeBlock->open();
+}
+
+void IscStatement::createBatch(ThrowStatusWrapper &status, IMessageMetadata *meta)
+{
+	IXpbBuilder *parameters = connection->GDS->_master->getUtilInterface()->getXpbBuilder( &status, IXpbBuilder::BATCH, NULL, 0 );
+
+	try
+	{
+		parameters->insertInt( &status, IBatch::TAG_RECORD_COUNTS, 1 );
+		if ( batchBlobs )
+			parameters->insertInt( &status, IBatch::TAG_BLOB_POLICY, IBatch::BLOB_ID_USER );
+
+		batch = statementHandle->createBatch( &status, meta,
+		                                      parameters->getBufferLength( &status ), parameters->getBuffer( &status ) );
+	}
+	catch( ... )
+	{
+		parameters->dispose();
+		throw;
+	}
+
+	parameters->dispose();
+
+	meta->addRef();
+	batchMeta = meta;
+	batchRows = 0;
+	batchBytes = 0;
+}
+
+//
+// Adds the parameter set in inputSqlda to the batch. The conversion kept
+// the BLOB parameters of the set in batchBlobData under user ids; they go
+// in the batch buffer with the message, so a set costs no round trip of
+// its own. The batch is sent first when the set would not fit in it.
+//
+void IscStatement::addBatch()
+{
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		inputSqlda.checkAndRebuild();
+		auto* _imeta = inputSqlda.useExecBufferMeta ? inputSqlda.execMeta   : inputSqlda.meta;
+		auto& _ibuf  = inputSqlda.useExecBufferMeta ? inputSqlda.execBuffer : inputSqlda.buffer;
+
+		if ( !batch )
+		{
+			executeBlock->add( _imeta, _ibuf.data() );
+			return;
+		}
+
+		// bindings changed the message layout, the sets added so far go first
+		if ( _imeta != batchMeta )
+		{
+			sendBatch( status );
+			batchMeta->release();
+			batchMeta = NULL;
+			batch->close( &status );
+			batch = NULL;
+			createBatch( status, _imeta );
+		}
+
+		size_t rowBytes = _ibuf.size();
+
+		for ( auto &blob : batchBlobData )
+			if ( blob.data.size() <= BATCH_BLOB_INLINE_BYTES )
+				rowBytes += blob.data.size() + 32;	// with the header and the alignment
+
+		if ( batchBytes + rowBytes > BATCH_BUFFER_BYTES )
+			sendBatch( status );
+
+		addBatchBlobs( status );
+		batch->add( &status, 1, _ibuf.data() );
+
+		++batchRows;
+		batchBytes += rowBytes;
+	}
+	catch( const FbException& error )
+	{
+		cancelBatch();
+		if ( connection->transactionInfo.autoCommit )
+			connection->rollbackAuto();
+		throwExecuteError( error.getStatus() );
+	}
+	catch( const SQLError& )
+	{
+		// the sets executed before the failing one stay, as row by row
+		cancelBatch();
+		commitAutoModify();
+		throw;
+	}
+}
+
+//
+// Executes the parameter sets added since the last call. Execution stops
+// at the first set that fails, which is thrown as the error.
+//
+void IscStatement::sendBatch(ThrowStatusWrapper &status)
+{
+	if ( !batch && !executeBlock )
+		return;
+
+	if ( batch && !batchRows )
+		return;
+
+	// the timeout of the handle is not known to reach the batch
+	serverTimeout = false;
+	batchBytes = 0;
+
+	if ( !batch )
+	{
+		IscExecution execution( this );
+		executeBlock->send();
+		return;
+	}
+
+	batchRows = 0;
+
+	IBatchCompletionState *state;
+	{
+		IscExecution execution( this );
+		state = batch->execute( &status, startTransaction() );
+	}
+	IStatus *error = NULL;
+
+	try
+	{
+		unsigned size = state->getSize( &status );
+		unsigned failed = size;
+
+		for ( unsigned n = 0; n < size; ++n )
+		{
+			int count = state->getState( &status, n );
+
+			if ( count == IBatchCompletionState::EXECUTE_FAILED )
+			{
+				if ( failed == size )
+					failed = n;
+				batchCounts.push_back( -1 );
+			}
+			else
+			{
+				count = MAX( count, 0 );
+				batchCounts.push_back( count );
+				summaryUpdateCount += count;
+			}
+		}
+
+		if ( failed < size )
+		{
+			error = connection->GDS->_master->getStatus();
+			state->getStatus( &status, error, failed );
+		}
+	}
+	catch( ... )
+	{
+		if ( error )
+			error->dispose();
+		state->dispose();
+		throw;
+	}
+
+	state->dispose();
+
+	if ( error )
+	{
+		JString text = connection->getIscStatusText( error );
+		const ISC_STATUS *statusVector = error->getErrors();
+		int sqlCode = connection->GDS->getSqlCode( statusVector );
+		ISC_STATUS fbCode = statusVector[1];
+		error->dispose();
+		throw SQLEXCEPTION ( sqlCode, fbCode, text );
+	}
+}
+
+void IscStatement::executeBatch()
+{
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		sendBatch( status );
+	}
+	catch( const FbException& error )
+	{
+		cancelBatch();
+		if ( connection->transactionInfo.autoCommit )
+			connection->rollbackAuto();
+		throwExecuteError( error.getStatus() );
+	}
+	catch( const SQLError& )
+	{
+		cancelBatch();
+		commitAutoModify();
+		throw;
+	}
+
+	cancelBatch();
+	commitAutoModify();
+}
+
+void IscStatement::commitAutoModify()
+{
+	if ( transactionLocal )
+	{
+		if ( transactionInfo.autoCommit )
+			commitLocal();
+	}
+	else if ( connection->transactionInfo.autoCommit )
+		connection->commitAuto();
+}
+
+void IscStatement::cancelBatch()
+{
+	if ( batchMeta )
+	{
+		batchMeta->release();
+		batchMeta = NULL;
+	}
+
+	if ( batch )
+	{
+		if ( connection )
+		{
+			ThrowStatusWrapper status( connection->GDS->_status );
+			try
+			{
+				batch->close( &status );
+				batch = NULL;
+			}
+			catch( const FbException& )
+			{
+				status.clearException();
+			}
+		}
+
+		if ( batch )
+		{
+			batch->release();
+			batch = NULL;
+		}
+	}
+
+	if ( executeBlock )
+		executeBlock->cancel();
+
+	batchRows = 0;
+	batchBytes = 0;
+	batchBlobData.clear();
+}
+
+//
+// Starts a BLOB parameter of the set being converted: its contents are
+// kept until addBatch and the parameter gets a user id of the batch.
+//
+void IscStatement::addBatchBlob(char * sqldata)
+{
+	IscBatchBlob blob;
+
+	blob.id.gds_quad_high = 1;
+	blob.id.gds_quad_low = ++batchBlobIds;
+	batchBlobData.push_back( blob );
+
+	memcpy( sqldata, &blob.id, sizeof(blob.id) );
+}
+
+void IscStatement::appendBatchBlob(const char * data, int length)
+{
+	std::vector<char> &blobData = batchBlobData.back().data;
+	blobData.insert( blobData.end(), data, data + length );
+}
+
+//
+// Puts the BLOB parameters of the set in the batch. One too large for the
+// batch buffer is written to the server on its own and registered under
+// its user id.
+//
+void IscStatement::addBatchBlobs(ThrowStatusWrapper &status)
+{
+	for ( auto &blob : batchBlobData )
+	{
+		if ( blob.data.size() <= BATCH_BLOB_INLINE_BYTES )
+		{
+			batch->addBlob( &status, (unsigned)blob.data.size(), blob.data.data(), &blob.id, 0, NULL );
+			continue;
+		}
+
+		ISC_QUAD blobId;
+		IBlob *blobHandle = connection->databaseHandle->createBlob( &status, startTransaction(), &blobId, 0, NULL );
+
+		try
+		{
+			const char *data = blob.data.data();
+
+			for ( size_t length = blob.data.size(), post; length; data += post, length -= post )
+			{
+				post = MIN( length, (size_t)DEFAULT_BLOB_BUFFER_LENGTH );
+				blobHandle->putSegment( &status, (unsigned)post, data );
+			}
+
+			blobHandle->close( &status );
+		}
+		catch( ... )
+		{
+			blobHandle->release();
+			throw;
+		}
+
+		batch->registerBlob( &status, &blobId, &blob.id );
+	}
+
+	batchBlobData.clear();
+}
+
 void IscStatement::freeStatementHandle()
 {
+	// the blocks were built from the statement text
+	delete executeBlock;
+	executeBlock = NULL;
+	direct = false;
+	updateCountPending = false;
+	queryTransaction = false;
+
 	if ( connection && statementHandle )
 	{
+		if ( cacheStatementHandle() )
+		{
+			statementHandle = nullptr;
+			return;
+		}
+
 		ThrowStatusWrapper status( connection->GDS->_status );
 		try {
 			statementHandle->free( &status );
@@ -1006,8 +1947,58 @@ void IscStatement::freeStatementHandle()
 	}
 }
 
+//
+// Hands the statement over to the cache of the connection for the next
+// prepare of the same text, unless it is in a state it cannot be reused
+// from. Returns false when the caller has to free it.
+//
+bool IscStatement::cacheStatementHandle()
+{
+	if ( !connection->statementCache->isEnabled() || fbResultSet || readAhead || batch || cursorNamed
+		|| !inputSqlda.meta || !outputSqlda.meta )
+		return false;
+
+	switch ( preparedType )
+	{
+	case isc_info_sql_stmt_select:
+	case isc_info_sql_stmt_select_for_upd:
+	case isc_info_sql_stmt_insert:
+	case isc_info_sql_stmt_update:
+	case isc_info_sql_stmt_delete:
+	case isc_info_sql_stmt_exec_procedure:
+		break;
+
+	default:
+		return false;
+	}
+
+	IscStatementCache::Entry entry;
+	entry.statement = statementHandle;
+	entry.input = inputSqlda.meta;
+	entry.output = outputSqlda.meta;
+	entry.openCursor = openCursor;
+	entry.statementType = preparedType;
+
+	entry.input->addRef();
+	entry.output->addRef();
+
+	if ( connection->statementCache->give( sql, connection->getDatabaseDialect(), entry ) )
+		return true;
+
+	entry.input->release();
+	entry.output->release();
+
+	return false;
+}
+
 void IscStatement::closeFbResultSet()
 {
+	if( readAhead ) {
+		// the worker must be idle before the cursor goes away
+		delete readAhead;
+		readAhead = NULL;
+	}
+
 	if( !fbResultSet ) return;
 
 	ThrowStatusWrapper status( connection->GDS->_status );
@@ -25,14 +25,31 @@
 #if !defined(_ISCSTATEMENT_H_)
 #define _ISCSTATEMENT_H_
 
+#include <atomic>
 #include "Connection.h"
 #include "LinkedList.h"
 #include "Sqlda.h"
+#include "IscQueryTimer.h"
 
 namespace IscDbcLibrary {
 
 class IscConnection;
 class IscResultSet;
+class IscReadAhead;
+class IscExecuteBlock;
+
+#define BATCH_BUFFER_BYTES		( 8 * 1024 * 1024 )	// parameter messages and BLOBs sent per IBatch::execute
+#define BATCH_BLOB_INLINE_BYTES	( 1024 * 1024 )		// larger BLOB parameters are written to the server on their own
+
+//
+// A BLOB parameter of the set being converted, kept until addBatch puts
+// it in the batch under its user id.
+//
+struct IscBatchBlob
+{
+	ISC_QUAD			id;
+	std::vector<char>	data;
+};
 
 class IscStatement : public Statement  
 {
@@ -50,6 +67,11 @@ public:
 						};
 
 	void freeStatementHandle();
+	bool cacheStatementHandle();
+	void createBatch(Firebird::ThrowStatusWrapper &status, Firebird::IMessageMetadata *meta);
+	void sendBatch(Firebird::ThrowStatusWrapper &status);
+	bool beginExecuteBlock();
+	void commitAutoModify();
 	void closeFbResultSet();
 	void clearSelect();
 	void rollbackLocal();
@@ -65,6 +87,10 @@ public:
 	void clearResults();
 	virtual bool execute();
 	virtual bool executeProcedure();
+	bool prepareDirect(const char * sqlString, bool selectCursor);
+	static bool isReadOnlyQuery(const char * sqlString);
+	bool executeDirect();
+	bool openDirectCursor();
 	virtual void prepareStatement (const char *sqlString);
 	void deleteResultSet (IscResultSet *resultSet);
 	IscStatement(IscConnection *connect);
@@ -79,12 +105,34 @@ public:
 	virtual int	getMaxFieldSize();
 	virtual int	getMaxRows();
 	virtual int	getQueryTimeout();
-	virtual void cancel();
+	virtual bool cancel();
 	virtual bool execute (const char *sqlString);
 	virtual void close();
 	virtual void setMaxFieldSize(int max);
 	virtual void setMaxRows(int max);
 	virtual void setQueryTimeout(int seconds);
+	void cancelOperation( int option );
+	void endExecution();
+	void applyQueryTimeout();
+	void throwExecuteError(Firebird::IStatus *status);
+	void setReadAheadRows(int rows) { readAheadRows = rows; }
+	void setScrollableCursor(bool scrollable) { scrollableCursor = scrollable; }
+	bool isScrollableCursor() { return fbResultSet && scrollableCursorOpen; }
+	void setStaticCursorMemory(int megabytes) { staticCursorMemory = megabytes; }
+	void setBlobCacheMemory(int megabytes) { blobCacheMemory = megabytes; }
+	void setKeysetCursor(bool keyset) { keysetCursor = keyset; }
+	void setExecuteBlockBatch(bool block) { executeBlockBatch = block; }
+	bool beginBatch();
+	void addBatch();
+	void executeBatch();
+	void cancelBatch();
+	bool isBatchingBlobs() { return batch && batchBlobs; }
+	void addBatchBlob(char * sqldata);
+	void appendBatchBlob(const char * data, int length);
+	void addBatchBlobs(Firebird::ThrowStatusWrapper &status);
+	int getBatchRows() { return (int)batchCounts.size(); }
+	int getBatchUpdateCount(int row) { return batchCounts[row]; }
+	bool isKeysetCursor() { return outputSqlda.keysetCursor != NULL; }
 
 	virtual int release();
 	virtual void addRef();
@@ -98,11 +146,14 @@ public:
 	virtual ~IscStatement();
 
 	virtual int getStmtPlan(const void * value, int bufferLength,int *lengthPtr)
-	{ return getPlanStatement(connection, statementHandle,value,bufferLength,lengthPtr); }  
+	{ if ( direct ) return -1;
+	  return getPlanStatement(connection, statementHandle,value,bufferLength,lengthPtr); }  
 	virtual int			getStmtType(const void * value, int bufferLength,int *lengthPtr)
-	{ return getTypeStatement(connection, statementHandle,value,bufferLength,lengthPtr); }  
+	{ if ( direct ) { *lengthPtr = preparedType; return 0; }
+	  return getTypeStatement(connection, statementHandle,value,bufferLength,lengthPtr); }  
 	virtual int			getStmtInfoCountRecords(const void * value, int bufferLength,int *lengthPtr)
-	{ return getInfoCountRecordsStatement(connection, statementHandle, value,bufferLength,lengthPtr); }  
+	{ if ( direct ) { *lengthPtr = summaryUpdateCount; return 0; }
+	  return getInfoCountRecordsStatement(connection, statementHandle, value,bufferLength,lengthPtr); }  
 	virtual bool		isActiveLocalTransaction(){ return transactionLocal; }
 	virtual void		setActiveLocalParamTransaction();
 	virtual void		delActiveLocalParamTransaction();
@@ -120,6 +171,29 @@ public:
 	Firebird::IStatement* statementHandle;
 	InfoTransaction	transactionInfo;
 	Firebird::IResultSet* fbResultSet;
+	IscReadAhead	*readAhead;
+	int				readAheadRows;
+	bool			scrollableCursor;		// ask for a server-side scrollable cursor
+	bool			scrollableCursorOpen;	// the server granted it
+	int				staticCursorMemory;		// megabytes kept in memory by the static cursor, 0 - all
+	int				blobCacheMemory;		// megabytes of BLOB contents cached by the static cursor
+	bool			keysetCursor;			// ask for a keyset-driven cursor in place of the static one
+	Firebird::IBatch			*batch;
+	Firebird::IMessageMetadata	*batchMeta;		// message layout the batch was created for
+	bool			batchBlobs;				// parameters include BLOBs, sent in the batch with the sets
+	unsigned		batchRows;				// parameter sets added since the last execute
+	size_t			batchBytes;				// of the sets and BLOBs added since the last execute
+	std::vector<IscBatchBlob> batchBlobData;	// BLOB parameters of the set being converted
+	ISC_ULONG		batchBlobIds;			// last user id given to a BLOB parameter
+	std::vector<int> batchCounts;			// update count of every parameter set executed, -1 - failed
+	IscExecuteBlock	*executeBlock;			// batches the parameter sets where IBatch is not available
+	bool			executeBlockBatch;		// use EXECUTE BLOCK even where IBatch is available
+	int				streamBlobs;			// BLOB parameters being streamed in its transaction
+	int				preparedType;			// isc_info_sql_stmt_* reported by the prepare
+	bool			cursorNamed;			// the handle carries a cursor name, not for the statement cache
+	bool			direct;					// no handle, the text runs through IAttachment::execute or openCursor
+	bool			readOnlyQuery;			// a SELECT that writes nothing, not even through BLOB parameters
+	bool			queryTransaction;		// executed in the read-only transaction of the connection
 	bool			transactionLocal;
 	bool			transactionStatusChange;
 	bool			transactionStatusChangingToLocal;
@@ -128,8 +202,16 @@ public:
 	Sqlda			outputSqlda;
 
 	int				summaryUpdateCount;
+	bool			updateCountPending;		// executed, the count not yet read from the server
 	int				typeStmt;
 	bool			openCursor;
+
+	int				queryTimeout;			// seconds, 0 - none
+	bool			serverTimeout;			// the server keeps the timeout of the handle
+	std::atomic<bool> executing;			// a call to the server is running, it may be cancelled
+	std::atomic<bool> timedOut;				// the timer cancelled the execution
+	bool			cancelSent;				// during the call running, guarded by connection->cancelMutex
+	IscQueryTimer::Clock::time_point timerDeadline;
 };
 
 }; // end namespace IscDbcLibrary
@@ -0,0 +1,202 @@
+// IscStatementCache.cpp: implementation of the IscStatementCache class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "IscDbc.h"
+#include "IscStatementCache.h"
+#include "IscConnection.h"
+#include "SQLError.h"
+
+using namespace Firebird;
+
+namespace IscDbcLibrary {
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+IscStatementCache::IscStatementCache( IscConnection *connect )
+{
+	connection = connect;
+	maxCount = 0;
+	maxMemory = (size_t)DEFAULT_STATEMENT_CACHE_MEMORY * 1024 * 1024;
+	memory = 0;
+	hits = 0;
+	misses = 0;
+}
+
+IscStatementCache::~IscStatementCache()
+{
+	clear();
+}
+
+void IscStatementCache::setLimits( int count, int megabytes )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	maxCount = MAX( count, 0 );
+	maxMemory = (size_t)MAX( megabytes, 0 ) * 1024 * 1024;
+	evict();
+}
+
+void IscStatementCache::makeKey( const char *sql, int dialect, std::string &key )
+{
+	key.assign( sql );
+	key += '\0';
+	key += (char)( '0' + dialect );
+}
+
+//
+// Hands over the statement prepared for the text, if there is one. The
+// caller owns it and its metadata from then on.
+//
+bool IscStatementCache::take( const char *sql, int dialect, Entry &entry )
+{
+	if ( !isEnabled() )
+		return false;
+
+	std::string key;
+	makeKey( sql, dialect, key );
+
+	std::lock_guard<std::mutex> guard( mutex );
+	auto it = index.find( key );
+
+	if ( it == index.end() )
+	{
+		++misses;
+		return false;
+	}
+
+	++hits;
+	entry = it->second->entry;
+	memory -= it->second->memory;
+	items.erase( it->second );
+	index.erase( it );
+
+	return true;
+}
+
+//
+// Whether a statement prepared for the text is kept, without taking it.
+//
+bool IscStatementCache::contains( const char *sql, int dialect )
+{
+	if ( !isEnabled() )
+		return false;
+
+	std::string key;
+	makeKey( sql, dialect, key );
+
+	std::lock_guard<std::mutex> guard( mutex );
+
+	return index.find( key ) != index.end();
+}
+
+//
+// Keeps a statement that is no longer in use. Returns false when it is
+// not kept, the caller frees it then.
+//
+bool IscStatementCache::give( const char *sql, int dialect, const Entry &entry )
+{
+	if ( !isEnabled() )
+		return false;
+
+	Item item;
+	makeKey( sql, dialect, item.key );
+	item.entry = entry;
+	item.memory = sizeof( Item ) + item.key.size() * 2;
+
+	ThrowStatusWrapper status( connection->GDS->_status );
+	try
+	{
+		if ( entry.input )
+			item.memory += entry.input->getMessageLength( &status );
+		if ( entry.output )
+			item.memory += entry.output->getMessageLength( &status );
+	}
+	catch( const FbException& )
+	{
+		status.clearException();
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard( mutex );
+
+	// another statement with the same text is already kept
+	if ( item.memory > maxMemory || index.find( item.key ) != index.end() )
+		return false;
+
+	items.push_front( item );
+	index[items.front().key] = items.begin();
+	memory += item.memory;
+	evict();
+
+	return true;
+}
+
+void IscStatementCache::evict()
+{
+	while ( !items.empty() && ( (int)items.size() > maxCount || memory > maxMemory ) )
+	{
+		Item &item = items.back();
+		memory -= item.memory;
+		index.erase( item.key );
+		release( item );
+		items.pop_back();
+	}
+}
+
+void IscStatementCache::release( Item &item )
+{
+	Entry &entry = item.entry;
+
+	if ( entry.input )
+		entry.input->release();
+	if ( entry.output )
+		entry.output->release();
+
+	// once the connection is gone only the interface is left to release
+	if ( connection->attachment )
+	{
+		ThrowStatusWrapper status( connection->GDS->_status );
+		try
+		{
+			entry.statement->free( &status );
+			return;
+		}
+		catch( const FbException& )
+		{
+			status.clearException();
+		}
+	}
+
+	entry.statement->release();
+}
+
+//
+// Frees every statement kept: they hold the metadata of the objects they
+// use, which DDL must be able to change.
+//
+void IscStatementCache::clear()
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	for ( Item &item : items )
+		release( item );
+
+	items.clear();
+	index.clear();
+	memory = 0;
+}
+
+void IscStatementCache::getStatistics( int &hitCount, int &missCount, int &entries )
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	hitCount = hits;
+	missCount = misses;
+	entries = (int)items.size();
+}
+
+}; // end namespace IscDbcLibrary
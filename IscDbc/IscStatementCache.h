@@ -0,0 +1,75 @@
+// IscStatementCache.h: interface for the IscStatementCache class.
+//
+//	Prepared statements of a connection that are no longer in use, kept
+//	by their native SQL text and dialect so that preparing the same text
+//	again takes the statement and its metadata instead of a round trip
+//	to the server. The least recently used are freed first once the
+//	count or the memory limit is reached.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(_ISCSTATEMENTCACHE_H_)
+#define _ISCSTATEMENTCACHE_H_
+
+#include <string>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace IscDbcLibrary {
+
+class IscConnection;
+
+#define DEFAULT_STATEMENT_CACHE_MEMORY	4	// megabytes
+
+class IscStatementCache
+{
+public:
+	struct Entry
+	{
+		Firebird::IStatement		*statement;
+		Firebird::IMessageMetadata	*input;
+		Firebird::IMessageMetadata	*output;
+		bool						openCursor;
+		int							statementType;	// isc_info_sql_stmt_*
+	};
+
+	IscStatementCache( IscConnection *connect );
+	~IscStatementCache();
+
+	void	setLimits( int count, int megabytes );
+	bool	isEnabled() { return maxCount > 0; }
+	bool	take( const char *sql, int dialect, Entry &entry );
+	bool	contains( const char *sql, int dialect );
+	bool	give( const char *sql, int dialect, const Entry &entry );
+	void	clear();
+	void	getStatistics( int &hitCount, int &missCount, int &entries );
+
+private:
+	struct Item
+	{
+		std::string	key;
+		Entry		entry;
+		size_t		memory;
+	};
+
+	typedef std::list<Item> ListItems;
+
+	void	makeKey( const char *sql, int dialect, std::string &key );
+	void	release( Item &item );
+	void	evict();
+
+	IscConnection		*connection;
+	std::mutex			mutex;
+	ListItems			items;				// most recently used first
+	std::unordered_map<std::string, ListItems::iterator> index;
+	int					maxCount;
+	size_t				maxMemory;
+	size_t				memory;
+	int					hits;
+	int					misses;
+};
+
+}; // end namespace IscDbcLibrary
+
+#endif // !defined(_ISCSTATEMENTCACHE_H_)
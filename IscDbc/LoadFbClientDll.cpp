@@ -3,16 +3,108 @@
 #include <dlfcn.h>
 #include <stdio.h>
 #endif
+#include <string>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <atomic>
 
 using namespace Firebird;
 
 namespace IscDbcLibrary {
 
+//
+// A client library is loaded once for the process and kept by the path
+// it was found at. Every attachment and service connection that names it
+// shares its entry points, master and provider, and only gets statuses
+// of its own; the last one to let it go unloads it. The registry is never
+// destroyed, it may still be used by the destructors of other globals.
+//
+struct LibraryRegistry
+{
+	std::mutex						mutex;
+	std::map<std::string, CFbDll*>	libraries;
+	int								loads = 0;	// of a library not loaded at the time
+};
+
+static LibraryRegistry& libraryRegistry()
+{
+	static LibraryRegistry *registry = new LibraryRegistry;
+	return *registry;
+}
+
+static std::atomic<unsigned long long> lastStatusSerial{0};
+
+// the status the thread used last, and the holder it came from
+static thread_local unsigned long long cachedStatusSerial = 0;
+static thread_local IStatus *cachedStatus = nullptr;
+
+ThreadStatus::ThreadStatus()
+{
+	master = nullptr;
+	serial = 0;
+}
+
+ThreadStatus::~ThreadStatus()
+{
+	release();
+}
+
+void ThreadStatus::init( IMaster *masterInterface )
+{
+	release();
+	master = masterInterface;
+	serial = ++lastStatusSerial;
+}
+
+void ThreadStatus::release()
+{
+	std::lock_guard<std::mutex> guard( mutex );
+
+	for ( auto &it : statuses )
+		it.second->dispose();
+
+	statuses.clear();
+	master = nullptr;
+	serial = 0;
+}
+
+//
+// Most calls come from the thread that made the previous one, which finds
+// its status without taking the lock.
+//
+ThreadStatus::operator IStatus*()
+{
+	if ( cachedStatusSerial == serial )
+		return cachedStatus;
+
+	if ( !master )
+		return nullptr;
+
+	IStatus *status;
+
+	{
+		std::lock_guard<std::mutex> guard( mutex );
+		IStatus *&item = statuses[std::this_thread::get_id()];
+
+		if ( !item )
+			item = master->getStatus();
+
+		status = item;
+	}
+
+	cachedStatusSerial = serial;
+	cachedStatus = status;
+
+	return status;
+}
+
 CFbDll::CFbDll() :
 	_isMsAccess{ detectMsAccess() },
+	_library{nullptr},
+	_useCount{0},
 	_master{nullptr},
-	_prov{nullptr},
-	_status{nullptr}
+	_prov{nullptr}
 { 
 	_Handle = NULL;
 }
@@ -24,21 +116,76 @@ CFbDll::~CFbDll()
 
 bool CFbDll::LoadDll (const char * client, const char * clientDef)
 {
+	LibraryRegistry &registry = libraryRegistry();
+	std::lock_guard<std::mutex> guard( registry.mutex );
+	std::map<std::string, CFbDll*> &libraries = registry.libraries;
+
 #ifdef _WINDOWS
-	_Handle = LoadLibraryEx (client, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
-	if ( !_Handle && clientDef )
-		_Handle = LoadLibraryEx (clientDef, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
+	HMODULE handle = LoadLibraryEx (client, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
+	if ( !handle && clientDef )
+		handle = LoadLibraryEx (clientDef, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
 #else
-	_Handle = dlopen (client, RTLD_NOW);
-	if ( !_Handle && clientDef ) {
-		_Handle = dlopen (clientDef, RTLD_NOW);
-		if ( !_Handle )
+	void *handle = dlopen (client, RTLD_NOW);
+	if ( !handle && clientDef ) {
+		handle = dlopen (clientDef, RTLD_NOW);
+		if ( !handle )
 			fputs (dlerror(), stderr);
 	}
 #endif
-	if ( !_Handle )
+	if ( !handle )
 		return false;
 
+	// the path the loader found the library at
+	std::string path;
+#ifdef _WINDOWS
+	char buffer [MAX_PATH];
+	DWORD length = GetModuleFileName (handle, buffer, sizeof (buffer));
+	path.assign (buffer, length);
+	std::transform (path.begin(), path.end(), path.begin(), [](unsigned char c) { return std::toupper(c); });
+#else
+	Dl_info info;
+	void *symbol = dlsym (handle, "fb_get_master_interface");
+	path = symbol && dladdr (symbol, &info) && info.dli_fname ? info.dli_fname : client;
+#endif
+
+	CFbDll *library;
+	auto it = libraries.find (path);
+
+	if ( it != libraries.end() )
+	{
+		// already loaded, the handle opened here only counts a reference
+		library = it->second;
+#ifdef _WINDOWS
+		FreeLibrary (handle);
+#else
+		dlclose (handle);
+#endif
+	}
+	else
+	{
+		library = new CFbDll;
+		library->_Handle = handle;
+
+		if ( !library->LoadEntryPoints() )
+		{
+			delete library;
+			return false;
+		}
+
+		libraries[path] = library;
+		++registry.loads;
+	}
+
+	++library->_useCount;
+	*this = *library;
+	_library = library;
+	_status.init( _master );
+
+	return true;
+}
+
+bool CFbDll::LoadEntryPoints (void)
+{
 	_CFbDllVersion = 12;
 
 #ifdef _WINDOWS
@@ -115,18 +262,64 @@ bool CFbDll::LoadDll (const char * client, const char * clientDef)
 	__ENTRYPOINT_OOAPI(get_transaction_handle);
 	__ENTRYPOINT_OOAPI(get_database_handle);
 
+	if ( !_get_master_interface )
+		return false;
+
 	_master = _get_master_interface();
 	_prov   = _master->getDispatcher();
-	_status = _master->getStatus();
 
 	return true;
 }
 
+//
+// The libraries loaded by the process so far, and the connections sharing
+// the one this connection uses.
+//
+void CFbDll::getStatistics( int &loads, int &users )
+{
+	LibraryRegistry &registry = libraryRegistry();
+	std::lock_guard<std::mutex> guard( registry.mutex );
+
+	loads = registry.loads;
+	users = _library ? _library->_useCount : 0;
+}
+
 void CFbDll::Release(void)
+{
+	_status.release();
+
+	if ( _library )
+	{
+		LibraryRegistry &registry = libraryRegistry();
+		std::lock_guard<std::mutex> guard( registry.mutex );
+		std::map<std::string, CFbDll*> &libraries = registry.libraries;
+
+		if ( !--_library->_useCount )
+		{
+			for ( auto it = libraries.begin(); it != libraries.end(); ++it )
+				if ( it->second == _library )
+				{
+					libraries.erase (it);
+					break;
+				}
+
+			delete _library;
+		}
+
+		_library = nullptr;
+		_prov = nullptr;
+		_master = nullptr;
+		_Handle = NULL;
+		return;
+	}
+
+	Unload();
+}
+
+void CFbDll::Unload(void)
 {
 	if( _prov ) {
 
-		CheckStatusWrapper status( _status );
 		try {
 			//TODO: for some reasons this code doesnt't work properly
 			//_prov->shutdown( &status, 0, fb_shutrsn_app_stopped );
@@ -138,11 +331,6 @@ void CFbDll::Release(void)
 		_prov = nullptr;
 	}
 
-	if( _status ) {
-		_status->dispose();
-		_status = nullptr;
-	}
-
 	_master = nullptr;
 
 //  Do not remove the comment!!!
@@ -8,6 +8,9 @@
 
 #include <filesystem>
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace IscDbcLibrary {
 
@@ -315,6 +318,33 @@ typedef Firebird::IMaster* ISC_EXPORT get_master_interface();
 typedef ISC_STATUS ISC_EXPORT get_transaction_handle(ISC_STATUS* userStatus, isc_tr_handle* handle, void* obj);
 typedef ISC_STATUS ISC_EXPORT get_database_handle(ISC_STATUS* userStatus, isc_db_handle* handle, void* obj);
 
+//
+// The status the calls through a client library report to. Every thread
+// gets one of its own, so that the statements of a connection may be used
+// from several threads at a time without one overwriting the errors of
+// another. They are disposed of with the reference to the library.
+//
+class ThreadStatus
+{
+public:
+	ThreadStatus();
+	ThreadStatus( const ThreadStatus& ) : ThreadStatus() {}
+	~ThreadStatus();
+
+	// a copy of the library does not share the statuses of the original
+	ThreadStatus& operator =( const ThreadStatus& ) { return *this; }
+
+	void init( Firebird::IMaster *master );
+	void release();
+	operator Firebird::IStatus*();
+
+private:
+	Firebird::IMaster*	master;
+	unsigned long long	serial;		// tells apart the holders a thread remembers its status of
+	std::mutex			mutex;
+	std::map<std::thread::id, Firebird::IStatus*> statuses;
+};
+
 class CFbDll
 {
 private:
@@ -364,6 +394,16 @@ public:
 
 	bool LoadDll(const char * client, const char * clientDef);
 	void Release(void);
+	void getStatistics( int &loads, int &users );
+
+private:
+	bool LoadEntryPoints(void);
+	void Unload(void);
+
+	CFbDll		*_library;		// the one loaded for the process this one shares
+	int			_useCount;
+
+public:
 
 #ifdef _WINDOWS
 	HMODULE		_Handle;
@@ -442,7 +482,7 @@ public:
 public:
     Firebird::IMaster*		_master;
 	Firebird::IProvider*	_prov;
-	Firebird::IStatus*		_status;
+	ThreadStatus			_status;
 
 	inline classJString::JString getIscStatusText( Firebird::IStatus* status )
 	{
@@ -135,6 +135,16 @@ int getCharsetSize( int charsetCode )
 		return 1;
 	return listCharsets[ charsetCode ].size;
 }
+
+const char* getCharsetName( int charsetCode )
+{
+	if ( charsetCode > 0 ) charsetCode &= 0xff;
+	if ( charsetCode < 0 || charsetCode >= SIZE_OF_LISTCHARSETS )
+		return NULL;
+
+	const char *name = listCharsets[ charsetCode ].name;
+	return strcmp( name, "NEXT" ) ? name : NULL;
+}
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@ enum SqlCode {
 	APPLICATION_ERROR = -12,
 	SECURITY_ERROR = -13,
 	UNSUPPORTED_DATATYPE = -14,
+	QUERY_TIMEOUT = -15,
 	NO_RECORDS_FOR_FETCH = -508 // No current record for fetch operation 335544348L
 	};
 
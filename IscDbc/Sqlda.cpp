@@ -54,6 +54,9 @@
 #include <memory.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
 #include "IscDbc.h"
 #include "Sqlda.h"
 #include "SQLError.h"
@@ -61,6 +64,7 @@
 #include "IscConnection.h"
 #include "IscStatement.h"
 #include "IscBlob.h"
+#include "IscKeysetCursor.h"
 
 using namespace Firebird;
 
@@ -72,125 +76,197 @@ namespace IscDbcLibrary {
 
 static short sqlNull = -1;
 
+#ifdef _WINDOWS
+#define FSEEK64		_fseeki64
+#else
+#define FSEEK64		fseeko
+#endif
+
+//
+// Row store of the static cursor. Rows are kept in blocks; with a memory
+// budget the least recently used blocks are written to a temporary file
+// and read back when one of their rows is needed again. Rows are always
+// copied to and from Sqlda::buffer, so a block can be released whenever
+// it is not the one in use.
+//
+// When the row has VARYING columns each row is stored compact: a null
+// bitmap followed by the non-null columns, VARYING ones with only the
+// bytes in use. Such a block starts with the end offset of every row.
+//
+// BLOB columns keep the blob id. The content is read the first time the
+// value is asked for and kept in a cache of its own, bounded in bytes;
+// the blobs of the row in use are never dropped from it. A catalog cursor
+// reads its BLOBs with the rows instead and keeps them all: the catalog
+// transaction is committed once the rows are read.
+//
 class CDataStaticCursor
 {
 public:
 	Sqlda::orgsqlvar_t & ptSqlVars;
-	bool	bYesBlob;
+	bool	bYesArray;
 	static constexpr int nMAXROWBLOCK = 40;
+	static constexpr size_t nSPILLBLOCKBYTES = 64 * 1024;
 	int		lenRow;
-	int		countBlocks;
+	int		rowsBlock;
 	int		countAllRows;
-	int		curBlock;
+	int		curRow;			// row of the last nextPosition(), current(nRow) leaves nRow - 1
 
 	using vchar_t = Sqlda::buffer_t;
-	using rowBlock_t = std::vector<vchar_t>;
+
+	struct Column {
+		unsigned	offsetData;
+		unsigned	offsetNull;
+		unsigned	length;					// VARYING without the length word
+		bool		varying;
+	};
 
 	struct RowBlock {
-		rowBlock_t rows;
-		size_t size() { return rows.size(); }
-		RowBlock(size_t row_count = 0, int row_len = 0) :
-			rows{ row_count, static_cast<vchar_t>(row_len) }
-		{}
+		vchar_t	data;					// empty while the block is spilled
+		size_t	lengthData = 0;			// size of data while spilled
+		int64_t	offsetSpill = -1;		// position in the spill file, -1 - never written
+		size_t	lengthSpill = 0;		// room at offsetSpill
+		bool	dirty = true;			// changed since it was last written
+		std::list<int>::iterator itLru;
 	};
 
+	std::vector<Column>	columns;
+	bool	compact;
+	size_t	lenNullBitmap;
+	size_t	lenHeaderBlock;
+	vchar_t	rowEncoded;
+	vchar_t	rowScratch;
+
 	std::vector<RowBlock> listBlocks;
-	rowBlock_t::reverse_iterator itCurrentRow; //we use reverse iterator because we need to set it _before_ begin()
+	std::list<int>	lruBlocks;			// resident blocks, most recently used first
+	int		lastBlock;
+	size_t	memoryBudget;				// 0 - keep every block in memory
+	size_t	memoryUsed;
+	FILE	*spillFile;
+	int64_t	lengthSpillFile;
+
+	struct CachedBlob {
+		IscBlob	*blob;
+		size_t	length;
+		int		row;					// row it was last read for
+		std::list<uint64_t>::iterator itLru;
+	};
+
+	std::unordered_map<uint64_t, CachedBlob> cacheBlobs;	// by blob id
+	std::list<uint64_t> lruBlobs;		// most recently used first
+	size_t	blobCacheBudget;
+	size_t	blobCacheUsed;
+	bool	eagerBlobs;					// BLOBs are read with the rows
 
 	vchar_t & ptOrgRowBlock;
 	unsigned numberColumns;
-	int		minRow;
-	int		maxRow;
-	int		curRow;
+	std::vector<short> numColumnArray;
+	short	countColumnArray;
 	std::vector<short> numColumnBlob;
-	short	countColumnBlob;
 	IscStatement	*statement;
 
 public:
 
-	CDataStaticCursor ( IscStatement *stmt, vchar_t & buffer, Sqlda::orgsqlvar_t & sqlVars, unsigned columnsCount, int lnRow)
+	CDataStaticCursor ( IscStatement *stmt, vchar_t & buffer, Sqlda::orgsqlvar_t & sqlVars, unsigned columnsCount, int lnRow, bool eager )
 		: ptSqlVars{ sqlVars },
 		  ptOrgRowBlock{ buffer }
 	{
 		statement = stmt;
-		bYesBlob = false;
+		bYesArray = false;
 		lenRow = lnRow;
-
-		countBlocks = 10;
-		countAllRows = 0;
-		listBlocks.resize( countBlocks );
-		listBlocks.at(0) = { nMAXROWBLOCK, lnRow };
-		itCurrentRow = std::prev( listBlocks.at(0).rows.rend() ); // == begin()
-
-		curBlock = 0;
-		minRow = 0;
-		maxRow = nMAXROWBLOCK;
-		curRow = 0;
 		numberColumns = columnsCount;
+		compact = false;
 
 		for( auto & var : ptSqlVars )
 		{
 			switch (var.sqltype)
 			{
 			case SQL_ARRAY:
+				numColumnArray.push_back( var.index - 1 );
+				break;
 			case SQL_BLOB:
 				numColumnBlob.push_back( var.index - 1 );
 				break;
+			case SQL_VARYING:
+				compact = true;
+				break;
 			}
-			var.assignBuffer( *itCurrentRow );
+			columns.push_back( { var.offsetData, var.offsetNull, var.sqllen, var.sqltype == SQL_VARYING } );
 		}
-		countColumnBlob = (short)numColumnBlob.size();
-		bYesBlob = countColumnBlob > 0;
+		countColumnArray = (short)numColumnArray.size();
+		bYesArray = countColumnArray > 0;
+
+		memoryBudget = (size_t)stmt->staticCursorMemory * 1024 * 1024;
+		eagerBlobs = eager;
+		blobCacheBudget = eager ? SIZE_MAX : (size_t)stmt->blobCacheMemory * 1024 * 1024;
+		blobCacheUsed = 0;
+		memoryUsed = 0;
+		spillFile = NULL;
+		lengthSpillFile = 0;
+		lastBlock = -1;
+
+		// a spilled block costs one read, keep it big enough to pay off
+		rowsBlock = nMAXROWBLOCK;
+		if ( memoryBudget && lenRow && (size_t)lenRow * rowsBlock < nSPILLBLOCKBYTES )
+			rowsBlock = (int)( nSPILLBLOCKBYTES / lenRow );
+
+		lenNullBitmap = ( columns.size() + 7 ) / 8;
+		lenHeaderBlock = compact ? rowsBlock * sizeof(uint32_t) : 0;
+		rowScratch.resize( lenRow );
+
+		countAllRows = 0;
+		curRow = 0;
 	}
 
 	~CDataStaticCursor()
 	{
-		if ( bYesBlob )
+		if ( bYesArray )
 		{
-			for ( auto i = 0; i < countColumnBlob; ++i )
+			try
 			{
-				auto & var = ptSqlVars.at( numColumnBlob[i] );
+				char *row = rowScratch.data();
 
-				if (var.sqltype == SQL_ARRAY || var.sqltype == SQL_BLOB)
+				for ( int nRow = 0; nRow < countAllRows; ++nRow )
 				{
-					for (auto& rowBlock : listBlocks)
+					readRow( nRow, row );
+
+					for ( auto i = 0; i < countColumnArray; ++i )
 					{
-						for (unsigned i = 0; i < rowBlock.size(); ++i)
+						auto & var = ptSqlVars.at( numColumnArray[i] );
+						auto* pt = row + var.offsetData;
+
+						if ( *(short*)( row + var.offsetNull ) != -1 && *(intptr_t*)pt )
 						{
-							auto& row = rowBlock.rows.at(i);
-							auto* pt = &row.at(var.offsetData);
-
-							if (pt && *(intptr_t*)pt)
-							{
-								if (var.sqltype == SQL_ARRAY)
-								{
-									free(((CAttrArray*)*(intptr_t*)pt)->arrBufData);
-									delete (CAttrArray*)*(intptr_t*)pt;
-								}
-								else
-								{
-									delete (IscBlob*)*(intptr_t*)pt;
-								}
-							}
+							free(((CAttrArray*)*(intptr_t*)pt)->arrBufData);
+							delete (CAttrArray*)*(intptr_t*)pt;
 						}
 					}
 				}
 			}
+			catch ( ... )
+			{
+				// the spill file is unreadable, the arrays of its rows are lost
+			}
 		}
+
+		for ( auto & entry : cacheBlobs )
+			delete entry.second.blob;
+
+		if ( spillFile )
+			fclose( spillFile );
 	}
 
-	vchar_t& addRow ()
+	void addRow ()
 	{
-		if ( bYesBlob )
+		if ( bYesArray )
 		{
 			int n;
 			auto & sqlvar = ptSqlVars;
-			for ( n = 0; n < countColumnBlob; ++n )
+			for ( n = 0; n < countColumnArray; ++n )
 			{
-				auto & var = sqlvar.at( numColumnBlob[n] );
+				auto & var = sqlvar.at( numColumnArray[n] );
 				if ( *var.sqlind == -1 )
 					*(intptr_t*)var.sqldata = 0;
-				else if ( (var.sqltype) == SQL_ARRAY )
+				else
 				{
 					CAttrArray * ptArr = new CAttrArray;
 					IscArray iscArr(statement,&var);
@@ -198,23 +274,20 @@ public:
 					iscArr.detach(ptArr);
 					*(intptr_t*)var.sqldata = (intptr_t)ptArr;
 				}
-				else if ( var.sqltype == SQL_BLOB )
-				{
-					IscBlob * ptBlob = new IscBlob (statement, var.sqldata, var.sqlsubtype);
-					ptBlob->fetchBlob();
-					*(intptr_t*)var.sqldata = (intptr_t)ptBlob;
-				}
 			}
 		}
 
-		this->copyToCurrentSqlda(ptOrgRowBlock);	//save fetched buffer to current row
-		nextPosition();								//scroll to the next position
-		auto& row = *itCurrentRow;
-
-		for( auto & var : ptSqlVars ) var.assignBuffer( row );
+		if ( eagerBlobs )
+			for ( short column : numColumnBlob )
+			{
+				auto & var = ptSqlVars.at( column );
+				if ( *var.sqlind != -1 )
+					getBlob( var.sqldata );
+			}
 
+		this->copyToCurrentSqlda(ptOrgRowBlock);	//save fetched buffer to current row
+		++curRow;									//scroll to the next position
 		++countAllRows;
-		return row;
 	}
 
 	inline void restoreOriginalAdressFieldsSqlDa()
@@ -224,63 +297,303 @@ public:
 
 	bool current(int nRow)
 	{
-		int i, n;
-
 		assert( nRow >= 0 );
 
-		if( !(nRow >= minRow && nRow < maxRow) )
+		curRow = nRow - 1; // We put previous for use next() !!!
+		return true;
+	}
+
+	//
+	// The addresses point into a copy of the row and stay valid until
+	// the next call.
+	//
+	void getAdressFieldFromCurrentRowInBufferStaticCursor(int column, char *& sqldata, short *& sqlind)
+	{
+		char *row = rowScratch.data();
+		readRow( curRow + 1, row );
+		auto& var = ptSqlVars.at(column - 1);
+		sqldata = row + var.offsetData;
+		sqlind = (short*)( row + var.offsetNull );
+	}
+
+	//
+	// Copies the row into buf, lenRow bytes laid out like Sqlda::buffer.
+	// A row that was never written reads as zeros.
+	//
+	void readRow(int nRow, char *buf)
+	{
+		RowBlock &block = touchRow( nRow );
+		int k = nRow % rowsBlock;
+
+		if ( !compact )
 		{
-			for (i = 0, n = listBlocks.at(i).size();
-				nRow > n && i < countBlocks;
-				n += listBlocks.at(++i).size());
+			memcpy( buf, block.data.data() + (size_t)k * lenRow, lenRow );
+			return;
+		}
+
+		uint32_t *ends = (uint32_t*)block.data.data();
+		uint32_t begin = k ? ends[k - 1] : 0;
+
+		if ( begin == ends[k] )
+			memset( buf, 0, lenRow );
+		else
+			decodeRow( block.data.data() + lenHeaderBlock + begin, buf );
+	}
+
+	void writeRow(int nRow, const char *buf)
+	{
+		RowBlock &block = touchRow( nRow );
+		int k = nRow % rowsBlock;
 
-			curBlock = i;
-			maxRow = n;
-			minRow = maxRow - listBlocks.at(curBlock).size();
+		block.dirty = true;
+
+		if ( !compact )
+		{
+			memcpy( block.data.data() + (size_t)k * lenRow, buf, lenRow );
+			return;
 		}
 
-		curRow = nRow;
-		itCurrentRow = listBlocks.at(curBlock).rows.rend();
-		std::advance( itCurrentRow, -(curRow - minRow) );
-		--curRow; // We put previous for use next() !!!
+		encodeRow( buf );
 
-		return true;
+		size_t capacity = block.data.capacity();
+		uint32_t *ends = (uint32_t*)block.data.data();
+		uint32_t begin = k ? ends[k - 1] : 0;
+		int64_t delta = (int64_t)rowEncoded.size() - ( ends[k] - begin );
+		auto pos = block.data.begin() + lenHeaderBlock + begin;
+
+		if ( delta )
+		{
+			pos = block.data.erase( pos, pos + ( ends[k] - begin ) );
+			pos = block.data.insert( pos, rowEncoded.size(), 0 );
+
+			ends = (uint32_t*)block.data.data();
+			for ( int n = k; n < rowsBlock; ++n )
+				ends[n] = (uint32_t)( ends[n] + delta );
+		}
+
+		memcpy( &*pos, rowEncoded.data(), rowEncoded.size() );
+
+		// rows are appended in order, the last one completes the block
+		if ( k == rowsBlock - 1 )
+			block.data.shrink_to_fit();
+
+		if ( block.data.capacity() != capacity )
+		{
+			memoryUsed += block.data.capacity() - capacity;
+			if ( memoryBudget )
+				releaseBlocks();
+		}
 	}
 
-	void getAdressFieldFromCurrentRowInBufferStaticCursor(int column, char *& sqldata, short *& sqlind)
+	void encodeRow(const char *buf)
 	{
-		auto it = std::prev(itCurrentRow);
-		auto& row = *it;
-		auto& var = ptSqlVars.at(column - 1);
-		sqldata = &row.at(var.offsetData);
-		sqlind = (short*)&row.at(var.offsetNull);
+		rowEncoded.assign( lenNullBitmap, 0 );
+
+		for ( size_t n = 0; n < columns.size(); ++n )
+		{
+			Column &col = columns[n];
+
+			if ( *(short*)( buf + col.offsetNull ) == -1 )
+			{
+				rowEncoded[n >> 3] |= 1 << ( n & 7 );
+				continue;
+			}
+
+			const char *data = buf + col.offsetData;
+			size_t length = col.length;
+
+			if ( col.varying )
+			{
+				unsigned short lengthVarying;
+				memcpy( &lengthVarying, data, sizeof(lengthVarying) );
+				length = sizeof(lengthVarying) + MIN( lengthVarying, col.length );
+			}
+
+			rowEncoded.insert( rowEncoded.end(), data, data + length );
+		}
 	}
 
-	vchar_t& nextPosition()
+	void decodeRow(const char *row, char *buf)
 	{
-		if (++curRow < maxRow)
+		const char *pt = row + lenNullBitmap;
+
+		for ( size_t n = 0; n < columns.size(); ++n )
 		{
-			std::advance( itCurrentRow, -1 ); // == ++it
+			Column &col = columns[n];
+			char *data = buf + col.offsetData;
+
+			if ( row[n >> 3] & ( 1 << ( n & 7 ) ) )
+			{
+				*(short*)( buf + col.offsetNull ) = -1;
+				memset( data, 0, col.varying ? sizeof(short) : col.length );
+				continue;
+			}
+
+			size_t length = col.length;
+
+			if ( col.varying )
+			{
+				unsigned short lengthVarying;
+				memcpy( &lengthVarying, pt, sizeof(lengthVarying) );
+				length = sizeof(lengthVarying) + MIN( lengthVarying, col.length );
+			}
+
+			*(short*)( buf + col.offsetNull ) = 0;
+			memcpy( data, pt, length );
+			pt += length;
 		}
+	}
+
+	RowBlock& touchRow(int nRow)
+	{
+		int n = nRow / rowsBlock;
+
+		if ( n >= (int)listBlocks.size() )
+			listBlocks.resize( n + 1 );
+
+		if ( n != lastBlock )
+			touchBlock( n );
+
+		return listBlocks[n];
+	}
+
+	void touchBlock(int n)
+	{
+		RowBlock &block = listBlocks[n];
+
+		if ( !block.data.empty() )
+		{
+			lruBlocks.splice( lruBlocks.begin(), lruBlocks, block.itLru );
+			lastBlock = n;
+			return;
+		}
+
+		if ( block.offsetSpill < 0 )
+			block.data.resize( compact ? lenHeaderBlock : (size_t)rowsBlock * lenRow );
 		else
 		{
-			if ( ++curBlock == countBlocks )
+			block.data.resize( block.lengthData );
+
+			if ( FSEEK64( spillFile, block.offsetSpill, SEEK_SET )
+				|| fread( block.data.data(), 1, block.lengthData, spillFile ) != block.lengthData )
 			{
-				countBlocks += 10;
-				listBlocks.resize( countBlocks );
+				vchar_t().swap( block.data );
+				throw SQLEXCEPTION (RUNTIME_ERROR, "static cursor: cannot read the spill file");
 			}
-			
-			if ( listBlocks.at(curBlock).rows.size() == 0 )
+			block.dirty = false;
+		}
+
+		lruBlocks.push_front( n );
+		block.itLru = lruBlocks.begin();
+		memoryUsed += block.data.capacity();
+		lastBlock = n;
+
+		if ( memoryBudget )
+			releaseBlocks();
+	}
+
+	//
+	// Writes the least recently used blocks out until the budget is met.
+	// The block in use is never released.
+	//
+	void releaseBlocks()
+	{
+		while ( memoryUsed > memoryBudget && lruBlocks.size() > 1 )
+		{
+			RowBlock &block = listBlocks[ lruBlocks.back() ];
+
+			if ( block.dirty )
 			{
-				listBlocks.at(curBlock) = { nMAXROWBLOCK, lenRow };
+				size_t length = block.data.size();
+				bool reuse = block.offsetSpill >= 0 && length <= block.lengthSpill;
+				int64_t offset = reuse ? block.offsetSpill : lengthSpillFile;
+
+				if ( !spillFile && !( spillFile = tmpfile() ) )
+					throw SQLEXCEPTION (RUNTIME_ERROR, "static cursor: cannot create the spill file");
+
+				if ( FSEEK64( spillFile, offset, SEEK_SET )
+					|| fwrite( block.data.data(), 1, length, spillFile ) != length )
+					throw SQLEXCEPTION (RUNTIME_ERROR, "static cursor: cannot write the spill file");
+
+				if ( !reuse )
+				{
+					block.offsetSpill = offset;
+					block.lengthSpill = length;
+					lengthSpillFile += length;
+				}
+				block.lengthData = length;
+				block.dirty = false;
 			}
 
-			itCurrentRow = std::prev( listBlocks.at(curBlock).rows.rend() );
-			minRow = curRow;
-			maxRow = minRow + listBlocks.at(curBlock).size();
+			lruBlocks.pop_back();
+			memoryUsed -= block.data.capacity();
+			vchar_t().swap( block.data );
+		}
+	}
+
+	//
+	// Returns the content of the blob whose id is at sqldata, reading it
+	// on first use. The blob handle is closed as soon as it is read, and
+	// the object stays owned by the cache.
+	//
+	IscBlob* getBlob(const char *sqldata)
+	{
+		uint64_t key;
+		memcpy( &key, sqldata, sizeof(key) );
+
+		auto it = cacheBlobs.find( key );
+
+		if ( it != cacheBlobs.end() )
+		{
+			it->second.row = curRow;
+			lruBlobs.splice( lruBlobs.begin(), lruBlobs, it->second.itLru );
+			return it->second.blob;
+		}
+
+		IscBlob *blob = new IscBlob( statement, (char*)sqldata, 0 );
+
+		try
+		{
+			blob->fetchBlob();
+		}
+		catch ( ... )
+		{
+			delete blob;
+			throw;
 		}
 
-		return *itCurrentRow;
+		lruBlobs.push_front( key );
+		CachedBlob &entry = cacheBlobs[key];
+		entry.blob = blob;
+		entry.length = sizeof(IscBlob) + blob->length();
+		entry.row = curRow;
+		entry.itLru = lruBlobs.begin();
+		blobCacheUsed += entry.length;
+
+		releaseBlobs();
+
+		return blob;
+	}
+
+	//
+	// Drops the least recently used blobs until the budget is met. Blobs
+	// read for the row in use may still be attached to a descriptor and
+	// are kept.
+	//
+	void releaseBlobs()
+	{
+		for ( auto it = lruBlobs.end(); blobCacheUsed > blobCacheBudget && it != lruBlobs.begin(); )
+		{
+			auto entry = cacheBlobs.find( *--it );
+
+			if ( entry->second.row == curRow )
+				continue;
+
+			blobCacheUsed -= entry->second.length;
+			delete entry->second.blob;
+			cacheBlobs.erase( entry );
+			it = lruBlobs.erase( it );
+		}
 	}
 
 	inline int getCountRowsStaticCursor()
@@ -288,24 +601,49 @@ public:
 		return countAllRows;
 	}
 
+	inline size_t getMemoryStaticCursor()
+	{
+		return memoryUsed + listBlocks.capacity() * sizeof(RowBlock) + rowEncoded.capacity() + rowScratch.capacity()
+			+ blobCacheUsed;
+	}
+
 	inline void operator << (Sqlda::buffer_t & buf)
 	{
-		nextPosition() = buf;
+		writeRow( ++curRow, buf.data() );
 	}
 
 	inline void operator >> (Sqlda::buffer_t & buf)
 	{
-		buf = nextPosition();
+		buf.resize( lenRow );
+		readRow( ++curRow, buf.data() );
+	}
+
+	//
+	// Moves to the next row and returns it when it is stored at full width,
+	// so it can be read in place until another block is touched. Compact
+	// rows are copied into buf instead and NULL is returned.
+	//
+	char* nextRowInPlace(Sqlda::buffer_t & buf)
+	{
+		if ( compact )
+		{
+			*this >> buf;
+			return NULL;
+		}
+
+		int nRow = ++curRow;
+		return touchRow( nRow ).data.data() + (size_t)( nRow % rowsBlock ) * lenRow;
 	}
 
 	inline void copyToBuffer(Sqlda::buffer_t & buf)
 	{
-		buf = *itCurrentRow;
+		buf.resize( lenRow );
+		readRow( curRow, buf.data() );
 	}
 
 	inline void copyToCurrentSqlda(Sqlda::buffer_t & buf)
 	{
-		*itCurrentRow = buf;
+		writeRow( curRow, buf.data() );
 	}
 };
 
@@ -328,12 +666,14 @@ void Sqlda::init()
 	execMeta = meta = nullptr;
 	sqlvar.clear();
 	dataStaticCursor = nullptr;
+	keysetCursor = nullptr;
 	columnsCount = 0;
 }
 
 void Sqlda::remove()
 {
 	delete dataStaticCursor;
+	delete keysetCursor;
 	deleteSqlda(); // Should stand only here!!!
 }
 
@@ -542,18 +882,23 @@ void Sqlda::mapSqlAttributes( IscStatement *stmt )
 	}
 }
 
-Sqlda::buffer_t& Sqlda::initStaticCursor(IscStatement *stmt)
+void Sqlda::initStaticCursor(IscStatement *stmt, bool eagerBlobs)
 {
 	if ( dataStaticCursor )
 		delete 	dataStaticCursor;
 
-	dataStaticCursor = new CDataStaticCursor( stmt, buffer, sqlvar, columnsCount, lengthBufferRows );
-	return *dataStaticCursor->itCurrentRow;
+	if ( keysetCursor )
+	{
+		delete keysetCursor;
+		keysetCursor = nullptr;
+	}
+
+	dataStaticCursor = new CDataStaticCursor( stmt, buffer, sqlvar, columnsCount, lengthBufferRows, eagerBlobs );
 }
 
-Sqlda::buffer_t& Sqlda::addRowSqldaInBufferStaticCursor()
+void Sqlda::addRowSqldaInBufferStaticCursor()
 {
-	return dataStaticCursor->addRow();
+	dataStaticCursor->addRow();
 }
 
 void Sqlda::restoreOrgAdressFieldsStaticCursor()
@@ -563,6 +908,12 @@ void Sqlda::restoreOrgAdressFieldsStaticCursor()
 
 bool Sqlda::setCurrentRowInBufferStaticCursor(int nRow)
 {
+	if ( keysetCursor )
+	{
+		keysetCursor->current(nRow);
+		return true;
+	}
+
 	return dataStaticCursor->current(nRow);
 }
 
@@ -578,7 +929,29 @@ void Sqlda::copyNextSqldaInBufferStaticCursor()
 
 void Sqlda::copyNextSqldaFromBufferStaticCursor()
 {
-	*dataStaticCursor >> buffer;
+	if ( keysetCursor )
+		keysetCursor->nextRow( buffer.data() );
+	else
+		*dataStaticCursor >> buffer;
+}
+
+IscBlob* Sqlda::getBlobStaticCursor(const char *sqldata)
+{
+	if ( keysetCursor )
+		return keysetCursor->getBlob(sqldata);
+
+	return dataStaticCursor->getBlob(sqldata);
+}
+
+char* Sqlda::nextRowInBufferStaticCursor()
+{
+	if ( keysetCursor )
+	{
+		keysetCursor->nextRow( buffer.data() );
+		return NULL;
+	}
+
+	return dataStaticCursor->nextRowInPlace( buffer );
 }
 
 void Sqlda::saveCurrentSqldaToBuffer()
@@ -593,9 +966,73 @@ void Sqlda::restoreBufferToCurrentSqlda()
 
 int Sqlda::getCountRowsStaticCursor()
 {
+	if ( keysetCursor )
+		return keysetCursor->getCountRows();
+
 	return dataStaticCursor->getCountRowsStaticCursor();
 }
 
+size_t Sqlda::getMemoryStaticCursor()
+{
+	if ( keysetCursor )
+		return keysetCursor->getMemory();
+
+	return dataStaticCursor ? dataStaticCursor->getMemoryStaticCursor() : 0;
+}
+
+//
+// Opens a keyset-driven cursor over the query of stmt in place of the
+// static one. Returns false when the query does not qualify.
+//
+bool Sqlda::openKeysetCursor(IscStatement *stmt)
+{
+	delete dataStaticCursor;
+	dataStaticCursor = nullptr;
+	delete keysetCursor;
+
+	keysetCursor = new IscKeysetCursor( stmt );
+
+	bool opened;
+
+	try
+	{
+		opened = keysetCursor->open();
+	}
+	catch ( ... )
+	{
+		delete keysetCursor;
+		keysetCursor = nullptr;
+		throw;
+	}
+
+	if ( !opened )
+	{
+		delete keysetCursor;
+		keysetCursor = nullptr;
+	}
+
+	return opened;
+}
+
+//
+// Rows are read again from the server the next time they are fetched.
+//
+void Sqlda::refreshKeysetCursor()
+{
+	if ( keysetCursor )
+		keysetCursor->refresh();
+}
+
+bool Sqlda::rowUpdatedStaticCursor()
+{
+	return keysetCursor && keysetCursor->getRowState() == IscKeysetCursor::enRowUpdated;
+}
+
+bool Sqlda::rowDeletedStaticCursor()
+{
+	return keysetCursor && keysetCursor->getRowState() == IscKeysetCursor::enRowDeleted;
+}
+
 int Sqlda::getColumnCount()
 {
 	return columnsCount;
@@ -135,6 +135,11 @@ public:
 		eff_sqlind  = sqlind  = (short*)&buffer.at( offsetNull );
 	}
 
+	inline void assignBuffer(char* buffer ) {
+		eff_sqldata = sqldata = buffer + offsetData;
+		eff_sqlind  = sqlind  = (short*)( buffer + offsetNull );
+	}
+
 	inline bool propertiesOverriden() {
 		return !( *this == lastSqlProperties);
 	}
@@ -154,6 +159,8 @@ public:
 class Value;
 class IscConnection;
 class CDataStaticCursor;
+class IscKeysetCursor;
+class IscBlob;
 
 class Sqlda
 {
@@ -166,8 +173,8 @@ public:
 	};
 
 protected:
-	buffer_t& initStaticCursor(IscStatement* stmt);
-	buffer_t& addRowSqldaInBufferStaticCursor();
+	void initStaticCursor(IscStatement* stmt, bool eagerBlobs = false);
+	void addRowSqldaInBufferStaticCursor();
 	void restoreOrgAdressFieldsStaticCursor();
 	e_sqlda_dir SqldaDir;
 
@@ -195,9 +202,16 @@ public:
 	void getAdressFieldFromCurrentRowInBufferStaticCursor(int column, char*& sqldata, short*& sqlind);
 	void copyNextSqldaInBufferStaticCursor();
 	void copyNextSqldaFromBufferStaticCursor();
+	char* nextRowInBufferStaticCursor();
+	IscBlob* getBlobStaticCursor(const char* sqldata);
 	void saveCurrentSqldaToBuffer();
 	void restoreBufferToCurrentSqlda();
 	int getCountRowsStaticCursor();
+	size_t getMemoryStaticCursor();
+	bool openKeysetCursor(IscStatement* stmt);
+	void refreshKeysetCursor();
+	bool rowUpdatedStaticCursor();
+	bool rowDeletedStaticCursor();
 	int getColumnCount();
 	void init();
 	void remove();
@@ -229,6 +243,7 @@ public:
 	void updateVarying(int index, const char* dst);
 
 	CDataStaticCursor* dataStaticCursor;
+	IscKeysetCursor* keysetCursor;		// replaces dataStaticCursor for a keyset-driven cursor
 	int			lengthBufferRows;
 
 	IscConnection* connection;
@@ -199,7 +199,7 @@ SQLRETURN SQL_API SQLBindCol( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 						   SQLLEN bufferLength, SQLLEN *strLen_or_Ind )
 {
 	TRACE ("SQLBindCol");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlBindCol( columnNumber, targetType, targetValue, 
 												bufferLength, strLen_or_Ind );
@@ -222,7 +222,7 @@ SQLRETURN SQL_API SQLColAttributes( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 								 SQLLEN *numericAttribute )
 {
 	TRACE("SQLColAttributes");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlColAttribute( columnNumber, fieldIdentifier,
 													characterAttribute, bufferLength,
@@ -266,7 +266,7 @@ SQLRETURN SQL_API SQLDescribeCol( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 							   SQLSMALLINT *nullable )
 {
 	TRACE ("SQLDescribeCol");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlDescribeCol( columnNumber, columnName, bufferLength, 
 												nameLength, dataType, columnSize, decimalDigits,
@@ -295,7 +295,7 @@ SQLRETURN SQL_API SQLError( SQLHENV hEnv,
 
 	if ( hStmt )
 	{
-		GUARD_HSTMT( hStmt );
+		GUARD_HSTMT_LOCAL( hStmt );
 		return ((OdbcStatement*)hStmt)->sqlError( sqlState, nativeErrorCode, msgBuffer,
 													msgBufferLength, msgLength );
 	}
@@ -317,9 +317,13 @@ SQLRETURN SQL_API SQLError( SQLHENV hEnv,
 SQLRETURN SQL_API SQLExecDirect( SQLHSTMT hStmt, SQLCHAR *statementText, SQLINTEGER textLength )
 {
 	TRACE ("SQLExecDirect");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlExecDirect( statementText, textLength );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLEXECDIRECT, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlExecDirect( statementText, textLength );
+	} );
 }
 
 ///// SQLExecute /////	ODBC 1.0	///// ISO 92
@@ -327,9 +331,13 @@ SQLRETURN SQL_API SQLExecDirect( SQLHSTMT hStmt, SQLCHAR *statementText, SQLINTE
 SQLRETURN SQL_API SQLExecute( SQLHSTMT hStmt )
 {
 	TRACE("SQLExecute");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlExecute();
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLEXECUTE, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlExecute();
+	} );
 }
 
 ///// SQLFetch /////	ODBC 1.0	///// ISO 92
@@ -337,9 +345,13 @@ SQLRETURN SQL_API SQLExecute( SQLHSTMT hStmt )
 SQLRETURN SQL_API SQLFetch( SQLHSTMT hStmt )
 {
 	TRACE ("SQLFetch");
-	GUARD_HSTMT( hStmt );
-	
-	return ((OdbcStatement*) hStmt)->sqlFetch();
+
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLFETCH, [=]
+	{
+		GUARD_HSTMT_FETCH( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlFetch();
+	} );
 }
 
 ///// SQLFreeConnect /////	ODBC 1.0	///// Deprecated
@@ -368,14 +380,19 @@ SQLRETURN SQL_API SQLFreeEnv( SQLHENV hEnv )
 SQLRETURN SQL_API SQLFreeStmt( SQLHSTMT hStmt, SQLUSMALLINT option )
 {
 	TRACE ("SQLFreeStmt");
-	GUARD_HSTMT( hStmt );
 
+	// the lock of a statement cannot outlive it; a call running
+	// asynchronously takes the locks itself, so it ends before they are held
 	if ( option == SQL_DROP )
 	{
+		((OdbcStatement*) hStmt)->asyncWait();
+		GUARD_HDBC( ((OdbcStatement*) hStmt)->connection );
 		delete (OdbcStatement*) hStmt;
 		return SQL_SUCCESS;
 	}
 
+	GUARD_HSTMT( hStmt );
+
 	return ((OdbcStatement*) hStmt)->sqlFreeStmt( option );
 }
 
@@ -385,7 +402,7 @@ SQLRETURN SQL_API SQLGetCursorName( SQLHSTMT hStmt, SQLCHAR *cursorName,
 								 SQLSMALLINT bufferLength,  SQLSMALLINT *nameLength )
 {
 	TRACE ("SQLGetCursorName called\n");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlGetCursorName( cursorName, bufferLength, nameLength );
 }
@@ -395,7 +412,7 @@ SQLRETURN SQL_API SQLGetCursorName( SQLHSTMT hStmt, SQLCHAR *cursorName,
 SQLRETURN SQL_API SQLNumResultCols( SQLHSTMT hStmt, SQLSMALLINT *columnCount )
 {
 	TRACE ("SQLNumResultCols");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlNumResultCols( columnCount );
 }
@@ -406,9 +423,13 @@ SQLRETURN SQL_API SQLPrepare( SQLHSTMT hStmt,
            SQLCHAR *statementText, SQLINTEGER textLength )
 {
 	TRACE ("SQLPrepare");
-	GUARD_HSTMT( hStmt );
-	
-	return ((OdbcStatement*) hStmt)->sqlPrepare( statementText, textLength );
+
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPREPARE, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlPrepare( statementText, textLength );
+	} );
 }
 
 ///// SQLRowCount /////	ODBC 1.0	///// ISO 92
@@ -416,7 +437,7 @@ SQLRETURN SQL_API SQLPrepare( SQLHSTMT hStmt,
 SQLRETURN SQL_API SQLRowCount( SQLHSTMT hStmt, SQLLEN* rowCount )
 {
 	TRACE ("SQLRowCount");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlRowCount( rowCount );
 }
@@ -441,7 +462,7 @@ SQLRETURN SQL_API SQLSetParam( SQLHSTMT hStmt,
 						   SQLLEN *strLen_or_Ind )
 {
 	TRACE ("SQLSetParam");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlSetParam( parameterNumber, valueType,
 													parameterType, lengthPrecision,
@@ -475,12 +496,16 @@ SQLRETURN SQL_API SQLColumns( SQLHSTMT hStmt,
 						   SQLCHAR *columnName, SQLSMALLINT nameLength4 )
 {
 	TRACE ("SQLColumns");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlColumns( catalogName, nameLength1,
-												   schemaName, nameLength2,
-												   tableName, nameLength3,
-												   columnName, nameLength4 );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLCOLUMNS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlColumns( catalogName, nameLength1,
+													   schemaName, nameLength2,
+													   tableName, nameLength3,
+													   columnName, nameLength4 );
+	} );
 }
 
 ///// SQLDriverConnect /////
@@ -541,7 +566,7 @@ SQLRETURN SQL_API SQLGetData( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 							 SQLLEN bufferLength, SQLLEN *strLen_or_Ind )
 {
 	TRACE ("SQLGetData");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_FETCH( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlGetData( columnNumber, targetType, targetValue,
 													bufferLength, strLen_or_Ind );
@@ -575,7 +600,7 @@ SQLRETURN SQL_API SQLGetInfo( SQLHDBC hDbc, SQLUSMALLINT infoType, SQLPOINTER in
 SQLRETURN SQL_API SQLGetStmtOption( SQLHSTMT hStmt, SQLUSMALLINT option, SQLPOINTER value )
 {
 	TRACE ("SQLGetStmtOption");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlGetStmtAttr( option, value, 0, NULL );
 }
@@ -585,9 +610,13 @@ SQLRETURN SQL_API SQLGetStmtOption( SQLHSTMT hStmt, SQLUSMALLINT option, SQLPOIN
 SQLRETURN SQL_API SQLGetTypeInfo( SQLHSTMT hStmt, SQLSMALLINT dataType )
 {
 	TRACE ("SQLGetTypeInfo");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlGetTypeInfo( dataType );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLGETTYPEINFO, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlGetTypeInfo( dataType );
+	} );
 }
 
 ///// SQLParamData /////
@@ -641,13 +670,17 @@ SQLRETURN SQL_API SQLSpecialColumns( SQLHSTMT hStmt, SQLUSMALLINT identifierType
 									SQLUSMALLINT scope, SQLUSMALLINT nullable )
 {
 	TRACE ("SQLSpecialColumns");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlSpecialColumns( identifierType,
-														catalogName, nameLength1,
-														schemaName, nameLength2,
-														tableName, nameLength3,
-														scope, nullable);
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLSPECIALCOLUMNS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlSpecialColumns( identifierType,
+															catalogName, nameLength1,
+															schemaName, nameLength2,
+															tableName, nameLength3,
+															scope, nullable);
+	} );
 }
 
 ///// SQLStatistics /////
@@ -659,12 +692,16 @@ SQLRETURN SQL_API SQLStatistics( SQLHSTMT hStmt,
 								SQLUSMALLINT unique, SQLUSMALLINT reserved )
 {
 	TRACE ("SQLStatistics");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlStatistics( catalogName, nameLength1,
-													schemaName, nameLength2,
-													tableName, nameLength3,
-													unique, reserved );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLSTATISTICS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlStatistics( catalogName, nameLength1,
+														schemaName, nameLength2,
+														tableName, nameLength3,
+														unique, reserved );
+	} );
 }
 
 ///// SQLTables /////
@@ -676,12 +713,16 @@ SQLRETURN SQL_API SQLTables( SQLHSTMT hStmt,
 							SQLCHAR *tableType, SQLSMALLINT nameLength4 )
 {
 	TRACE ("SQLTables");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlTables( catalogName, nameLength1,
-												schemaName, nameLength2,
-												tableName, nameLength3,
-												tableType, nameLength4 );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLTABLES, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlTables( catalogName, nameLength1,
+													schemaName, nameLength2,
+													tableName, nameLength3,
+													tableType, nameLength4 );
+	} );
 }
 
 ///// SQLBrowseConnect /////
@@ -723,7 +764,7 @@ SQLRETURN SQL_API SQLDescribeParam( SQLHSTMT hStmt, SQLUSMALLINT iPar,
 
 {
 	TRACE("SQLDescribeParam");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlDescribeParam( iPar, pfSqlType, pcbParamDef,
 														pibScale, pfNullable );
@@ -735,7 +776,7 @@ SQLRETURN SQL_API SQLExtendedFetch( SQLHSTMT hStmt, SQLUSMALLINT fFetchType,
 									SQLLEN iRow, SQLULEN *pcRow, SQLUSMALLINT *rgfRowStatus )
 {
 	TRACE ("SQLExtendedFetch");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_FETCH( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlExtendedFetch( fFetchType, iRow, pcRow, rgfRowStatus );
 }
@@ -751,14 +792,18 @@ SQLRETURN SQL_API SQLForeignKeys( SQLHSTMT hStmt,
 									SQLCHAR *szFkTableName, SQLSMALLINT cbFkTableName )
 {
 	TRACE ("SQLForeignKeys");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlForeignKeys( szPkCatalogName, cbPkCatalogName,
-														szPkSchemaName, cbPkSchemaName,
-														szPkTableName, cbPkTableName,
-														szFkCatalogName, cbFkCatalogName,
-														szFkSchemaName, cbFkSchemaName,
-														szFkTableName, cbFkTableName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLFOREIGNKEYS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlForeignKeys( szPkCatalogName, cbPkCatalogName,
+															szPkSchemaName, cbPkSchemaName,
+															szPkTableName, cbPkTableName,
+															szFkCatalogName, cbFkCatalogName,
+															szFkSchemaName, cbFkSchemaName,
+															szFkTableName, cbFkTableName );
+	} );
 }
 
 ///// SQLMoreResults /////
@@ -766,9 +811,13 @@ SQLRETURN SQL_API SQLForeignKeys( SQLHSTMT hStmt,
 SQLRETURN SQL_API SQLMoreResults( SQLHSTMT hStmt )
 {
 	TRACE("SQLMoreResults");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlMoreResults();
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLMORERESULTS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlMoreResults();
+	} );
 }
 
 ///// SQLNativeSql /////
@@ -790,7 +839,7 @@ SQLRETURN SQL_API SQLNativeSql( SQLHDBC hDbc,
 SQLRETURN SQL_API SQLNumParams( SQLHSTMT hStmt, SQLSMALLINT *pcPar )
 {
 	TRACE("SQLMoreResults");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlNumParams( pcPar );
 }
@@ -816,11 +865,15 @@ SQLRETURN SQL_API SQLPrimaryKeys( SQLHSTMT hStmt,
 								SQLCHAR *szTableName, SQLSMALLINT cbTableName )
 {
 	TRACE ("SQLPrimaryKeys");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlPrimaryKeys( szCatalogName, cbCatalogName,
-													szSchemaName, cbSchemaName,
-													szTableName, cbTableName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPRIMARYKEYS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlPrimaryKeys( szCatalogName, cbCatalogName,
+														szSchemaName, cbSchemaName,
+														szTableName, cbTableName );
+	} );
 }
 
 ///// SQLProcedureColumns /////
@@ -836,12 +889,16 @@ SQLRETURN SQL_API SQLProcedureColumns( SQLHSTMT hStmt,
 									SQLSMALLINT cbColumnName )
 {
 	TRACE ("SQLProcedureColumns");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlProcedureColumns( szCatalogName, cbCatalogName,
-															szSchemaName, cbSchemaName,
-															szProcName, cbProcName,
-															szColumnName, cbColumnName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPROCEDURECOLUMNS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlProcedureColumns( szCatalogName, cbCatalogName,
+																szSchemaName, cbSchemaName,
+																szProcName, cbProcName,
+																szColumnName, cbColumnName );
+	} );
 }
 
 ///// SQLProcedures /////
@@ -852,11 +909,15 @@ SQLRETURN SQL_API SQLProcedures( SQLHSTMT hStmt,
 								SQLCHAR *szProcName, SQLSMALLINT cbProcName )
 {
 	TRACE ("SQLProcedures");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlProcedures( szCatalogName, cbCatalogName,
-													szSchemaName, cbSchemaName,
-													szProcName, cbProcName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPROCEDURES, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlProcedures( szCatalogName, cbCatalogName,
+														szSchemaName, cbSchemaName,
+														szProcName, cbProcName );
+	} );
 }
 
 ///// SQLSetPos /////
@@ -890,11 +951,15 @@ SQLRETURN SQL_API SQLTablePrivileges( SQLHSTMT hStmt,
 
 {
 	TRACE ("SQLTablePrivileges");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlTablePrivileges( szCatalogName, cbCatalogName,
-														szSchemaName, cbSchemaName,
-														szTableName, cbTableName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLTABLEPRIVILEGES, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlTablePrivileges( szCatalogName, cbCatalogName,
+															szSchemaName, cbSchemaName,
+															szTableName, cbTableName );
+	} );
 }
 
 ///// SQLColumnPrivileges /////
@@ -906,12 +971,16 @@ SQLRETURN SQL_API SQLColumnPrivileges( SQLHSTMT hStmt,
 										SQLCHAR *szColumnName, SQLSMALLINT cbColumnName )
 {
 	TRACE ("SQLColumnPrivileges");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlColumnPrivileges( szCatalogName, cbCatalogName,
-															szSchemaName, cbSchemaName,
-															szTableName, cbTableName,
-															szColumnName, cbColumnName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLCOLUMNPRIVILEGES, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlColumnPrivileges( szCatalogName, cbCatalogName,
+																szSchemaName, cbSchemaName,
+																szTableName, cbTableName,
+																szColumnName, cbColumnName );
+	} );
 }
 
 ///// SQLDrivers /////
@@ -938,7 +1007,7 @@ SQLRETURN SQL_API SQLBindParameter( SQLHSTMT hStmt, SQLUSMALLINT iPar, SQLSMALLI
 									SQLLEN *pcbValue )
 {
 	TRACE ("SQLBindParameter");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*) hStmt)->sqlBindParameter( iPar, fParamType, fCType, fSqlType,
 													cbColDef, ibScale, rgbValue, cbValueMax,
@@ -989,7 +1058,7 @@ SQLRETURN SQL_API SQLBindParam( SQLHSTMT hStmt, SQLUSMALLINT parameterNumber,
 							 SQLPOINTER parameterValue, SQLLEN *strLen_or_Ind )
 {
 	TRACE ("SQLBindParam");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*)hStmt)->sqlBindParameter( parameterNumber, SQL_PARAM_INPUT,
 									valueType, parameterType, lengthPrecision, parameterScale,
@@ -1018,7 +1087,7 @@ SQLRETURN SQL_API SQLColAttribute( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 #endif
 {
 	TRACE ("SQLColAttribute");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	return ((OdbcStatement*)hStmt)->sqlColAttribute( columnNumber, fieldIdentifier,
 													characterAttribute, bufferLength,
@@ -1069,9 +1138,13 @@ SQLRETURN SQL_API SQLFetchScroll( SQLHSTMT hStmt,
 								SQLSMALLINT fetchOrientation, SQLLEN fetchOffset )
 {
 	TRACE ("SQLFetchScroll");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlFetchScroll( fetchOrientation, fetchOffset );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLFETCHSCROLL, [=]
+	{
+		GUARD_HSTMT_FETCH( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlFetchScroll( fetchOrientation, fetchOffset );
+	} );
 }
 
 ///// SQLFreeHandle /////
@@ -1098,7 +1171,8 @@ SQLRETURN SQL_API SQLFreeHandle( SQLSMALLINT handleType, SQLHANDLE handle )
 
 	case SQL_HANDLE_STMT:
 		{
-			GUARD_HSTMT( handle );
+			((OdbcStatement*) handle)->asyncWait();
+			GUARD_HDBC( ((OdbcStatement*) handle)->connection );
 			delete (OdbcStatement*) handle;
 		}
 		break;
@@ -1209,7 +1283,7 @@ SQLRETURN SQL_API SQLGetStmtAttr( SQLHSTMT hStmt,
 								SQLINTEGER bufferLength, SQLINTEGER *stringLength )
 {
 	TRACE ("SQLGetStmtAttr");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	if ( bufferLength <= SQL_LEN_BINARY_ATTR_OFFSET )
 		bufferLength = -bufferLength + SQL_LEN_BINARY_ATTR_OFFSET;
@@ -44,6 +44,8 @@ void trace (const char *msg);
 #define GUARD					SafeDllThread wt
 #define GUARD_ENV(arg)			GUARD
 #define GUARD_HSTMT(arg)		GUARD
+#define GUARD_HSTMT_LOCAL(arg)	GUARD
+#define GUARD_HSTMT_FETCH(arg)	GUARD
 #define GUARD_HDBC(arg)			GUARD
 #define GUARD_HDESC(arg)		GUARD
 #define GUARD_HTYPE(arg1,arg2)	GUARD
@@ -53,6 +55,8 @@ void trace (const char *msg);
 #define GUARD					SafeDllThread wt
 #define GUARD_ENV(arg)			SafeEnvThread wt((OdbcEnv*)arg)
 #define GUARD_HSTMT(arg)		SafeConnectThread wt(((OdbcStatement*)arg)->connection)
+#define GUARD_HSTMT_LOCAL(arg)	GUARD_HSTMT(arg)
+#define GUARD_HSTMT_FETCH(arg)	GUARD_HSTMT(arg)
 #define GUARD_HDBC(arg) 		SafeConnectThread wt((OdbcConnection*)arg)
 #define GUARD_HDESC(arg)		SafeConnectThread wt(((OdbcDesc*)arg)->connection)
 #define GUARD_HTYPE(arg,arg1)	SafeConnectThread wt(												\
@@ -60,11 +64,44 @@ void trace (const char *msg);
 									arg1==SQL_HANDLE_STMT ? ((OdbcStatement*)arg)->connection:		\
 									arg1==SQL_HANDLE_DESC ? ((OdbcDesc*)arg)->connection : NULL )
 
+#elif(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_STATEMENT)
+
+//
+// Calls on different statements of a connection run at the same time.
+// Those that may start or end the transaction of the connection, or
+// change what the statements share, hold the connection as well; the
+// ones that only read the result set or describe it (GUARD_HSTMT_LOCAL)
+// hold no more than their statement. In autocommit mode the fetches
+// (GUARD_HSTMT_FETCH) hold the connection too: the end of a result set
+// commits the transaction the other statements run in. The lock of the
+// statement is always taken before the one of the connection.
+//
+
+#define GUARD					SafeDllThread wt
+#define GUARD_ENV(arg)			SafeEnvThread wt((OdbcEnv*)arg)
+#define GUARD_HSTMT(arg)		SafeStatementThread wt((OdbcStatement*)arg);						\
+								SafeConnectThread wt1(((OdbcStatement*)arg)->connection)
+#define GUARD_HSTMT_LOCAL(arg)	SafeStatementThread wt((OdbcStatement*)arg)
+#define GUARD_HSTMT_FETCH(arg)	SafeStatementThread wt((OdbcStatement*)arg);						\
+								SafeConnectThread wt1(((OdbcStatement*)arg)->connection->autoCommit	\
+									? ((OdbcStatement*)arg)->connection : NULL )
+#define GUARD_HDBC(arg) 		SafeConnectThread wt((OdbcConnection*)arg)
+#define GUARD_HDESC(arg)		SafeStatementThread wt(((OdbcDesc*)arg)->statement);				\
+								SafeConnectThread wt1(((OdbcDesc*)arg)->connection)
+#define GUARD_HTYPE(arg,arg1)	SafeStatementThread wt(												\
+									arg1==SQL_HANDLE_STMT ? (OdbcStatement*)arg:					\
+									arg1==SQL_HANDLE_DESC ? ((OdbcDesc*)arg)->statement : NULL );	\
+								SafeConnectThread wt1(												\
+									arg1==SQL_HANDLE_DBC ? (OdbcConnection*)arg:					\
+									arg1==SQL_HANDLE_DESC ? ((OdbcDesc*)arg)->connection : NULL )
+
 #else
 
 #define GUARD
 #define GUARD_ENV(arg)
 #define GUARD_HSTMT(arg)
+#define GUARD_HSTMT_LOCAL(arg)
+#define GUARD_HSTMT_FETCH(arg)
 #define GUARD_HDBC(arg)
 #define GUARD_HDESC(arg)	
 #define GUARD_HTYPE(arg1,arg2)
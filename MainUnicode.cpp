@@ -243,7 +243,7 @@ SQLRETURN SQL_API SQLColAttributesW( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 								    SQLLEN *numericAttribute )
 {
 	TRACE("SQLColAttributesW");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	switch ( fieldIdentifier )
 	{
@@ -316,7 +316,7 @@ SQLRETURN SQL_API SQLDescribeColW( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 								  SQLSMALLINT *nullable )
 {
 	TRACE ("SQLDescribeColW");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	ConvertingString<> ColumnName( bufferLength, columnName, nameLength, false );
 	ColumnName.setConnection( GETCONNECT_STMT( hStmt ) );
@@ -342,7 +342,7 @@ SQLRETURN SQL_API SQLErrorW( SQLHENV hEnv,
 
 	if ( hStmt )
 	{
-		GUARD_HSTMT( hStmt );
+		GUARD_HSTMT_LOCAL( hStmt );
 		Buffer.setConnection( GETCONNECT_STMT( hStmt ) );
 		return ((OdbcStatement*)hStmt)->sqlError( State, nativeErrorCode, Buffer,
 												 Buffer.getLength(), msgLength );
@@ -366,11 +366,15 @@ SQLRETURN SQL_API SQLErrorW( SQLHENV hEnv,
 SQLRETURN SQL_API SQLExecDirectW( SQLHSTMT hStmt, SQLWCHAR *statementText, SQLINTEGER textLength )
 {
 	TRACE ("SQLExecDirectW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> StatementText( GETCONNECT_STMT( hStmt ), statementText, textLength );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLEXECDIRECT, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		ConvertingString<> StatementText( GETCONNECT_STMT( hStmt ), statementText, textLength );
 
-	return ((OdbcStatement*) hStmt)->sqlExecDirect( StatementText, StatementText.getLength() );
+		return ((OdbcStatement*) hStmt)->sqlExecDirect( StatementText, StatementText.getLength() );
+	} );
 }
 
 ///// SQLGetCursorNameW /////	ODBC 1.0	///// ISO 92
@@ -379,7 +383,7 @@ SQLRETURN SQL_API SQLGetCursorNameW( SQLHSTMT hStmt, SQLWCHAR *cursorName,
 									SQLSMALLINT bufferLength,  SQLSMALLINT *nameLength )
 {
 	TRACE ("SQLGetCursorNameW");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	bool isByte = false;
 	ConvertingString<> CursorName( bufferLength, cursorName, nameLength, isByte );
@@ -394,11 +398,15 @@ SQLRETURN SQL_API SQLPrepareW( SQLHSTMT hStmt,
 							 SQLWCHAR *statementText, SQLINTEGER textLength )
 {
 	TRACE ("SQLPrepareW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> StatementText( GETCONNECT_STMT( hStmt ), statementText, textLength );
-	
-	return ((OdbcStatement*) hStmt)->sqlPrepare( StatementText, StatementText.getLength() );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPREPARE, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		ConvertingString<> StatementText( GETCONNECT_STMT( hStmt ), statementText, textLength );
+
+		return ((OdbcStatement*) hStmt)->sqlPrepare( StatementText, StatementText.getLength() );
+	} );
 }
 
 ///// SQLSetCursorNameW /////	ODBC 1.0	///// ISO 92
@@ -423,17 +431,21 @@ SQLRETURN SQL_API SQLColumnsW( SQLHSTMT hStmt,
 							  SQLWCHAR *columnName, SQLSMALLINT nameLength4 )
 {
 	TRACE ("SQLColumnsW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
-	ConvertingString<> ColumnName( GETCONNECT_STMT( hStmt ), columnName, nameLength4 );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLCOLUMNS, [=]
+	{
+		GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlColumns( CatalogName, CatalogName.getLength(),
-												SchemaName, SchemaName.getLength(),
-												TableName, TableName.getLength(),
-												ColumnName, ColumnName.getLength() );
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
+		ConvertingString<> ColumnName( GETCONNECT_STMT( hStmt ), columnName, nameLength4 );
+
+		return ((OdbcStatement*) hStmt)->sqlColumns( CatalogName, CatalogName.getLength(),
+													SchemaName, SchemaName.getLength(),
+													TableName, TableName.getLength(),
+													ColumnName, ColumnName.getLength() );
+	} );
 }
 
 ///// SQLDriverConnectW /////
@@ -574,9 +586,13 @@ SQLRETURN SQL_API SQLGetInfoW( SQLHDBC hDbc, SQLUSMALLINT infoType, SQLPOINTER i
 SQLRETURN SQL_API SQLGetTypeInfoW( SQLHSTMT hStmt, SQLSMALLINT dataType )
 {
 	TRACE ("SQLGetTypeInfoW");
-	GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlGetTypeInfo( dataType );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLGETTYPEINFO, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		return ((OdbcStatement*) hStmt)->sqlGetTypeInfo( dataType );
+	} );
 }
 
 ///// SQLSetConnectOptionW /////  Level 1	///// Deprecated
@@ -614,17 +630,21 @@ SQLRETURN SQL_API SQLSpecialColumnsW( SQLHSTMT hStmt, SQLUSMALLINT identifierTyp
 									 SQLUSMALLINT scope, SQLUSMALLINT nullable )
 {
 	TRACE ("SQLSpecialColumnsW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLSPECIALCOLUMNS, [=]
+	{
+		GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlSpecialColumns( identifierType,
-														CatalogName, CatalogName.getLength(),
-														SchemaName, SchemaName.getLength(),
-														TableName, TableName.getLength(),
-														scope, nullable);
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
+
+		return ((OdbcStatement*) hStmt)->sqlSpecialColumns( identifierType,
+															CatalogName, CatalogName.getLength(),
+															SchemaName, SchemaName.getLength(),
+															TableName, TableName.getLength(),
+															scope, nullable);
+	} );
 }
 
 ///// SQLStatisticsW /////
@@ -636,16 +656,20 @@ SQLRETURN SQL_API SQLStatisticsW( SQLHSTMT hStmt,
 								 SQLUSMALLINT unique, SQLUSMALLINT reserved )
 {
 	TRACE ("SQLStatisticsW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLSTATISTICS, [=]
+	{
+		GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlStatistics( CatalogName, CatalogName.getLength(),
-													SchemaName, SchemaName.getLength(),
-													TableName, TableName.getLength(),
-													unique, reserved );
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
+
+		return ((OdbcStatement*) hStmt)->sqlStatistics( CatalogName, CatalogName.getLength(),
+														SchemaName, SchemaName.getLength(),
+														TableName, TableName.getLength(),
+														unique, reserved );
+	} );
 }
 
 ///// SQLTablesW /////
@@ -657,17 +681,21 @@ SQLRETURN SQL_API SQLTablesW( SQLHSTMT hStmt,
 							 SQLWCHAR *tableType, SQLSMALLINT nameLength4 )
 {
 	TRACE ("SQLTablesW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
-	ConvertingString<> TableType( GETCONNECT_STMT( hStmt ), tableType, nameLength4 );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLTABLES, [=]
+	{
+		GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlTables( CatalogName, CatalogName.getLength(),
-												SchemaName, SchemaName.getLength(),
-												TableName, TableName.getLength(),
-												TableType, TableType.getLength() );
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), catalogName, nameLength1 );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), schemaName, nameLength2 );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), tableName, nameLength3 );
+		ConvertingString<> TableType( GETCONNECT_STMT( hStmt ), tableType, nameLength4 );
+
+		return ((OdbcStatement*) hStmt)->sqlTables( CatalogName, CatalogName.getLength(),
+													SchemaName, SchemaName.getLength(),
+													TableName, TableName.getLength(),
+													TableType, TableType.getLength() );
+	} );
 }
 
 ///// SQLBrowseConnectW /////
@@ -721,21 +749,25 @@ SQLRETURN SQL_API SQLForeignKeysW( SQLHSTMT hStmt,
 								  SQLWCHAR *szFkTableName, SQLSMALLINT cbFkTableName )
 {
 	TRACE ("SQLForeignKeysW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> PkCatalogName( GETCONNECT_STMT( hStmt ), szPkCatalogName, cbPkCatalogName );
-	ConvertingString<> PkSchemaName( GETCONNECT_STMT( hStmt ), szPkSchemaName, cbPkSchemaName );
-	ConvertingString<> PkTableName( GETCONNECT_STMT( hStmt ), szPkTableName, cbPkTableName );
-	ConvertingString<> FkCatalogName( GETCONNECT_STMT( hStmt ), szFkCatalogName, cbFkCatalogName );
-	ConvertingString<> FkSchemaName( GETCONNECT_STMT( hStmt ), szFkSchemaName, cbFkSchemaName );
-	ConvertingString<> FkTableName( GETCONNECT_STMT( hStmt ), szFkTableName, cbFkTableName );
-
-	return ((OdbcStatement*) hStmt)->sqlForeignKeys( PkCatalogName, PkCatalogName.getLength(),
-													PkSchemaName, PkSchemaName.getLength(),
-													PkTableName, PkTableName.getLength(),
-													FkCatalogName, FkCatalogName.getLength(),
-													FkSchemaName, FkSchemaName.getLength(),
-													FkTableName, FkTableName.getLength() );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLFOREIGNKEYS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		ConvertingString<> PkCatalogName( GETCONNECT_STMT( hStmt ), szPkCatalogName, cbPkCatalogName );
+		ConvertingString<> PkSchemaName( GETCONNECT_STMT( hStmt ), szPkSchemaName, cbPkSchemaName );
+		ConvertingString<> PkTableName( GETCONNECT_STMT( hStmt ), szPkTableName, cbPkTableName );
+		ConvertingString<> FkCatalogName( GETCONNECT_STMT( hStmt ), szFkCatalogName, cbFkCatalogName );
+		ConvertingString<> FkSchemaName( GETCONNECT_STMT( hStmt ), szFkSchemaName, cbFkSchemaName );
+		ConvertingString<> FkTableName( GETCONNECT_STMT( hStmt ), szFkTableName, cbFkTableName );
+
+		return ((OdbcStatement*) hStmt)->sqlForeignKeys( PkCatalogName, PkCatalogName.getLength(),
+														PkSchemaName, PkSchemaName.getLength(),
+														PkTableName, PkTableName.getLength(),
+														FkCatalogName, FkCatalogName.getLength(),
+														FkSchemaName, FkSchemaName.getLength(),
+														FkTableName, FkTableName.getLength() );
+	} );
 }
 
 ///// SQLNativeSqlW /////
@@ -770,15 +802,19 @@ SQLRETURN SQL_API SQLPrimaryKeysW( SQLHSTMT hStmt,
 								  SQLWCHAR *szTableName, SQLSMALLINT cbTableName )
 {
 	TRACE ("SQLPrimaryKeysW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), szTableName, cbTableName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPRIMARYKEYS, [=]
+	{
+		GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlPrimaryKeys( CatalogName, CatalogName.getLength(),
-													SchemaName, SchemaName.getLength(),
-													TableName, TableName.getLength() );
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), szTableName, cbTableName );
+
+		return ((OdbcStatement*) hStmt)->sqlPrimaryKeys( CatalogName, CatalogName.getLength(),
+														SchemaName, SchemaName.getLength(),
+														TableName, TableName.getLength() );
+	} );
 }
 
 ///// SQLProcedureColumnsW /////
@@ -790,17 +826,21 @@ SQLRETURN SQL_API SQLProcedureColumnsW( SQLHSTMT hStmt,
 									   SQLWCHAR *szColumnName, SQLSMALLINT cbColumnName )
 {
 	TRACE ("SQLProcedureColumnsW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
-	ConvertingString<> ProcName( GETCONNECT_STMT( hStmt ), szProcName, cbProcName );
-	ConvertingString<> ColumnName( GETCONNECT_STMT( hStmt ), szColumnName, cbColumnName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPROCEDURECOLUMNS, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
+		ConvertingString<> ProcName( GETCONNECT_STMT( hStmt ), szProcName, cbProcName );
+		ConvertingString<> ColumnName( GETCONNECT_STMT( hStmt ), szColumnName, cbColumnName );
 
-	return ((OdbcStatement*) hStmt)->sqlProcedureColumns( CatalogName, CatalogName.getLength(),
-														 SchemaName, SchemaName.getLength(),
-														 ProcName, ProcName.getLength(),
-														 ColumnName, ColumnName.getLength() );
+		return ((OdbcStatement*) hStmt)->sqlProcedureColumns( CatalogName, CatalogName.getLength(),
+															 SchemaName, SchemaName.getLength(),
+															 ProcName, ProcName.getLength(),
+															 ColumnName, ColumnName.getLength() );
+	} );
 }
 
 ///// SQLProceduresW /////
@@ -811,15 +851,19 @@ SQLRETURN SQL_API SQLProceduresW( SQLHSTMT hStmt,
 								 SQLWCHAR *szProcName, SQLSMALLINT cbProcName )
 {
 	TRACE ("SQLProceduresW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
-	ConvertingString<> ProcName( GETCONNECT_STMT( hStmt ), szProcName, cbProcName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLPROCEDURES, [=]
+	{
+		GUARD_HSTMT( hStmt );
 
-	return ((OdbcStatement*) hStmt)->sqlProcedures( CatalogName, CatalogName.getLength(),
-												   SchemaName, SchemaName.getLength(),
-												   ProcName, ProcName.getLength() );
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
+		ConvertingString<> ProcName( GETCONNECT_STMT( hStmt ), szProcName, cbProcName );
+
+		return ((OdbcStatement*) hStmt)->sqlProcedures( CatalogName, CatalogName.getLength(),
+													   SchemaName, SchemaName.getLength(),
+													   ProcName, ProcName.getLength() );
+	} );
 }
 
 ///// SQLTablePrivilegesW /////
@@ -830,15 +874,19 @@ SQLRETURN SQL_API SQLTablePrivilegesW( SQLHSTMT hStmt,
 									  SQLWCHAR *szTableName, SQLSMALLINT cbTableName )
 {
 	TRACE ("SQLTablePrivilegesW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), szTableName, cbTableName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLTABLEPRIVILEGES, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), szTableName, cbTableName );
 
-	return ((OdbcStatement*) hStmt)->sqlTablePrivileges( CatalogName, CatalogName.getLength(),
-														SchemaName, SchemaName.getLength(),
-														TableName, TableName.getLength() );
+		return ((OdbcStatement*) hStmt)->sqlTablePrivileges( CatalogName, CatalogName.getLength(),
+															SchemaName, SchemaName.getLength(),
+															TableName, TableName.getLength() );
+	} );
 }
 
 ///// SQLColumnPrivilegesW /////
@@ -850,17 +898,21 @@ SQLRETURN SQL_API SQLColumnPrivilegesW( SQLHSTMT hStmt,
 									   SQLWCHAR *szColumnName, SQLSMALLINT cbColumnName )
 {
 	TRACE ("SQLColumnPrivilegesW");
-	GUARD_HSTMT( hStmt );
 
-	ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
-	ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
-	ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), szTableName, cbTableName );
-	ConvertingString<> ColumnName( GETCONNECT_STMT( hStmt ), szColumnName, cbColumnName );
+	return ((OdbcStatement*) hStmt)->asyncCall( SQL_API_SQLCOLUMNPRIVILEGES, [=]
+	{
+		GUARD_HSTMT( hStmt );
+
+		ConvertingString<> CatalogName( GETCONNECT_STMT( hStmt ), szCatalogName, cbCatalogName );
+		ConvertingString<> SchemaName( GETCONNECT_STMT( hStmt ), szSchemaName, cbSchemaName );
+		ConvertingString<> TableName( GETCONNECT_STMT( hStmt ), szTableName, cbTableName );
+		ConvertingString<> ColumnName( GETCONNECT_STMT( hStmt ), szColumnName, cbColumnName );
 
-	return ((OdbcStatement*) hStmt)->sqlColumnPrivileges( CatalogName, CatalogName.getLength(),
-														 SchemaName, SchemaName.getLength(),
-														 TableName, TableName.getLength(),
-														 ColumnName, ColumnName.getLength() );
+		return ((OdbcStatement*) hStmt)->sqlColumnPrivileges( CatalogName, CatalogName.getLength(),
+															 SchemaName, SchemaName.getLength(),
+															 TableName, TableName.getLength(),
+															 ColumnName, ColumnName.getLength() );
+	} );
 }
 
 ///// SQLDriversW /////
@@ -894,7 +946,7 @@ SQLRETURN SQL_API SQLColAttributeW( SQLHSTMT hStmt, SQLUSMALLINT columnNumber,
 #endif
 {
 	TRACE ("SQLColAttributeW");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	switch ( fieldIdentifier )
 	{
@@ -1080,7 +1132,7 @@ SQLRETURN SQL_API SQLGetStmtAttrW( SQLHSTMT hStmt,
 								  SQLINTEGER bufferLength, SQLINTEGER *stringLength )
 {
 	TRACE ("SQLGetStmtAttrW");
-	GUARD_HSTMT( hStmt );
+	GUARD_HSTMT_LOCAL( hStmt );
 
 	switch ( attribute )
 	{
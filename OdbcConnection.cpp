@@ -325,6 +325,8 @@ OdbcConnection::OdbcConnection(OdbcEnv *parent)
 	enableCompatBind    = true;
 	setCompatBindStr    = NULL;
 	enableWireCompression = false;
+	serverScrollableCursor = false;
+	readOnlyQueries = false;
 
 #ifdef _WINDOWS
 #if _MSC_VER > 1000
@@ -449,6 +451,13 @@ SQLRETURN OdbcConnection::sqlSetConnectAttr( SQLINTEGER attribute, SQLPOINTER va
 		//Added by CA
 	case SQL_ATTR_ASYNC_ENABLE:
 		asyncEnabled = (intptr_t) value;
+		{
+			// it applies to the statements allocated already as well
+			std::lock_guard<std::mutex> guard( listMutex );
+
+			for ( OdbcStatement *statement = statements; statement; statement = (OdbcStatement*)statement->next )
+				statement->asyncEnable = asyncEnabled == SQL_ASYNC_ENABLE_ON;
+		}
 		break;
 
 	case SQL_ATTR_ACCESS_MODE:
@@ -621,6 +630,18 @@ SQLRETURN OdbcConnection::sqlDriverConnect(SQLHWND hWnd, const SQLCHAR * connect
 
 			defOptions |= DEF_NOWAIT_TPB;
 		}
+		else if ( IS_KEYWORD( SETUP_AUTOCOMMIT_TPB ) )
+		{
+			if( *value == 'Y')
+				optTpb |=TRA_autocommit;
+
+			defOptions |= DEF_AUTOCOMMIT_TPB;
+		}
+		else if ( IS_KEYWORD( SETUP_READONLY_QUERIES ) )
+		{
+			readOnlyQueries = *value == 'Y';
+			defOptions |= DEF_READONLY_QUERIES;
+		}
 		else if ( IS_KEYWORD( KEY_DSN_QUOTED ) || IS_KEYWORD( SETUP_QUOTED ) )
 		{
 			if( *value == 'N')
@@ -646,6 +667,22 @@ SQLRETURN OdbcConnection::sqlDriverConnect(SQLHWND hWnd, const SQLCHAR * connect
 			useSchemaIdentifier = value;
 		else if ( IS_KEYWORD( KEY_DSN_LOCKTIMEOUT ) || IS_KEYWORD( SETUP_LOCKTIMEOUT ) )
 			useLockTimeoutWaitTransactions = value;
+		else if ( IS_KEYWORD( KEY_DSN_READAHEAD ) || IS_KEYWORD( SETUP_READAHEAD ) )
+			readAheadRows = value;
+		else if ( IS_KEYWORD( KEY_DSN_STATICMEMORY ) || IS_KEYWORD( SETUP_STATICMEMORY ) )
+			staticCursorMemory = value;
+		else if ( IS_KEYWORD( KEY_DSN_BLOBCACHE ) || IS_KEYWORD( SETUP_BLOBCACHE ) )
+			blobCacheMemory = value;
+		else if ( IS_KEYWORD( KEY_DSN_STMTCACHE ) || IS_KEYWORD( SETUP_STMTCACHE ) )
+			statementCacheSize = value;
+		else if ( IS_KEYWORD( KEY_DSN_STMTCACHEMEMORY ) || IS_KEYWORD( SETUP_STMTCACHEMEMORY ) )
+			statementCacheMemory = value;
+		else if ( IS_KEYWORD( KEY_DSN_POOL ) || IS_KEYWORD( SETUP_POOL ) )
+			poolSize = value;
+		else if ( IS_KEYWORD( KEY_DSN_POOLIDLETIMEOUT ) || IS_KEYWORD( SETUP_POOLIDLETIMEOUT ) )
+			poolIdleTimeout = value;
+		else if ( IS_KEYWORD( KEY_DSN_POOLLIFETIME ) || IS_KEYWORD( SETUP_POOLLIFETIME ) )
+			poolLifetime = value;
 		else if ( IS_KEYWORD( KEY_DSN_SAFETHREAD ) || IS_KEYWORD( SETUP_SAFETHREAD ) )
 		{
 			if( *value == 'N')
@@ -669,6 +706,11 @@ SQLRETURN OdbcConnection::sqlDriverConnect(SQLHWND hWnd, const SQLCHAR * connect
 
 			defOptions |= DEF_WIRECOMPRESSION;
 		}
+		else if ( IS_KEYWORD( KEY_DSN_SERVERSCROLL ) || IS_KEYWORD( SETUP_SERVERSCROLL ) )
+		{
+			serverScrollableCursor = *value == 'Y';
+			defOptions |= DEF_SERVERSCROLL;
+		}
 		else if ( IS_KEYWORD( "ODBC" ) )
 			;
 		else
@@ -1577,6 +1619,7 @@ SQLRETURN OdbcConnection::allocHandle(int handleType, SQLHANDLE * outputHandle)
 		*outputHandle = SQL_NULL_HDBC;
 
 		OdbcStatement *statement = new OdbcStatement (this, statementNumber++);
+		std::lock_guard<std::mutex> guard( listMutex );
 		statement->next = statements;
 		statements = statement;
 		*outputHandle = (SQLHANDLE)statement;
@@ -1695,6 +1738,24 @@ SQLRETURN OdbcConnection::connect(const char *sharedLibrary, const char * databa
 
 		properties->putValue("EnableWireCompression", enableWireCompression ? "Y" : "N");
 
+		if (statementCacheSize)
+			properties->putValue ("statementCache", statementCacheSize);
+
+		if (statementCacheMemory)
+			properties->putValue ("statementCacheMemory", statementCacheMemory);
+
+		if (readOnlyQueries)
+			properties->putValue ("readOnlyQueries", "Y");
+
+		if (poolSize)
+			properties->putValue ("poolSize", poolSize);
+
+		if (poolIdleTimeout)
+			properties->putValue ("poolIdleTimeout", poolIdleTimeout);
+
+		if (poolLifetime)
+			properties->putValue ("poolLifetime", poolLifetime);
+
 		connection->openDatabase (databaseName, properties);
 		properties->release();
 
@@ -1776,6 +1837,8 @@ SQLRETURN OdbcConnection::sqlExecuteCreateDatabase(const char * sqlString)
 
 void OdbcConnection::statementDeleted(OdbcStatement * statement)
 {
+	std::lock_guard<std::mutex> guard( listMutex );
+
 	for (OdbcObject **ptr = (OdbcObject**) &statements; *ptr; ptr =&((*ptr)->next))
 		if (*ptr == statement)
 		{
@@ -1812,6 +1875,22 @@ void OdbcConnection::expandConnectParameters()
 				enableWireCompression = true;
 		}
 
+		if (!(defOptions & DEF_SERVERSCROLL))
+		{
+			options = readAttribute(SETUP_SERVERSCROLL);
+
+			if (*(const char*)options == 'Y')
+				serverScrollableCursor = true;
+		}
+
+		if (!(defOptions & DEF_READONLY_QUERIES))
+		{
+			options = readAttribute(SETUP_READONLY_QUERIES);
+
+			if (*(const char*)options == 'Y')
+				readOnlyQueries = true;
+		}
+
 		if (databaseName.IsEmpty())
 			databaseName = readAttribute (SETUP_DBNAME);
 
@@ -1860,6 +1939,14 @@ void OdbcConnection::expandConnectParameters()
 				optTpb |=TRA_nw;
 		}
 
+		if ( !(defOptions & DEF_AUTOCOMMIT_TPB) )
+		{
+			options = readAttribute(SETUP_AUTOCOMMIT_TPB);
+
+			if(*(const char *)options == 'Y')
+				optTpb |=TRA_autocommit;
+		}
+
 		if ( !(defOptions & DEF_DIALECT) )
 		{
 			options = readAttribute(SETUP_DIALECT);
@@ -1874,6 +1961,30 @@ void OdbcConnection::expandConnectParameters()
 		if (useLockTimeoutWaitTransactions.IsEmpty())
 			useLockTimeoutWaitTransactions = readAttribute(SETUP_LOCKTIMEOUT);
 
+		if (readAheadRows.IsEmpty())
+			readAheadRows = readAttribute(SETUP_READAHEAD);
+
+		if (staticCursorMemory.IsEmpty())
+			staticCursorMemory = readAttribute(SETUP_STATICMEMORY);
+
+		if (blobCacheMemory.IsEmpty())
+			blobCacheMemory = readAttribute(SETUP_BLOBCACHE);
+
+		if (statementCacheSize.IsEmpty())
+			statementCacheSize = readAttribute(SETUP_STMTCACHE);
+
+		if (statementCacheMemory.IsEmpty())
+			statementCacheMemory = readAttribute(SETUP_STMTCACHEMEMORY);
+
+		if (poolSize.IsEmpty())
+			poolSize = readAttribute(SETUP_POOL);
+
+		if (poolIdleTimeout.IsEmpty())
+			poolIdleTimeout = readAttribute(SETUP_POOLIDLETIMEOUT);
+
+		if (poolLifetime.IsEmpty())
+			poolLifetime = readAttribute(SETUP_POOLLIFETIME);
+
 		if ( !(defOptions & DEF_SAFETHREAD) )
 		{
 			options = readAttribute(SETUP_SAFETHREAD);
@@ -1932,6 +2043,22 @@ void OdbcConnection::expandConnectParameters()
 				enableWireCompression = true;
 		}
 
+		if (!(defOptions & DEF_SERVERSCROLL))
+		{
+			options = readAttributeFileDSN(SETUP_SERVERSCROLL);
+
+			if (*(const char*)options == 'Y')
+				serverScrollableCursor = true;
+		}
+
+		if (!(defOptions & DEF_READONLY_QUERIES))
+		{
+			options = readAttributeFileDSN(SETUP_READONLY_QUERIES);
+
+			if (*(const char*)options == 'Y')
+				readOnlyQueries = true;
+		}
+
 		if (databaseName.IsEmpty())
 			databaseName = readAttributeFileDSN (SETUP_DBNAME);
 
@@ -1980,6 +2107,14 @@ void OdbcConnection::expandConnectParameters()
 				optTpb |=TRA_nw;
 		}
 
+		if ( !(defOptions & DEF_AUTOCOMMIT_TPB) )
+		{
+			options = readAttributeFileDSN (SETUP_AUTOCOMMIT_TPB);
+
+			if(*(const char *)options == 'Y')
+				optTpb |=TRA_autocommit;
+		}
+
 		if ( !(defOptions & DEF_DIALECT) )
 		{
 			options = readAttributeFileDSN (SETUP_DIALECT);
@@ -1994,6 +2129,30 @@ void OdbcConnection::expandConnectParameters()
 		if (useLockTimeoutWaitTransactions.IsEmpty())
 			useLockTimeoutWaitTransactions = readAttributeFileDSN (SETUP_LOCKTIMEOUT);
 
+		if (readAheadRows.IsEmpty())
+			readAheadRows = readAttributeFileDSN (SETUP_READAHEAD);
+
+		if (staticCursorMemory.IsEmpty())
+			staticCursorMemory = readAttributeFileDSN (SETUP_STATICMEMORY);
+
+		if (blobCacheMemory.IsEmpty())
+			blobCacheMemory = readAttributeFileDSN (SETUP_BLOBCACHE);
+
+		if (statementCacheSize.IsEmpty())
+			statementCacheSize = readAttributeFileDSN (SETUP_STMTCACHE);
+
+		if (statementCacheMemory.IsEmpty())
+			statementCacheMemory = readAttributeFileDSN (SETUP_STMTCACHEMEMORY);
+
+		if (poolSize.IsEmpty())
+			poolSize = readAttributeFileDSN (SETUP_POOL);
+
+		if (poolIdleTimeout.IsEmpty())
+			poolIdleTimeout = readAttributeFileDSN (SETUP_POOLIDLETIMEOUT);
+
+		if (poolLifetime.IsEmpty())
+			poolLifetime = readAttributeFileDSN (SETUP_POOLLIFETIME);
+
 		if ( !(defOptions & DEF_SAFETHREAD) )
 		{
 			options = readAttribute(SETUP_SAFETHREAD);
@@ -2050,16 +2209,27 @@ void OdbcConnection::saveConnectParameters()
 	writeAttributeFileDSN (SETUP_JDBC_DRIVER, jdbcDriver);
 	writeAttributeFileDSN (SETUP_READONLY_TPB, (optTpb & TRA_ro) ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_NOWAIT_TPB, (optTpb & TRA_nw) ? "Y" : "N");
+	writeAttributeFileDSN (SETUP_AUTOCOMMIT_TPB, (optTpb & TRA_autocommit) ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_DIALECT, dialect3 ? "3" : "1");
 	writeAttributeFileDSN (SETUP_QUOTED, quotedIdentifier ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_SENSITIVE, sensitiveIdentifier ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_AUTOQUOTED, autoQuotedIdentifier ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_USESCHEMA, useSchemaIdentifier);
 	writeAttributeFileDSN (SETUP_LOCKTIMEOUT, useLockTimeoutWaitTransactions);
+	writeAttributeFileDSN (SETUP_READAHEAD, readAheadRows);
+	writeAttributeFileDSN (SETUP_STATICMEMORY, staticCursorMemory);
+	writeAttributeFileDSN (SETUP_BLOBCACHE, blobCacheMemory);
+	writeAttributeFileDSN (SETUP_STMTCACHE, statementCacheSize);
+	writeAttributeFileDSN (SETUP_STMTCACHEMEMORY, statementCacheMemory);
+	writeAttributeFileDSN (SETUP_POOL, poolSize);
+	writeAttributeFileDSN (SETUP_POOLIDLETIMEOUT, poolIdleTimeout);
+	writeAttributeFileDSN (SETUP_POOLLIFETIME, poolLifetime);
 	writeAttributeFileDSN (SETUP_SAFETHREAD, safeThread ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_ENABLE_COMPAT_BIND, enableCompatBind ? "Y" : "N");
 	writeAttributeFileDSN (SETUP_SET_COMPAT_BIND, setCompatBindStr);
 	writeAttributeFileDSN (SETUP_ENABLE_WIRECOMPRESSION, enableWireCompression ? "Y" : "N");
+	writeAttributeFileDSN (SETUP_SERVERSCROLL, serverScrollableCursor ? "Y" : "N");
+	writeAttributeFileDSN (SETUP_READONLY_QUERIES, readOnlyQueries ? "Y" : "N");
 
 	char buffer[256];
 	CSecurityPassword security;
@@ -2067,9 +2237,12 @@ void OdbcConnection::saveConnectParameters()
 	writeAttributeFileDSN (SETUP_PASSWORD, buffer);
 }
 
-OdbcDesc* OdbcConnection::allocDescriptor(OdbcDescType type)
+OdbcDesc* OdbcConnection::allocDescriptor(OdbcDescType type, OdbcStatement *statement)
 {
 	OdbcDesc *descriptor = new OdbcDesc (type, this);
+	descriptor->statement = statement;
+
+	std::lock_guard<std::mutex> guard( listMutex );
 	descriptor->next = descriptors;
 	descriptors = descriptor;
 
@@ -2078,6 +2251,8 @@ OdbcDesc* OdbcConnection::allocDescriptor(OdbcDescType type)
 
 void OdbcConnection::descriptorDeleted(OdbcDesc * descriptor)
 {
+	std::lock_guard<std::mutex> guard( listMutex );
+
 	for (OdbcDesc **ptr = &descriptors; *ptr; ptr = (OdbcDesc**)&(*ptr)->next)
 		if (*ptr == descriptor)
 		{
@@ -2129,6 +2304,63 @@ SQLRETURN OdbcConnection::sqlGetConnectAttr(int attribute, SQLPOINTER ptr, int b
 		string = databaseName;
 		break;
 
+	case SQL_FBGETCONN_STMT_CACHE_HITS:
+	case SQL_FBGETCONN_STMT_CACHE_MISSES:
+	case SQL_FBGETCONN_STMT_CACHE_ENTRIES:
+		{
+			int hits = 0, misses = 0, entries = 0;
+
+			if ( connection )
+				connection->getStatementCacheStatistics( hits, misses, entries );
+
+			value = attribute == SQL_FBGETCONN_STMT_CACHE_HITS ? hits
+					: attribute == SQL_FBGETCONN_STMT_CACHE_MISSES ? misses
+					: entries;
+		}
+		break;
+
+	case SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS:
+	case SQL_FBGETCONN_NATIVE_SQL_CACHE_MISSES:
+	case SQL_FBGETCONN_NATIVE_SQL_CACHE_ENTRIES:
+		{
+			int hits = 0, misses = 0, entries = 0;
+
+			if ( connection )
+				connection->getNativeSqlCacheStatistics( hits, misses, entries );
+
+			value = attribute == SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS ? hits
+					: attribute == SQL_FBGETCONN_NATIVE_SQL_CACHE_MISSES ? misses
+					: entries;
+		}
+		break;
+
+	case SQL_FBGETCONN_POOL_HITS:
+	case SQL_FBGETCONN_POOL_MISSES:
+	case SQL_FBGETCONN_POOL_IDLE:
+		{
+			int hits = 0, misses = 0, idle = 0;
+
+			if ( connection )
+				connection->getConnectionPoolStatistics( hits, misses, idle );
+
+			value = attribute == SQL_FBGETCONN_POOL_HITS ? hits
+					: attribute == SQL_FBGETCONN_POOL_MISSES ? misses
+					: idle;
+		}
+		break;
+
+	case SQL_FBGETCONN_CLIENT_LOADS:
+	case SQL_FBGETCONN_CLIENT_USERS:
+		{
+			int loads = 0, users = 0;
+
+			if ( connection )
+				connection->getClientLibraryStatistics( loads, users );
+
+			value = attribute == SQL_FBGETCONN_CLIENT_LOADS ? loads : users;
+		}
+		break;
+
 	case SQL_LOGIN_TIMEOUT:			//   103
 	case SQL_OPT_TRACE:				//   104
 	case SQL_OPT_TRACEFILE:			//   105
@@ -28,6 +28,7 @@
 #if defined(__GNUC__)
 #include <inttypes.h>
 #endif
+#include <mutex>
 
 #include "OdbcDesc.h"
 #include "IscDbc/JString.h"
@@ -51,12 +52,15 @@ class OdbcConnection : public OdbcObject
 		DEF_SAFETHREAD = 64,
 		DEF_COMPATMODE = 128,
 		DEF_WIRECOMPRESSION = 256,
+		DEF_SERVERSCROLL = 512,
+		DEF_AUTOCOMMIT_TPB = 1024,
+		DEF_READONLY_QUERIES = 2048,
 	};
 
 public:
 	SQLRETURN sqlGetConnectAttr (int attribute, SQLPOINTER ptr, int bufferLength, SQLINTEGER * lengthPtr);
 	void descriptorDeleted (OdbcDesc* descriptor);
-	OdbcDesc* allocDescriptor(OdbcDescType type);
+	OdbcDesc* allocDescriptor(OdbcDescType type, OdbcStatement *statement = NULL);
 	void expandConnectParameters();
 	void saveConnectParameters();
 	void statementDeleted (OdbcStatement *statement);
@@ -111,6 +115,7 @@ public:
 	Connection	*connection;
 	OdbcStatement*	statements;
 	OdbcDesc*	descriptors;
+	std::mutex	listMutex;			// statements and descriptors
 	UserEvents	*userEvents;
 	bool		connected;
 	bool		safeThread;
@@ -132,10 +137,20 @@ public:
 	JString		setCompatBindStr;
 	bool		enableCompatBind;
 	bool		enableWireCompression;
+	bool		serverScrollableCursor;
+	bool		readOnlyQueries;
 	int			optTpb;
 	int			defOptions;
 	JString		useSchemaIdentifier;
 	JString		useLockTimeoutWaitTransactions;
+	JString		readAheadRows;
+	JString		staticCursorMemory;
+	JString		blobCacheMemory;
+	JString		statementCacheSize;
+	JString		statementCacheMemory;
+	JString		poolSize;
+	JString		poolIdleTimeout;
+	JString		poolLifetime;
 	bool		quotedIdentifier;
 	bool		sensitiveIdentifier;
 	bool		autoQuotedIdentifier;
@@ -1018,6 +1018,165 @@ ADRESS_FUNCTION OdbcConvert::getAdressFunction(DescRecord * from, DescRecord * t
 	return NULL;
 }
 
+//
+// Columnar kernel for the rowset block fetch: same result as calling
+// the matching ODBCCONVERT_CONV function once per row, but the whole
+// column is done in one tight loop the compiler can unroll.
+//
+template <typename C_TYPE_FROM, typename C_TYPE_TO>
+static void convColumnBlock(const char * dataFrom, const char * indicatorFrom, size_t lengthRow,
+							char * dataTo, SQLLEN strideData, char * indicatorTo, SQLLEN strideInd, int nRows)
+{
+	for ( int n = 0; n < nRows; ++n, dataFrom += lengthRow )
+	{
+		bool isNull = indicatorFrom && *(const short*)( indicatorFrom + n * lengthRow ) == -1;
+
+		if ( indicatorTo )
+			*(SQLLEN*)( indicatorTo + n * strideInd ) = isNull ? SQL_NULL_DATA : sizeof( C_TYPE_TO );
+
+		if ( dataTo )
+			*(C_TYPE_TO*)( dataTo + n * strideData ) = isNull ? (C_TYPE_TO)0 : (C_TYPE_TO)*(const C_TYPE_FROM*)dataFrom;
+	}
+}
+
+//
+// The conversions done by a plain ODBCCONVERT_CONV cast, with the
+// kernel doing the same cast for a whole column.
+//
+#define COLUMN_BLOCK_CONV(TYPE_FROM,C_TYPE_FROM,TYPE_TO,C_TYPE_TO)		\
+	{ &OdbcConvert::conv##TYPE_FROM##To##TYPE_TO, &convColumnBlock<C_TYPE_FROM, C_TYPE_TO> }
+
+static const struct
+{
+	ADRESS_FUNCTION			fnConv;
+	COLUMN_BLOCK_FUNCTION	fnBlock;
+} columnBlockConv[] =
+{
+	COLUMN_BLOCK_CONV(TinyInt,char,Boolean,bool),
+	COLUMN_BLOCK_CONV(TinyInt,char,TinyInt,char),
+	COLUMN_BLOCK_CONV(TinyInt,unsigned char,Short,short),
+	COLUMN_BLOCK_CONV(TinyInt,unsigned char,Long,int),
+	COLUMN_BLOCK_CONV(TinyInt,unsigned char,Float,float),
+	COLUMN_BLOCK_CONV(TinyInt,unsigned char,Double,double),
+	COLUMN_BLOCK_CONV(TinyInt,unsigned char,Bigint,QUAD),
+
+	COLUMN_BLOCK_CONV(Short,short,Boolean,bool),
+	COLUMN_BLOCK_CONV(Short,short,TinyInt,char),
+	COLUMN_BLOCK_CONV(Short,short,Short,short),
+	COLUMN_BLOCK_CONV(Short,short,Long,int),
+	COLUMN_BLOCK_CONV(Short,short,Float,float),
+	COLUMN_BLOCK_CONV(Short,short,Double,double),
+	COLUMN_BLOCK_CONV(Short,short,Bigint,QUAD),
+
+	COLUMN_BLOCK_CONV(Long,int,Boolean,bool),
+	COLUMN_BLOCK_CONV(Long,int,TinyInt,char),
+	COLUMN_BLOCK_CONV(Long,int,Short,short),
+	COLUMN_BLOCK_CONV(Long,int,Long,int),
+	COLUMN_BLOCK_CONV(Long,int,Float,float),
+	COLUMN_BLOCK_CONV(Long,int,Double,double),
+	COLUMN_BLOCK_CONV(Long,int,Bigint,QUAD),
+
+	COLUMN_BLOCK_CONV(Float,float,Boolean,bool),
+	COLUMN_BLOCK_CONV(Float,float,Float,float),
+	COLUMN_BLOCK_CONV(Float,float,Double,double),
+
+	COLUMN_BLOCK_CONV(Double,double,Boolean,bool),
+	COLUMN_BLOCK_CONV(Double,double,Float,float),
+	COLUMN_BLOCK_CONV(Double,double,Double,double),
+
+	COLUMN_BLOCK_CONV(Numeric,QUAD,Boolean,bool),
+	COLUMN_BLOCK_CONV(Numeric,QUAD,TinyInt,char),
+	COLUMN_BLOCK_CONV(Numeric,QUAD,Short,short),
+	COLUMN_BLOCK_CONV(Numeric,QUAD,Long,int),
+	COLUMN_BLOCK_CONV(Numeric,QUAD,Float,float),
+	COLUMN_BLOCK_CONV(Numeric,QUAD,Double,double),
+	COLUMN_BLOCK_CONV(Numeric,QUAD,Bigint,QUAD),
+
+	COLUMN_BLOCK_CONV(Date,int,Long,int),
+	COLUMN_BLOCK_CONV(Date,int,Float,float),
+	COLUMN_BLOCK_CONV(Date,int,Double,double),
+	COLUMN_BLOCK_CONV(Date,int,Bigint,QUAD),
+
+	COLUMN_BLOCK_CONV(Time,int,Long,int),
+	COLUMN_BLOCK_CONV(Time,int,Float,float),
+	COLUMN_BLOCK_CONV(Time,int,Double,double),
+	COLUMN_BLOCK_CONV(Time,int,Bigint,QUAD),
+
+	COLUMN_BLOCK_CONV(DateTime,QUAD,Double,double),
+	COLUMN_BLOCK_CONV(DateTime,QUAD,Bigint,QUAD)
+};
+
+//
+// ODBCCONVERT_BIGINT_CONV is a plain cast too when the scales are the same.
+//
+static const struct
+{
+	ADRESS_FUNCTION			fnConv;
+	COLUMN_BLOCK_FUNCTION	fnBlock;
+} columnBlockBigintConv[] =
+{
+	COLUMN_BLOCK_CONV(Bigint,QUAD,Boolean,bool),
+	COLUMN_BLOCK_CONV(Bigint,QUAD,TinyInt,char),
+	COLUMN_BLOCK_CONV(Bigint,QUAD,Short,short),
+	COLUMN_BLOCK_CONV(Bigint,QUAD,Long,int),
+	COLUMN_BLOCK_CONV(Bigint,QUAD,Bigint,QUAD)
+};
+
+#undef COLUMN_BLOCK_CONV
+
+COLUMN_BLOCK_FUNCTION OdbcConvert::getColumnBlockFunction(DescRecord * from, DescRecord * to)
+{
+	if ( !from->isIndicatorSqlDa || to->isIndicatorSqlDa || from->isBlobOrArray || from->isZeroColumn )
+		return NULL;
+
+	ADRESS_FUNCTION fn = from->fnConv;
+	int n;
+
+	for ( n = 0; n < (int)( sizeof( columnBlockConv ) / sizeof( *columnBlockConv ) ); ++n )
+		if ( columnBlockConv[n].fnConv == fn )
+			return columnBlockConv[n].fnBlock;
+
+	if ( from->scale == to->scale )
+		for ( n = 0; n < (int)( sizeof( columnBlockBigintConv ) / sizeof( *columnBlockBigintConv ) ); ++n )
+			if ( columnBlockBigintConv[n].fnConv == fn )
+				return columnBlockBigintConv[n].fnBlock;
+
+	return NULL;
+}
+
+//
+// Resolves the conversion of every bound column once: the kernel, the
+// buffer addresses and the strides of the bind layout.
+//
+void OdbcConvert::buildConvertPlan(ConvertPlan &plan, CBindColumn * bindCol, int count, bool rowWise, SQLLEN rowBindType)
+{
+	plan.clear();
+	plan.steps.reserve( count );
+	plan.rowWise = rowWise;
+	plan.rowBindType = rowBindType;
+
+	for ( ; count--; bindCol++ )
+	{
+		DescRecord *imp = bindCol->impRecord;
+		DescRecord *app = bindCol->appRecord;
+		ConvertPlanStep step;
+
+		step.from = imp;
+		step.to = app;
+		step.fnBlock = imp->fnConvBlock;
+		step.dataFrom = (char*)imp->dataPtr;
+		step.indicatorFrom = (char*)imp->indicatorPtr;
+		step.dataTo = (char*)app->dataPtr;
+		step.indicatorTo = (char*)app->indicatorPtr;
+		step.strideData = rowWise ? rowBindType : app->sizeColumnExtendedFetch;
+		step.strideInd = rowWise ? rowBindType : sizeof(SQLLEN);
+
+		plan.steps.push_back( step );
+	}
+
+	plan.valid = true;
+}
+
 inline 
 SQLPOINTER OdbcConvert::getAdressBindDataFrom(char * pointer)
 {
@@ -3467,7 +3626,9 @@ int OdbcConvert::convStreamHexStringToBlob(DescRecord * from, DescRecord * to)
 
 	Blob * blob = from->dataBlobPtr;
 
-	if ( blob->isBlob() )
+	if ( from->directTransfer )
+		blob->directCloseStreamBlob( pointerTo );
+	else if ( blob->isBlob() )
 		blob->writeStreamHexToBlob( pointerTo );
 	else
 		blob->writeBlob( pointerTo );
@@ -3484,7 +3645,10 @@ int OdbcConvert::convStreamToBlob(DescRecord * from, DescRecord * to)
 
 	ODBCCONVERT_CHECKNULL_SQLDA;
 
-	from->dataBlobPtr->writeBlob( pointerTo );
+	if ( from->directTransfer )
+		from->dataBlobPtr->directCloseStreamBlob( pointerTo );
+	else
+		from->dataBlobPtr->writeBlob( pointerTo );
 
 	return SQL_SUCCESS;
 }
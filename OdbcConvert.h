@@ -25,6 +25,7 @@
 #if !defined(_OdbcConvert__INCLUDED_)
 #define _OdbcConvert__INCLUDED_
 
+#include <vector>
 #include "OdbcObject.h"
 
 namespace OdbcJdbcLibrary {
@@ -50,6 +51,55 @@ class OdbcStatement;
 
 typedef int (OdbcConvert::*ADRESS_FUNCTION)(DescRecord * from, DescRecord * to);
 
+// converts one column of a fetched rowset block in a single call
+typedef void (*COLUMN_BLOCK_FUNCTION)(const char * dataFrom, const char * indicatorFrom, size_t lengthRow,
+									  char * dataTo, SQLLEN strideData, char * indicatorTo, SQLLEN strideInd, int nRows);
+
+class CBindColumn;
+class OdbcDesc;
+
+// One step of a ConvertPlan, one per bound column. The step runs its
+// columnar kernel (fnBlock) or, without one, the fnConv of the column
+// row by row.
+struct ConvertPlanStep
+{
+	DescRecord				*from;
+	DescRecord				*to;
+	COLUMN_BLOCK_FUNCTION	fnBlock;
+	char					*dataFrom;
+	char					*indicatorFrom;
+	char					*dataTo;
+	char					*indicatorTo;
+	SQLLEN					strideData;
+	SQLLEN					strideInd;
+};
+
+// Conversion plan of the bound columns of a result set. Built once per
+// binding by OdbcConvert::buildConvertPlan with the kernels chosen and
+// the buffer addresses and strides resolved. It is stamped with the
+// change counters of the descriptors it was built from and rebuilt
+// only when one of them moved (SQLBindCol, SQLSetDescField, a new bind
+// type or offset, a new result set) or the plan was cleared.
+class ConvertPlan
+{
+public:
+	ConvertPlan() { clear(); }
+	void clear() { steps.clear(); valid = false; rowWise = false; rowBindType = 0; ard = ird = NULL; ardChanges = irdChanges = 0; }
+	bool isCurrent( OdbcDesc *app, unsigned int appChanges, OdbcDesc *imp, unsigned int impChanges, bool rowWiseNow )
+	{
+		return valid && ard == app && ardChanges == appChanges && ird == imp && irdChanges == impChanges && rowWise == rowWiseNow;
+	}
+
+	std::vector<ConvertPlanStep>	steps;
+	bool							valid;
+	bool							rowWise;
+	SQLLEN							rowBindType;
+	OdbcDesc						*ard;
+	OdbcDesc						*ird;
+	unsigned int					ardChanges;
+	unsigned int					irdChanges;
+};
+
 class OdbcConvert
 {
 	OdbcStatement	*parentStmt;
@@ -81,6 +131,8 @@ public:
 	void setBindOffsetPtrTo(SQLLEN *bindOffsetPtr, SQLLEN *bindOffsetPtrInd);
 	void setBindOffsetPtrFrom(SQLLEN *bindOffsetPtr, SQLLEN *bindOffsetPtrInd);
 	ADRESS_FUNCTION getAdressFunction(DescRecord * from, DescRecord * to);
+	COLUMN_BLOCK_FUNCTION getColumnBlockFunction(DescRecord * from, DescRecord * to);
+	void buildConvertPlan(ConvertPlan &plan, CBindColumn * bindCol, int count, bool rowWise, SQLLEN rowBindType);
 	inline SQLPOINTER getAdressBindDataFrom(char * pointer);
 	inline SQLLEN *getAdressBindIndFrom(char * pointer);
 	inline SQLPOINTER getAdressBindDataTo(char * pointer);
@@ -89,6 +141,9 @@ public:
 public:
 	bool isIdentity(){ return bIdentity; }
 	SQLLEN &getBindOffsetPtrTo() { return *bindOffsetPtrTo; }
+	SQLLEN &getBindOffsetPtrIndTo() { return *bindOffsetPtrIndTo; }
+	SQLLEN &getBindOffsetPtrFrom() { return *bindOffsetPtrFrom; }
+	SQLLEN &getBindOffsetPtrIndFrom() { return *bindOffsetPtrIndFrom; }
 	int notYetImplemented(DescRecord * from, DescRecord * to);
 
 // Guid
@@ -48,6 +48,7 @@ using namespace IscDbcLibrary;
 OdbcDesc::OdbcDesc(OdbcDescType type, OdbcConnection *connect)
 {
 	connection = connect;
+	statement = NULL;
 	metaDataIn = NULL;
 	metaDataOut = NULL;
 	recordSlots = 0;
@@ -61,6 +62,7 @@ OdbcDesc::OdbcDesc(OdbcDescType type, OdbcConnection *connect)
 	headRowsProcessedPtr = (SQLULEN*)NULL;
 	headCount = 0;
 	headBindType = SQL_BIND_BY_COLUMN;
+	bindChanges = 0;
 
 	if( headType == odtImplementationRow )
 		bDefined = false;
@@ -72,6 +74,7 @@ void OdbcDesc::setDefaultImplDesc (StatementMetaData * ptMetaDataOut, StatementM
 {
 	metaDataIn = ptMetaDataIn;
 	metaDataOut = ptMetaDataOut;
+	++bindChanges;
 
 	if( headType == odtImplementationParameter )
 	{
@@ -111,10 +114,13 @@ void OdbcDesc::removeRecords()
 	}
 	headCount = 0;
 	recordSlots = 0;
+	++bindChanges;
 }
  
 void OdbcDesc::releasePrepared()
 {
+	++bindChanges;
+
 	if (records)
 	{
 		for (int n = 0; n < recordSlots; ++n)
@@ -128,6 +134,8 @@ void OdbcDesc::releasePrepared()
  
 void OdbcDesc::clearPrepared()
 {
+	++bindChanges;
+
 	if (records)
 	{
 		for (int n = 0; n < recordSlots; ++n)
@@ -159,6 +167,8 @@ void OdbcDesc::updateDefinedIn()
  
 void OdbcDesc::updateDefinedOut()
 {
+	++bindChanges;
+
 	if (records)
 	{
 		for (int n = 1; n <= metaDataOut->getColumnCount(); ++n)
@@ -176,6 +186,8 @@ void OdbcDesc::updateDefinedOut()
 
 void OdbcDesc::clearDefined()
 {
+	++bindChanges;
+
 	if (records)
 	{
 		for (int n = 0; n < recordSlots; ++n)
@@ -278,6 +290,7 @@ void OdbcDesc::defFromMetaDataIn(int recNumber, DescRecord * record)
 
 void OdbcDesc::defFromMetaDataOut(int recNumber, DescRecord * record)
 {
+	++bindChanges;
 	int realSqlType;
 
 	record->autoUniqueValue = SQL_FALSE;
@@ -859,6 +872,7 @@ SQLRETURN OdbcDesc::sqlSetDescField(int recNumber, int fieldId, SQLPOINTER value
 	OutputDebugString(strTmp); 
 #endif
 	clearErrors();
+	++bindChanges;
 	DescRecord *record = NULL;
 
 	if (recNumber)
@@ -1237,6 +1251,7 @@ SQLRETURN OdbcDesc::sqlSetDescRec(	SQLSMALLINT	recNumber,
 									SQLLEN *indicatorPtr)
 {
     clearErrors();
+	++bindChanges;
 	DescRecord *record = NULL;
 
 	if(	headType == odtImplementationRow )
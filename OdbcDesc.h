@@ -129,6 +129,7 @@ public:
 //
 
 	OdbcConnection		*connection;
+	OdbcStatement		*statement;		// the one an implicit descriptor belongs to
 	StatementMetaData	*metaDataIn;
 	StatementMetaData	*metaDataOut;
 	OdbcDescType		headType;
@@ -136,6 +137,7 @@ public:
 	DescRecord			**records;
 
 	bool				bDefined;
+	unsigned int		bindChanges;	// bumped on every change of the bindings or of the bind layout
 };
 
 inline
@@ -37,13 +37,32 @@
 #include "OdbcEnv.h"
 #include "OdbcConnection.h"
 #include "IscDbc/SQLException.h"
+#include "IscDbc/IscQueryTimer.h"
+#include "IscDbc/AttachmentPool.h"
+#include "AsyncPool.h"
 #include <odbcinst.h>
+#include <mutex>
 #ifndef _WINDOWS
 #include <dlfcn.h>
 #endif
 
 namespace OdbcJdbcLibrary {
 
+static std::mutex environmentsMutex;
+static int environments;
+
+//
+// What the driver keeps for the process goes with the last environment.
+// The destructors of the globals cannot stop it: a driver unloaded by the
+// driver manager runs them under the lock of the loader on Windows.
+//
+static void releaseProcessResources()
+{
+	asyncPool.shutdown();
+	queryTimer.shutdown();
+	attachmentPool.clear();
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -70,11 +89,17 @@ OdbcEnv::OdbcEnv()
 	if (!(odbcInctFileName = getenv ("ODBCINST")))
 #endif
 		odbcInctFileName = "ODBCINST.INI";
+
+	std::lock_guard<std::mutex> guard( environmentsMutex );
+	++environments;
 }
 
 OdbcEnv::~OdbcEnv()
 {
+	std::lock_guard<std::mutex> guard( environmentsMutex );
 
+	if ( !--environments )
+		releaseProcessResources();
 }
 
 void OdbcEnv::LockEnv()
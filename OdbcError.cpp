@@ -58,6 +58,7 @@ struct ListErrorLinks
 } listSqlErrorLink[] = {
 
 	CODE_ERR( 53,    -1 ) // 42000 :: Syntax error
+	CODE_ERR(100,   -15 ) // HYT00 :: Query timeout expired
 	CODE_ERR(  0,   -84 ) // 
 	CODE_ERR(  0,   -85 ) // 
 	CODE_ERR(  0,  -103 ) // 
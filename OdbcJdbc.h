@@ -106,6 +106,24 @@
 #define SQL_BOOLEAN		16
 #endif
 
+// ODBC 3.8 notification of asynchronous completion
+#ifndef SQL_ATTR_ASYNC_STMT_EVENT
+#define SQL_ATTR_ASYNC_STMT_EVENT		29
+#endif
+
+#ifndef SQL_ATTR_ASYNC_STMT_PCALLBACK
+#define SQL_ATTR_ASYNC_STMT_PCALLBACK	30
+#define SQL_ATTR_ASYNC_STMT_PCONTEXT	31
+#endif
+
+#ifndef SQL_ASYNC_NOTIFICATION
+#define SQL_ASYNC_NOTIFICATION			10025
+#define SQL_ASYNC_NOTIFICATION_CAPABLE	1
+#endif
+
+// SQL_ASYNC_NOTIFICATION_CALLBACK of sqlspi.h, which not every platform has
+typedef SQLRETURN (SQL_API *AsyncNotificationCallback)( SQLPOINTER context, int last );
+
 #ifndef NULL
 #define NULL			0
 #endif
@@ -129,6 +147,28 @@
 #define SQL_FBGETSTMT_PLAN				11999
 #define SQL_FBGETSTMT_TYPE				11998
 #define SQL_FBGETSTMT_INFO				11997
+#define SQL_FBGETSTMT_CURSOR_MEMORY		11996
+
+// ext stmt attribute
+#define SQL_FBSTMT_READAHEAD_ROWS		11990
+#define SQL_FBSTMT_SERVER_SCROLL		11989
+#define SQL_FBSTMT_STATIC_CURSOR_MEMORY	11988
+#define SQL_FBSTMT_BLOB_CACHE_MEMORY	11987
+#define SQL_FBSTMT_EXECUTE_BLOCK		11986
+#define SQL_FBSTMT_CONVERT_PLAN			11985
+
+// ext connect attribute
+#define SQL_FBGETCONN_STMT_CACHE_HITS		11980
+#define SQL_FBGETCONN_STMT_CACHE_MISSES		11979
+#define SQL_FBGETCONN_STMT_CACHE_ENTRIES	11978
+#define SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS		11977
+#define SQL_FBGETCONN_NATIVE_SQL_CACHE_MISSES	11976
+#define SQL_FBGETCONN_NATIVE_SQL_CACHE_ENTRIES	11975
+#define SQL_FBGETCONN_POOL_HITS			11974
+#define SQL_FBGETCONN_POOL_MISSES		11973
+#define SQL_FBGETCONN_POOL_IDLE			11972
+#define SQL_FBGETCONN_CLIENT_LOADS		11971
+#define SQL_FBGETCONN_CLIENT_USERS		11970
 
 // ext env attribute
 #define SQL_ATTR_HANDLE_DBC_SHARE		4000
@@ -136,6 +176,7 @@
 #define DRIVER_LOCKED_LEVEL_NONE   		0
 #define DRIVER_LOCKED_LEVEL_ENV         1
 #define DRIVER_LOCKED_LEVEL_CONNECT     2
+#define DRIVER_LOCKED_LEVEL_STATEMENT   3	// a lock per statement, the connection only for what they share
 
 #ifndef DRIVER_LOCKED_LEVEL
 #define DRIVER_LOCKED_LEVEL		DRIVER_LOCKED_LEVEL_CONNECT
@@ -138,6 +138,7 @@
 #include "OdbcStatement.h"
 #include "OdbcError.h"
 #include "DescRecord.h"
+#include "AsyncPool.h"
 
 #ifdef DEBUG                               
 #define TRACE(msg)		OutputDebugString(#msg"\n");
@@ -182,15 +183,27 @@ OdbcStatement::OdbcStatement(OdbcConnection *connect, int statementNumber)
     parameterNeedData = 0;	
 	maxRows = 0;
 	maxLength = 0;
-	applicationRowDescriptor = connection->allocDescriptor (odtApplicationRow);
+	readAheadRows = atoi( connection->readAheadRows );
+	staticCursorMemory = atoi( connection->staticCursorMemory );
+	blobCacheMemory = connection->blobCacheMemory.IsEmpty() ? DEFAULT_BLOB_CACHE_MEMORY : atoi( connection->blobCacheMemory );
+	serverScrollableCursor = connection->serverScrollableCursor;
+	executeBlockBatch = false;
+	convertPlanEnabled = true;
+	isServerScrollCursor = false;
+	serverRowsetStart = 0;
+	serverRowsetRows = 0;
+	serverCursorOffset = 0;
+	serverRowPosition = 0;
+	applicationRowDescriptor = connection->allocDescriptor (odtApplicationRow, this);
 	saveApplicationRowDescriptor = applicationRowDescriptor;
-	applicationParamDescriptor = connection->allocDescriptor (odtApplicationParameter);
+	applicationParamDescriptor = connection->allocDescriptor (odtApplicationParameter, this);
 	saveApplicationParamDescriptor = applicationParamDescriptor;
-	implementationRowDescriptor = connection->allocDescriptor (odtImplementationRow);
-	implementationParamDescriptor = connection->allocDescriptor (odtImplementationParameter);
+	implementationRowDescriptor = connection->allocDescriptor (odtImplementationRow, this);
+	implementationParamDescriptor = connection->allocDescriptor (odtImplementationParameter, this);
 	implementationGetDataDescriptor = NULL;
 	fetchRetData = SQL_RD_ON;
 	sqldataOutOffsetPtr = NULL;
+	sqlindOutOffsetPtr = NULL;
 	numberColumns = 0;
 	rowNumberParamArray = 0;
 	registrationOutParameter = false;
@@ -202,7 +215,15 @@ OdbcStatement::OdbcStatement(OdbcConnection *connect, int statementNumber)
 	cursorName.Format ("SQL_CUR%d", statementNumber);
 	setPreCursorName = false;
 	cursorScrollable = SQL_NONSCROLLABLE;
-	asyncEnable = false;
+	asyncEnable = connection->asyncEnabled == SQL_ASYNC_ENABLE_ON;
+	asyncFunction = 0;
+	asyncStarted = false;
+	asyncDone = false;
+	asyncCanceled = false;
+	asyncResult = SQL_SUCCESS;
+	asyncEvent = NULL;
+	asyncCallback = NULL;
+	asyncContext = NULL;
 	enableAutoIPD = SQL_TRUE;
 	useBookmarks = SQL_UB_OFF;
 	cursorSensitivity = SQL_INSENSITIVE;
@@ -213,12 +234,14 @@ OdbcStatement::OdbcStatement(OdbcConnection *connect, int statementNumber)
 
 	listBindIn = new ListBindColumn;
 	convert = new OdbcConvert(this);
+	convertPlan = new ConvertPlan;
 	listBindOut = new ListBindColumn;
 	listBindGetData = NULL;
 }
 
 OdbcStatement::~OdbcStatement()
 {
+	asyncWait();
 	releaseBindings();
 	releaseParameters();
 	try
@@ -233,6 +256,7 @@ OdbcStatement::~OdbcStatement()
 	delete implementationParamDescriptor;
 	delete implementationGetDataDescriptor;
 	delete convert;
+	delete convertPlan;
 	delete listBindIn;
 	delete listBindOut;
 	delete listBindGetData;
@@ -240,6 +264,117 @@ OdbcStatement::~OdbcStatement()
 	delete bulkInsert;
 }
 
+bool OdbcStatement::Lock()
+{
+	if ( !connection->safeThread || !connection->connected )
+		return false;
+
+	mutex.lock();
+	return true;
+}
+
+void OdbcStatement::UnLock()
+{
+	mutex.unlock();
+}
+
+//
+// Starts the call in a thread of the pool, or tells how the one started
+// before goes: the function called again returns SQL_STILL_EXECUTING
+// while it runs, and what the call returned once it is done. The call
+// posts its diagnostics on the statement as it would have synchronously.
+// Another function fails at once, without waiting and without a record:
+// the diagnostics belong to the running call until it is polled to the
+// end, and the driver manager reports HY010 for it.
+//
+SQLRETURN OdbcStatement::asyncExecute( int function, std::function<SQLRETURN()> call )
+{
+	{
+		std::lock_guard<std::mutex> guard( asyncMutex );
+
+		if ( asyncFunction )
+		{
+			if ( function != asyncFunction )
+				return SQL_ERROR;
+
+			if ( !asyncDone )
+				return SQL_STILL_EXECUTING;
+
+			asyncFunction = 0;
+			return asyncResult;
+		}
+
+		asyncFunction = function;
+		asyncStarted = false;
+		asyncDone = false;
+		asyncCanceled = false;
+	}
+
+	asyncPool.submit( [this, call]{ asyncRun( call ); } );
+
+	return SQL_STILL_EXECUTING;
+}
+
+void OdbcStatement::asyncRun( const std::function<SQLRETURN()> &call )
+{
+	bool canceled;
+
+	{
+		std::lock_guard<std::mutex> guard( asyncMutex );
+		asyncStarted = true;
+		canceled = asyncCanceled;
+	}
+
+	SQLRETURN ret;
+
+	if ( canceled )
+	{
+		clearErrors();
+		ret = sqlReturn( SQL_ERROR, "HY008", "Operation canceled" );
+	}
+	else
+	{
+		try
+		{
+			ret = call();
+		}
+		catch ( ... )
+		{
+			clearErrors();
+			ret = sqlReturn( SQL_ERROR, "HY000", "General error" );
+		}
+	}
+
+	AsyncNotificationCallback callback;
+	SQLPOINTER context;
+	SQLPOINTER event;
+
+	// once it is done, the statement may be freed at any time
+	{
+		std::lock_guard<std::mutex> guard( asyncMutex );
+		asyncResult = ret;
+		asyncDone = true;
+		callback = asyncCallback;
+		context = asyncContext;
+		event = asyncEvent;
+		asyncFinished.notify_all();
+	}
+
+	if ( callback )
+		callback( context, false );
+#ifdef _WINDOWS
+	else if ( event )
+		SetEvent( (HANDLE)event );
+#endif
+}
+
+void OdbcStatement::asyncWait()
+{
+	std::unique_lock<std::mutex> lock( asyncMutex );
+
+	asyncFinished.wait( lock, [this]{ return !asyncFunction || asyncDone; } );
+}
+
 OdbcConnection* OdbcStatement::getConnection()
 {
 	return connection;
@@ -368,7 +503,7 @@ SQLRETURN OdbcStatement::sqlColumnPrivileges(SQLCHAR * catalog, int catLength,
 	return sqlSuccess();
 }
 
-SQLRETURN OdbcStatement::sqlPrepare(SQLCHAR * sql, int sqlLength)
+SQLRETURN OdbcStatement::sqlPrepare(SQLCHAR * sql, int sqlLength, bool direct)
 {
 	clearErrors();
 	releaseStatement();
@@ -420,20 +555,29 @@ SQLRETURN OdbcStatement::sqlPrepare(SQLCHAR * sql, int sqlLength)
 
 		if ( !retNativeSQL )
 		{
-			statement->prepareStatement (string);
-		
-			if ( statement->isActiveSelect() )
-				execute = &OdbcStatement::executeStatement;
-			else if ( statement->isActiveProcedure() )
-				execute = &OdbcStatement::executeProcedure;
-			else if ( statement->isActiveModify() && applicationParamDescriptor->headArraySize > 1 )
-				execute = &OdbcStatement::executeStatementParamArray;
+			// SQLExecDirect runs DDL, single row inserts and SELECTs read
+			// forward only without a prepare
+			if ( direct && applicationParamDescriptor->headArraySize <= 1
+				&& statement->prepareDirect (string, !isStaticCursor() && !setPreCursorName) )
+				execute = &OdbcStatement::executeDirect;
 			else
-				execute = &OdbcStatement::executeStatement;
+			{
+				statement->prepareStatement (string);
+			
+				if ( statement->isActiveSelect() )
+					execute = &OdbcStatement::executeStatement;
+				else if ( statement->isActiveProcedure() )
+					execute = &OdbcStatement::executeProcedure;
+				else if ( statement->isActiveModify() && applicationParamDescriptor->headArraySize > 1 )
+					execute = &OdbcStatement::executeStatementParamArray;
+				else
+					execute = &OdbcStatement::executeStatement;
+			}
 
 			registrationOutParameter = false;
 			listBindIn->removeAll();
 			listBindOut->removeAll();
+			convertPlan->clear();
 			implementationRowDescriptor->setDefaultImplDesc (statement->getStatementMetaDataIRD());
 			implementationParamDescriptor->setDefaultImplDesc (statement->getStatementMetaDataIRD(), statement->getStatementMetaDataIPD());
 			applicationRowDescriptor->clearPrepared();
@@ -506,6 +650,7 @@ void OdbcStatement::releaseResultSet()
 		resultSet = NULL;
 		metaData  = NULL;
 		sqldataOutOffsetPtr = NULL;
+		sqlindOutOffsetPtr = NULL;
 		implementationRowDescriptor->clearDefined();
 		implementationParamDescriptor->clearDefined();
 	}
@@ -535,12 +680,15 @@ void OdbcStatement::setResultSet(ResultSet * results, bool fromSystemCatalog)
 	fetchNext = &ResultSet::nextFetch;
 	resultSet = results;
 	isResultSetFromSystemCatalog = fromSystemCatalog;
+	isServerScrollCursor = false;
 	metaData = resultSet->getMetaData();
 	sqldataOutOffsetPtr = (SQLLEN*) resultSet->getSqlDataOffsetPtr();
+	sqlindOutOffsetPtr = (SQLLEN*) resultSet->getSqlIndOffsetPtr();
 
 	if ( !statement->isActive() )
 	{
 		listBindOut->removeAll();
+		convertPlan->clear();
 		implementationRowDescriptor->setDefaultImplDesc (metaData);
 		applicationRowDescriptor->clearPrepared();
 		rebindColumn();
@@ -548,7 +696,7 @@ void OdbcStatement::setResultSet(ResultSet * results, bool fromSystemCatalog)
 	else
 		implementationRowDescriptor->updateDefinedOut();
 
-	convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, NULL);
+	convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, sqlindOutOffsetPtr);
 	numberColumns = resultSet->getColumnCount();
 	enFetch = NoneFetch;
 	eof = false;
@@ -605,6 +753,8 @@ void OdbcStatement::addBindColumn(int column, DescRecord * recordFrom, DescRecor
 		(*listBindOut)[~j] = bindCol;
 	else
 		(*listBindOut)[j] = bindCol;
+
+	convertPlan->clear();
 }
 
 void OdbcStatement::delBindColumn(int column)
@@ -750,7 +900,13 @@ SQLRETURN OdbcStatement::fetchData()
 			SQLLEN	bindOffsetPtrTmp = bindOffsetPtr ? *bindOffsetPtr : 0;
 			bindOffsetPtr = &bindOffsetPtrTmp;
 
-			if ( schemaFetchData )
+			if ( nCountRow > 1 && fetchRetData == SQL_RD_ON && isBlockFetchData() )
+			{
+				nRow = fetchDataBlock( maxRows && maxRows < nCountRow ? maxRows : nCountRow );
+				if ( statusPtr && nRow )
+					memset(statusPtr, SQL_ROW_SUCCESS, sizeof(*statusPtr) * nRow);
+			}
+			else if ( schemaFetchData )
 			{
 				convert->setBindOffsetPtrTo(bindOffsetPtr, bindOffsetPtr);
 				while ( nRow < nCountRow && (resultSet->*fetchNext)() )
@@ -830,6 +986,57 @@ SQLRETURN OdbcStatement::fetchData()
 	return sqlSuccess();
 }
 
+//
+// The rowset can be fetched as one block and converted column by column
+// only for a plain forward cursor without bookmark and BLOB/ARRAY
+// columns, whose conversions depend on the current row of the cursor.
+// Result sets serving rows from their own storage (SQLGetTypeInfo) move
+// sqldataOutOffsetPtr instead of the message buffer and are excluded too.
+//
+bool OdbcStatement::isBlockFetchData()
+{
+	if ( isResultSetFromSystemCatalog || fetchNext != &ResultSet::nextFetch )
+		return false;
+
+	if ( sqldataOutOffsetPtr && *sqldataOutOffsetPtr )
+		return false;
+
+	int count = listBindOut->GetCount();
+	CBindColumn * bindCol = listBindOut->GetRoot();
+
+	while( count-- )
+	{
+		if ( !bindCol->column || bindCol->impRecord->isBlobOrArray )
+			return false;
+		bindCol++;
+	}
+
+	return true;
+}
+
+//
+// Fetches up to nCountRow rows into the result set's block buffer, then
+// converts the rowset one column at a time with the conversion plan.
+//
+int OdbcStatement::fetchDataBlock(int nCountRow)
+{
+	intptr_t offsetFirstRow;
+	size_t lengthRow;
+	int nRow = resultSet->nextFetchBlock( nCountRow, &offsetFirstRow, &lengthRow );
+
+	if ( !nRow )
+		return 0;
+
+	SQLLEN bindOffset = schemaFetchData ? *applicationRowDescriptor->headBindOffsetPtr : 0;
+
+	countFetched += nRow;
+	rowNumber += nRow;
+
+	runConvertPlan( nRow, offsetFirstRow, offsetFirstRow, lengthRow, bindOffset, bindOffset );
+
+	return nRow;
+}
+
 SQLRETURN OdbcStatement::sqlFetch()
 {
 	clearErrors();
@@ -840,7 +1047,7 @@ SQLRETURN OdbcStatement::sqlFetch()
 	if (cancel)
 	{
 		releaseResultSet();
-		return sqlReturn (SQL_ERROR, "S1008", "Operation canceled");
+		return sqlReturn (SQL_ERROR, "HY008", "Operation canceled");
 	}
 
 	if( enFetch == NoneFetch )
@@ -848,10 +1055,13 @@ SQLRETURN OdbcStatement::sqlFetch()
 		enFetch = Fetch;
 		schemaFetchData = getSchemaFetchData();
 		rebindColumn();
-		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, NULL);
+		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, sqlindOutOffsetPtr);
 		isFetchStaticCursor = isStaticCursor();
 	}
 
+	if ( isServerScrollCursor )
+		return sqlFetchScrollCursorServer ( SQL_FETCH_NEXT, 1 );
+
 	if ( isFetchStaticCursor )
 		return sqlFetchScrollCursorStatic ( SQL_FETCH_NEXT, 1);
 
@@ -1085,16 +1295,28 @@ SQLRETURN OdbcStatement::sqlFetchScrollCursorStatic(int orientation, int offset)
 			bindOffsetPtr = &bindOffsetPtrTmp;
 			resultSet->setCurrentRowInBufferStaticCursor(rowNumber);
 
+			// a keyset-driven cursor reports rows changed since it was opened
+			bool keysetRows = statement->isKeysetCursor();
+			SQLUSMALLINT rowStatus = SQL_ROW_SUCCESS;
+
 			if ( schemaFetchData )
 			{
 				convert->setBindOffsetPtrTo(bindOffsetPtr, bindOffsetPtr);
 				while ( nRow < rowsetSize && rowNumber < sqlDiagCursorRowCount )
 				{
-					resultSet->copyNextSqldaFromBufferStaticCursor();
+					resultSet->nextRowInBufferStaticCursor();
 					++countFetched;
 					++rowNumber; // Should stand only here!!!
 
-					returnData();
+					if ( keysetRows )
+						rowStatus = resultSet->rowDeleted() ? SQL_ROW_DELETED
+									: resultSet->rowUpdated() ? SQL_ROW_UPDATED : SQL_ROW_SUCCESS;
+
+					if ( rowStatus != SQL_ROW_DELETED )
+						returnData();
+
+					if ( statusPtr )
+						statusPtr[nRow] = rowStatus;
 
 					bindOffsetPtrTmp += rowBindType;
 					++nRow;
@@ -1102,8 +1324,6 @@ SQLRETURN OdbcStatement::sqlFetchScrollCursorStatic(int orientation, int offset)
 					if (maxRows && nRow == maxRows)
 						break;
 				}
-				if ( statusPtr )
-					memset(statusPtr, SQL_ROW_SUCCESS, sizeof(*statusPtr) * nRow);
 			}
 			else
 			{
@@ -1112,11 +1332,19 @@ SQLRETURN OdbcStatement::sqlFetchScrollCursorStatic(int orientation, int offset)
 				convert->setBindOffsetPtrTo(&bindOffsetPtrData, &bindOffsetPtrInd);
 				while ( nRow < rowsetSize && rowNumber < sqlDiagCursorRowCount )
 				{
-					resultSet->copyNextSqldaFromBufferStaticCursor();
+					resultSet->nextRowInBufferStaticCursor();
 					++countFetched;
 					++rowNumber; // Should stand only here!!!
 
-					returnDataFromExtendedFetch();
+					if ( keysetRows )
+						rowStatus = resultSet->rowDeleted() ? SQL_ROW_DELETED
+									: resultSet->rowUpdated() ? SQL_ROW_UPDATED : SQL_ROW_SUCCESS;
+
+					if ( rowStatus != SQL_ROW_DELETED )
+						returnDataFromExtendedFetch();
+
+					if ( statusPtr )
+						statusPtr[nRow] = rowStatus;
 
 					bindOffsetPtrInd += sizeof(SQLLEN);
 					++bindOffsetPtrTmp;
@@ -1125,8 +1353,6 @@ SQLRETURN OdbcStatement::sqlFetchScrollCursorStatic(int orientation, int offset)
 					if ( maxRows && nRow == maxRows )
 						break;
 				}
-				if ( statusPtr )
-					memset(statusPtr, SQL_ROW_SUCCESS, sizeof(*statusPtr) * nRow);
 			}
 			
 			*rowCountPt = nRow;
@@ -1180,6 +1406,232 @@ SQLRETURN OdbcStatement::sqlFetchScrollCursorStatic(int orientation, int offset)
 	return SQL_NO_DATA;
 }
 
+//
+// SQLFetchScroll on a server-side scrollable cursor. The server cursor is
+// left on the last row read, serverCursorOffset rows past the first row
+// of the rowset (or one past the last row when the rowset ran into the
+// end), so every move is done relative to it and nothing is cached on
+// the client. serverRowsetStart is 0 after moves that count from the end,
+// where the absolute row number is not known.
+//
+SQLRETURN OdbcStatement::sqlFetchScrollCursorServer(int orientation, int offset)
+{
+	SQLULEN rowCount = 0;
+	SQLULEN *rowCountPt = implementationRowDescriptor->headRowsProcessedPtr ? implementationRowDescriptor->headRowsProcessedPtr
+								: &rowCount;
+	SQLUSMALLINT *statusPtr = implementationRowDescriptor->headArrayStatusPtr ? implementationRowDescriptor->headArrayStatusPtr
+								: NULL;
+	int rowsetSize = applicationRowDescriptor->headArraySize;
+	SQLLEN *&bindOffsetPtr = applicationRowDescriptor->headBindOffsetPtr;
+	SQLLEN *bindOffsetPtrSave = bindOffsetPtr;
+
+	*rowCountPt = 0;
+
+	try
+	{
+		bool onRowset = resultSet->isCurrRowsetStart();
+		bool found = false;
+		bool afterEnd = false;
+		bool beforeStart = false;
+		int start = 0;
+
+		if ( orientation == SQL_FETCH_PRIOR && resultSet->isAfterLast() )
+			orientation = SQL_FETCH_LAST;
+		else if ( orientation == SQL_FETCH_RELATIVE && !onRowset )
+		{
+			if ( resultSet->isBeforeFirst() ? offset > 0 : offset < 0 )
+				orientation = SQL_FETCH_ABSOLUTE;
+			else
+				offset = 0;
+		}
+
+		switch ( orientation )
+		{
+		case SQL_FETCH_NEXT:
+			afterEnd = true;
+			if ( resultSet->isAfterLast() || ( onRowset && serverCursorOffset == serverRowsetRows ) )
+				break;
+
+			if ( onRowset )
+			{
+				found = resultSet->relative( serverRowsetRows - serverCursorOffset );
+				start = serverRowsetStart ? serverRowsetStart + serverRowsetRows : 0;
+			}
+			else
+			{
+				found = resultSet->first();
+				start = 1;
+			}
+			break;
+
+		case SQL_FETCH_PRIOR:
+			if ( !onRowset || serverRowsetStart == 1 || !resultSet->relative( -1 - serverCursorOffset ) )
+				break;
+
+			if ( rowsetSize > 1 && !resultSet->relative( 1 - rowsetSize ) )
+			{
+				found = resultSet->first();
+				beforeStart = found;
+				start = 1;
+			}
+			else
+			{
+				found = true;
+				start = serverRowsetStart ? serverRowsetStart - rowsetSize : 0;
+			}
+			break;
+
+		case SQL_FETCH_FIRST:
+			found = resultSet->first();
+			start = 1;
+			break;
+
+		case SQL_FETCH_LAST:
+			found = resultSet->last();
+			if ( found && rowsetSize > 1 && !resultSet->relative( 1 - rowsetSize ) )
+			{
+				found = resultSet->first();
+				start = 1;
+			}
+			break;
+
+		case SQL_FETCH_ABSOLUTE:
+			afterEnd = offset > 0;
+			if ( !offset )
+				break;
+
+			found = resultSet->absolute( offset );
+			if ( found )
+				start = offset > 0 ? offset : 0;
+			else if ( offset < 0 && -offset <= rowsetSize )
+			{
+				found = resultSet->first();
+				beforeStart = found;
+				start = 1;
+			}
+			break;
+
+		case SQL_FETCH_RELATIVE:
+			afterEnd = offset > 0;
+			if ( !onRowset )
+				break;
+
+			found = resultSet->relative( offset - serverCursorOffset );
+			if ( found )
+				start = serverRowsetStart ? serverRowsetStart + offset : 0;
+			else if ( offset < 0 && serverRowsetStart != 1 && -offset <= rowsetSize )
+			{
+				found = resultSet->first();
+				beforeStart = found;
+				start = 1;
+			}
+			break;
+
+		default:
+			return sqlReturn (SQL_ERROR, "HY106", "Fetch type out of range");
+		}
+
+		if ( !found )
+		{
+			if ( afterEnd )
+				resultSet->afterLast();
+			else
+				resultSet->beforeFirst();
+
+			serverRowsetRows = 0;
+			serverCursorOffset = 0;
+			eof = afterEnd;
+			return SQL_NO_DATA;
+		}
+
+		// the first row of the rowset is in the message buffer, read the rest forward
+		int limit = maxRows && maxRows < rowsetSize ? maxRows : rowsetSize;
+		int rowBindType = applicationRowDescriptor->headBindType;
+		SQLLEN bindOffsetPtrTmp = bindOffsetPtr ? *bindOffsetPtr : 0;
+		SQLLEN bindOffsetPtrData = 0;
+		SQLLEN bindOffsetPtrInd = 0;
+		int nRow = 0;
+
+		bindOffsetPtr = &bindOffsetPtrTmp;
+
+		if ( schemaFetchData )
+			convert->setBindOffsetPtrTo(bindOffsetPtr, bindOffsetPtr);
+		else
+			convert->setBindOffsetPtrTo(&bindOffsetPtrData, &bindOffsetPtrInd);
+
+		do
+		{
+			++countFetched;
+			++nRow;
+
+			if ( schemaFetchData )
+			{
+				if ( fetchRetData == SQL_RD_ON )
+					returnData();
+				bindOffsetPtrTmp += rowBindType;
+			}
+			else
+			{
+				if ( fetchRetData == SQL_RD_ON )
+					returnDataFromExtendedFetch();
+				bindOffsetPtrInd += sizeof(SQLLEN);
+				++bindOffsetPtrTmp;
+			}
+		}
+		while ( nRow < limit && ( found = resultSet->relative( 1 ) ) );
+
+		bindOffsetPtr = bindOffsetPtrSave;
+
+		resultSet->currRowsetStart();
+		serverRowsetStart = start;
+		serverRowsetRows = nRow;
+		serverCursorOffset = found ? nRow - 1 : nRow;
+		serverRowPosition = 0;
+		rowNumber = start ? start - 1 + nRow : nRow;
+		eof = !found;
+
+		*rowCountPt = nRow;
+
+		if ( statusPtr )
+		{
+			SQLUSMALLINT * pt = statusPtr;
+			SQLUSMALLINT * ptEnd = statusPtr + rowsetSize;
+			while ( pt < statusPtr + nRow )
+				*pt++ = SQL_ROW_SUCCESS;
+			while ( pt < ptEnd )
+				*pt++ = SQL_ROW_NOROW;
+		}
+
+		if ( beforeStart )
+			postError( "01S06", "Attempt to fetch before the result set returned the first rowset" );
+	}
+	catch ( std::exception &ex )
+	{
+		SQLException &exception = (SQLException&)ex;
+		bindOffsetPtr = bindOffsetPtrSave;
+		OdbcError *error = postError ("HY000", exception);
+		error->setRowNumber (rowNumber);
+		return SQL_ERROR;
+	}
+
+	return sqlSuccess();
+}
+
+//
+// Moves the server cursor back onto the row of the rowset SQLGetData
+// reads: the message buffer holds the last row the rowset fetch read.
+//
+void OdbcStatement::positionServerCursor()
+{
+	if ( serverCursorOffset == serverRowPosition || !resultSet->isCurrRowsetStart() )
+		return;
+
+	if ( !resultSet->relative( serverRowPosition - serverCursorOffset ) )
+		throw SQLEXCEPTION (RUNTIME_ERROR, "the row of the rowset is no longer in the cursor");
+
+	serverCursorOffset = serverRowPosition;
+}
+
 SQLRETURN OdbcStatement::sqlFetchScroll(int orientation, int offset)
 {
 #ifdef DEBUG
@@ -1197,7 +1649,7 @@ SQLRETURN OdbcStatement::sqlFetchScroll(int orientation, int offset)
 	{
 		enFetch = FetchScroll;
 		schemaFetchData = getSchemaFetchData();
-		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, NULL);
+		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, sqlindOutOffsetPtr);
 		isFetchStaticCursor = isStaticCursor();
 	}
 
@@ -1207,9 +1659,12 @@ SQLRETURN OdbcStatement::sqlFetchScroll(int orientation, int offset)
 	if (cancel)
 	{
 		releaseResultSet();
-		return sqlReturn (SQL_ERROR, "S1008", "Operation canceled");
+		return sqlReturn (SQL_ERROR, "HY008", "Operation canceled");
 	}
 
+	if ( isServerScrollCursor )
+		return sqlFetchScrollCursorServer(orientation,offset);
+
 	if ( isFetchStaticCursor )
 		return sqlFetchScrollCursorStatic(orientation,offset);
 
@@ -1226,7 +1681,7 @@ SQLRETURN OdbcStatement::sqlExtendedFetch(int orientation, int offset, SQLULEN *
 	if (cancel)
 	{
 		releaseResultSet();
-		return sqlReturn (SQL_ERROR, "S1008", "Operation canceled");
+		return sqlReturn (SQL_ERROR, "HY008", "Operation canceled");
 	}
 
 	if( cursorType == SQL_CURSOR_FORWARD_ONLY && orientation != SQL_FETCH_NEXT )
@@ -1236,13 +1691,16 @@ SQLRETURN OdbcStatement::sqlExtendedFetch(int orientation, int offset, SQLULEN *
 	{
 		enFetch = ExtendedFetch;
 		schemaFetchData = getSchemaFetchData();
-		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, NULL);
+		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, sqlindOutOffsetPtr);
 		isFetchStaticCursor = isStaticCursor();
 	}
 
 	implementationRowDescriptor->headRowsProcessedPtr = rowCountPointer;
 	implementationRowDescriptor->headArrayStatusPtr = rowStatusArray;
 
+	if ( isServerScrollCursor )
+		return sqlFetchScrollCursorServer (orientation, offset);
+
 	if ( isFetchStaticCursor )
 		return sqlFetchScrollCursorStatic (orientation, offset);
 
@@ -1267,10 +1725,22 @@ SQLRETURN OdbcStatement::sqlSetPos (SQLUSMALLINT row, SQLUSMALLINT operation, SQ
 								fetchBookmarkPtr ? *(int*)fetchBookmarkPtr : 0, row );
 	OutputDebugString(strTmp); 
 #endif
+	clearErrors();
 
 	switch ( operation )
 	{
 	case SQL_POSITION:
+		if ( isServerScrollCursor )
+		{
+			if ( !row || row > serverRowsetRows )
+				return sqlReturn (SQL_ERROR, "HY107", "Row value out of range");
+
+			serverRowPosition = row - 1;
+			if ( serverRowsetStart )
+				rowNumber = serverRowsetStart + serverRowPosition;
+			++countFetched;
+			break;
+		}
 		if( fetchBookmarkPtr )
 			rowNumber = (*(int*)fetchBookmarkPtr - 1) + row - 1;
 		else
@@ -1578,6 +2048,7 @@ void OdbcStatement::releaseBindings()
 {
 	applicationRowDescriptor->removeRecords();
 	listBindOut->removeAll();
+	convertPlan->clear();
 	enFetch = NoneFetch;
 
 	if ( implementationGetDataDescriptor )
@@ -1600,7 +2071,10 @@ void OdbcStatement::releaseParameters()
 	listBindIn->removeAll();
 
 	if ( statement->isActiveProcedure() )
+	{
 		listBindOut->removeAll();
+		convertPlan->clear();
+	}
 
 	implementationParamDescriptor->setDefined( false );
 	implementationParamDescriptor->clearPrepared();
@@ -1839,8 +2313,8 @@ SQLRETURN OdbcStatement::sqlGetData(int column, int cType, PTR pointer, SQLLEN b
 		else
 			listBindGetData->removeAll();
 
-		implementationGetDataDescriptor = connection->allocDescriptor (odtImplementationGetData);
-		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, NULL);
+		implementationGetDataDescriptor = connection->allocDescriptor (odtImplementationGetData, this);
+		convert->setBindOffsetPtrFrom(sqldataOutOffsetPtr, sqlindOutOffsetPtr);
 		implementationGetDataDescriptor->getDescRecord (implementationRowDescriptor->headCount, false);
 	}
 
@@ -1886,6 +2360,9 @@ SQLRETURN OdbcStatement::sqlGetData(int column, int cType, PTR pointer, SQLLEN b
 
 		try
 		{
+			if ( isServerScrollCursor )
+				positionServerCursor();
+
 			CBindColumn &bindCol = (*listBindGetData)[column];
 			convert->setBindOffsetPtrTo(NULL, NULL);
 
@@ -1935,7 +2412,7 @@ SQLRETURN OdbcStatement::sqlExecute()
 
 SQLRETURN OdbcStatement::sqlExecDirect(SQLCHAR * sql, int sqlLength)
 {
-	int retcode = sqlPrepare (sql, sqlLength);
+	int retcode = sqlPrepare (sql, sqlLength, true);
 	if (retcode && retcode != SQL_SUCCESS_WITH_INFO)
 		return retcode;
 	try
@@ -2300,11 +2777,45 @@ SQLRETURN OdbcStatement::sqlBindParameter(int parameter, int type, int cType,
 	return sqlSuccess();
 }
 
+//
+// Called from another thread while the statement runs, cancels the call
+// on the server; the thread that made it gets HY008. Called while data
+// at execution is asked for, gives up the execution. A call started
+// asynchronously that no thread has taken yet is not run at all.
+// Otherwise the fetches of the result set stop at the next one.
+//
 SQLRETURN OdbcStatement::sqlCancel()
 {
 	try
 	{
-		cancel = true;
+		bool queued = false;
+
+		{
+			std::lock_guard<std::mutex> guard( asyncMutex );
+			if ( asyncFunction )
+			{
+				queued = !asyncStarted;
+				asyncCanceled = true;
+			}
+		}
+
+		if ( parameterNeedData )
+		{
+			parameterNeedData = 0;
+
+			// the BLOB parameters streamed so far are not going to be used
+			for ( int n = 1; n <= applicationParamDescriptor->headCount; ++n )
+			{
+				DescRecord *record = applicationParamDescriptor->records[n];
+				if ( record && record->startedTransfer && record->isBlobOrArray )
+				{
+					record->cancelBlobDataTransfer();
+					record->endBlobDataTransfer();
+				}
+			}
+		}
+		else if ( !queued && !statement->cancel() )
+			cancel = true;
 	}
 	catch ( std::exception &ex )
 	{
@@ -2432,6 +2943,41 @@ SQLRETURN OdbcStatement::sqlGetStmtAttr(int attribute, SQLPOINTER ptr, int buffe
 		case SQL_FBGETSTMT_INFO:
 			return statement->getStmtInfoCountRecords(ptr,bufferLength,(int*)lengthPtr);
 
+		case SQL_FBGETSTMT_CURSOR_MEMORY:
+			value = resultSet ? (intptr_t)resultSet->getMemoryStaticCursor() : 0;
+			TRACE02(SQL_FBGETSTMT_CURSOR_MEMORY,value);
+			break;
+
+		case SQL_FBSTMT_READAHEAD_ROWS:
+			value = readAheadRows;
+			TRACE02(SQL_FBSTMT_READAHEAD_ROWS,value);
+			break;
+
+		case SQL_FBSTMT_SERVER_SCROLL:
+			value = serverScrollableCursor ? SQL_TRUE : SQL_FALSE;
+			TRACE02(SQL_FBSTMT_SERVER_SCROLL,value);
+			break;
+
+		case SQL_FBSTMT_STATIC_CURSOR_MEMORY:
+			value = staticCursorMemory;
+			TRACE02(SQL_FBSTMT_STATIC_CURSOR_MEMORY,value);
+			break;
+
+		case SQL_FBSTMT_BLOB_CACHE_MEMORY:
+			value = blobCacheMemory;
+			TRACE02(SQL_FBSTMT_BLOB_CACHE_MEMORY,value);
+			break;
+
+		case SQL_FBSTMT_EXECUTE_BLOCK:
+			value = executeBlockBatch ? SQL_TRUE : SQL_FALSE;
+			TRACE02(SQL_FBSTMT_EXECUTE_BLOCK,value);
+			break;
+
+		case SQL_FBSTMT_CONVERT_PLAN:
+			value = convertPlanEnabled ? SQL_TRUE : SQL_FALSE;
+			TRACE02(SQL_FBSTMT_CONVERT_PLAN,value);
+			break;
+
 		case SQL_ATTR_APP_ROW_DESC:
 			value = (intptr_t) applicationRowDescriptor;
 			TRACE02(SQL_ATTR_APP_ROW_DESC,value);
@@ -2483,15 +3029,30 @@ SQLRETURN OdbcStatement::sqlGetStmtAttr(int attribute, SQLPOINTER ptr, int buffe
 			break;
 
 		case SQL_ATTR_QUERY_TIMEOUT:
-			value = 0;							// driver doesn't timeout
+			value = statement->getQueryTimeout();
 			TRACE02(SQL_ATTR_QUERY_TIMEOUT,value);
 			break;
 
 		case SQL_ATTR_ASYNC_ENABLE:
-			value = 0;							// driver doesn't do async
+			value = asyncEnable ? SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF;
 			TRACE02(SQL_ATTR_ASYNC_ENABLE,value);
 			break;
 
+		case SQL_ATTR_ASYNC_STMT_EVENT:			// 29
+			value = (intptr_t)asyncEvent;
+			TRACE02(SQL_ATTR_ASYNC_STMT_EVENT,value);
+			break;
+
+		case SQL_ATTR_ASYNC_STMT_PCALLBACK:		// 30
+			value = (intptr_t)asyncCallback;
+			TRACE02(SQL_ATTR_ASYNC_STMT_PCALLBACK,value);
+			break;
+
+		case SQL_ATTR_ASYNC_STMT_PCONTEXT:		// 31
+			value = (intptr_t)asyncContext;
+			TRACE02(SQL_ATTR_ASYNC_STMT_PCONTEXT,value);
+			break;
+
 		case SQL_ATTR_PARAM_BIND_TYPE:
 			value = applicationParamDescriptor->headBindType;
 			TRACE02(SQL_ATTR_PARAM_BIND_TYPE,value);
@@ -2683,6 +3244,7 @@ void OdbcStatement::bindOutputColumn(int column, DescRecord * recordApp)
 	}
 
 	record->fnConv = convert->getAdressFunction( record, recordApp );
+	record->fnConvBlock = convert->getColumnBlockFunction( record, recordApp );
 
 	switch ( recordApp->conciseType )
 	{
@@ -2840,6 +3402,18 @@ SQLRETURN OdbcStatement::executeStatement()
 	if ( (ret = inputParam(), ret) && ret != SQL_SUCCESS_WITH_INFO )
 		return ret;
 
+	isServerScrollCursor = false;
+	bool staticCursor = isStaticCursor();
+	bool keysetCursor = staticCursor && cursorType == SQL_CURSOR_KEYSET_DRIVEN;
+
+	// read-ahead only pays off for forward-only cursors fetched row by row,
+	// and a cursor named for WHERE CURRENT OF must stay on the row fetched
+	statement->setReadAheadRows( staticCursor || setPreCursorName ? 0 : readAheadRows );
+	// bookmarks are row numbers of the static cursor, keep it for them
+	statement->setScrollableCursor( staticCursor && !keysetCursor && serverScrollableCursor && useBookmarks == SQL_UB_OFF );
+	statement->setStaticCursorMemory( staticCursorMemory );
+	statement->setBlobCacheMemory( blobCacheMemory );
+	statement->setKeysetCursor( keysetCursor );
 	statement->executeStatement();
 
 	if ( statement->isActiveSelectForUpdate() || setPreCursorName )
@@ -2848,10 +3422,25 @@ SQLRETURN OdbcStatement::executeStatement()
 	if ( statement->getMoreResults() )
 		setResultSet (statement->getResultSet(), false);
 
-	if ( statement->isActiveSelect() && isStaticCursor() )
+	if ( statement->isActiveSelect() && statement->isScrollableCursor() && isStaticCursor() )
+	{
+		isServerScrollCursor = true;
+		serverRowsetStart = 0;
+		serverRowsetRows = 0;
+		serverCursorOffset = 0;
+		serverRowPosition = 0;
+	}
+	else if ( statement->isActiveSelect() && isStaticCursor() )
 	{
 		resultSet->readStaticCursor(); 
 		setCursorRowCount(resultSet->getCountRowsStaticCursor());
+
+		// only a single-table SELECT can be read through its keys
+		if ( keysetCursor && !statement->isKeysetCursor() )
+		{
+			cursorType = SQL_CURSOR_STATIC;
+			postError( "01S02", "Option value changed" );
+		}
 	}
 	else if ( statement->isActiveModify() && statement->getUpdateCount() <= 0 )
 	{
@@ -2869,6 +3458,11 @@ SQLRETURN OdbcStatement::executeStatement()
 
 SQLRETURN OdbcStatement::executeStatementParamArray()
 {
+	// parameter sets go in batches: IBatch on Firebird 4, EXECUTE BLOCK before it
+	statement->setExecuteBlockBatch( executeBlockBatch );
+	if ( !parameterNeedData && statement->beginBatch() )
+		return executeStatementParamBatch();
+
 	SQLRETURN ret = SQL_SUCCESS;
 	SQLULEN rowCount = 0;
 	SQLULEN *rowCountPt = implementationParamDescriptor->headRowsProcessedPtr ? implementationParamDescriptor->headRowsProcessedPtr
@@ -2899,7 +3493,23 @@ SQLRETURN OdbcStatement::executeStatementParamArray()
 			return ret;
 		}
 
-		statement->executeStatement();
+		try
+		{
+			statement->executeStatement();
+		}
+		catch ( std::exception & )
+		{
+			headBindOffsetPtr = bindOffsetPtrSave;
+			convert->setBindOffsetPtrFrom ( applicationParamDescriptor->headBindOffsetPtr, applicationParamDescriptor->headBindOffsetPtr );
+			*rowCountPt = rowNumberParamArray + 1;
+			if ( statusPtr )
+			{
+				*statusPtr++ = SQL_PARAM_ERROR;
+				for ( int n = rowNumberParamArray + 1; n < nCountRow; ++n )
+					*statusPtr++ = SQL_PARAM_UNUSED;
+			}
+			throw;
+		}
 
 		if ( statusPtr )
 			*statusPtr++ = ret == SQL_SUCCESS_WITH_INFO ? SQL_PARAM_SUCCESS_WITH_INFO : SQL_PARAM_SUCCESS;
@@ -2919,6 +3529,110 @@ SQLRETURN OdbcStatement::executeStatementParamArray()
 	return ret;
 }
 
+//
+// Converts every parameter set and sends them with IBatch. Data-at-execution
+// parameters show up converting the first set; such a statement is executed
+// set by set instead.
+//
+SQLRETURN OdbcStatement::executeStatementParamBatch()
+{
+	SQLRETURN ret = SQL_SUCCESS;
+	SQLRETURN retRow = SQL_SUCCESS;
+	SQLULEN rowCount = 0;
+	SQLULEN *rowCountPt = implementationParamDescriptor->headRowsProcessedPtr ? implementationParamDescriptor->headRowsProcessedPtr
+							: &rowCount;
+	SQLUSMALLINT *statusPtr = implementationParamDescriptor->headArrayStatusPtr ? implementationParamDescriptor->headArrayStatusPtr
+								: NULL;
+	int rowSize = applicationParamDescriptor->headBindType;
+	int nCountRow = applicationParamDescriptor->headArraySize;
+	SQLLEN	*&headBindOffsetPtr = applicationParamDescriptor->headBindOffsetPtr;
+	SQLLEN	*bindOffsetPtrSave = headBindOffsetPtr;
+	SQLLEN	bindOffsetPtrTmp = headBindOffsetPtr ? *headBindOffsetPtr : 0;
+	bool arrayColumnWiseBinding = rowSize == SQL_PARAM_BIND_BY_COLUMN;
+
+	headBindOffsetPtr = &bindOffsetPtrTmp;
+	*rowCountPt = rowNumberParamArray = 0;
+
+	try
+	{
+		while ( rowNumberParamArray < nCountRow )
+		{
+			if ( arrayColumnWiseBinding )
+				bindOffsetIndColumnWiseBinding = ( bindOffsetPtrTmp + rowNumberParamArray ) * sizeof ( SQLLEN );
+
+			if ( (retRow = inputParam( arrayColumnWiseBinding ), retRow) && retRow != SQL_SUCCESS_WITH_INFO )
+				break;
+
+			if ( retRow == SQL_SUCCESS_WITH_INFO )
+				ret = retRow;
+
+			if ( statusPtr )
+				statusPtr[rowNumberParamArray] = retRow == SQL_SUCCESS_WITH_INFO ? SQL_PARAM_SUCCESS_WITH_INFO : SQL_PARAM_SUCCESS;
+
+			statement->addBatch();
+
+			bindOffsetPtrTmp += rowSize;
+			parameterNeedData = 1;
+			++rowNumberParamArray;
+		}
+
+		if ( retRow == SQL_NEED_DATA && !rowNumberParamArray )
+		{
+			statement->cancelBatch();
+			headBindOffsetPtr = bindOffsetPtrSave;
+			return executeStatementParamArray();
+		}
+
+		// the sets converted before a conversion error are still executed
+		statement->executeBatch();
+	}
+	catch ( std::exception & )
+	{
+		statement->cancelBatch();
+		headBindOffsetPtr = bindOffsetPtrSave;
+		convert->setBindOffsetPtrFrom ( applicationParamDescriptor->headBindOffsetPtr, applicationParamDescriptor->headBindOffsetPtr );
+		setParamBatchStatus( statusPtr, rowCountPt, nCountRow );
+		throw;
+	}
+
+	headBindOffsetPtr = bindOffsetPtrSave;
+	convert->setBindOffsetPtrFrom ( applicationParamDescriptor->headBindOffsetPtr, applicationParamDescriptor->headBindOffsetPtr );
+	setParamBatchStatus( statusPtr, rowCountPt, nCountRow );
+
+	if ( retRow && retRow != SQL_SUCCESS_WITH_INFO )
+	{
+		if ( statusPtr )
+			statusPtr[rowNumberParamArray] = SQL_PARAM_ERROR;
+		*rowCountPt = rowNumberParamArray + 1;
+		return retRow;
+	}
+
+	if ( statement->getMoreResults() )
+		setResultSet (statement->getResultSet(), false);
+
+	return ret;
+}
+
+//
+// Marks the parameter sets the server failed and the ones it never got to.
+//
+void OdbcStatement::setParamBatchStatus( SQLUSMALLINT *statusPtr, SQLULEN *rowCountPt, int nCountRow )
+{
+	int rows = statement->getBatchRows();
+
+	*rowCountPt = rows;
+
+	if ( !statusPtr )
+		return;
+
+	for ( int n = 0; n < rows; ++n )
+		if ( statement->getBatchUpdateCount( n ) < 0 )
+			statusPtr[n] = SQL_PARAM_ERROR;
+
+	for ( int n = rows; n < nCountRow; ++n )
+		statusPtr[n] = SQL_PARAM_UNUSED;
+}
+
 SQLRETURN OdbcStatement::executeProcedure()
 {
 	SQLRETURN ret;
@@ -3018,6 +3732,28 @@ SQLRETURN OdbcStatement::executeNone()
 	return sqlSuccess();
 }
 
+SQLRETURN OdbcStatement::executeDirect()
+{
+	statement->setReadAheadRows( readAheadRows );
+	statement->setScrollableCursor( false );
+	statement->setBlobCacheMemory( blobCacheMemory );
+	statement->setKeysetCursor( false );
+
+	if ( !statement->executeDirect() )
+		return SQL_SUCCESS;
+
+	// the columns of a SELECT are known once its cursor is open
+	implementationRowDescriptor->setDefaultImplDesc (statement->getStatementMetaDataIRD());
+	applicationRowDescriptor->clearPrepared();
+	rebindColumn();
+	numberColumns = statement->getStatementMetaDataIRD()->getColumnCount();
+
+	if ( statement->getMoreResults() )
+		setResultSet (statement->getResultSet(), false);
+
+	return SQL_SUCCESS;
+}
+
 SQLRETURN OdbcStatement::executeCreateDatabase()
 {
 	connection->connection->sqlExecuteCreateDatabase( sqlPrepareString );
@@ -3088,7 +3824,18 @@ SQLRETURN OdbcStatement::sqlParamData(SQLPOINTER *ptr)
 							metaData->createBlobDataTransfer ( parameterNeedData, binding->dataBlobPtr );
 						}
 						if ( !binding->startedTransfer )
-							binding->beginBlobDataTransfer();
+						{
+							try
+							{
+								binding->beginBlobDataTransfer();
+							}
+							catch ( std::exception &ex )
+							{
+								SQLException &exception = (SQLException&)ex;
+								postError ("HY000", exception);
+								return SQL_ERROR;
+							}
+						}
 					}
 				}
 			}
@@ -3134,46 +3881,65 @@ SQLRETURN OdbcStatement::sqlPutData (SQLPOINTER value, SQLLEN valueSize)
 
 	if ( valueSize != SQL_NULL_DATA && binding->isBlobOrArray )
 	{
-		if ( !binding->startedTransfer )
-			binding->beginBlobDataTransfer();
+		try
+		{
+			if ( !binding->startedTransfer )
+				binding->beginBlobDataTransfer();
 
-		if ( valueSize == SQL_NTS )
-			if ( binding->conciseType == SQL_C_WCHAR )
-				valueSize = (SQLINTEGER)wcslen( (wchar_t*)value ) * sizeof(wchar_t);
-			else // if ( binding->conciseType == SQL_C_CHAR )
-				valueSize = (SQLINTEGER)strlen( (char*)value );
+			if ( valueSize == SQL_NTS )
+				if ( binding->conciseType == SQL_C_WCHAR )
+					valueSize = (SQLINTEGER)wcslen( (wchar_t*)value ) * sizeof(wchar_t);
+				else // if ( binding->conciseType == SQL_C_CHAR )
+					valueSize = (SQLINTEGER)strlen( (char*)value );
 
-		if( valueSize )
-		{
-			if ( binding->conciseType == SQL_C_WCHAR )
+			if( valueSize )
 			{
-				CBindColumn &bindParam = (*listBindIn)[ parameterNeedData - 1 ];
-
-				// for WcsToMbs we need to assure a L'\0' terminated source buffer
-				wchar_t* wcEnd = ((wchar_t*) value) + valueSize / sizeof(wchar_t);
-				wchar_t wcSave = *wcEnd;
-				*wcEnd = L'\0';
-
-				// ipd->headSqlVarPtr->getSqlMultiple() cannot be used to calculate the conversion
-				// buffer size, because for blobs it seems to return always 1
-				// so we call the conversion function to calculate the required buffer size
-				// size_t lenMbs = valueSize / sizeof(wchar_t) * ipd->headSqlVarPtr->getSqlMultiple();
-				size_t lenMbs = bindParam.impRecord->WcsToMbs(NULL, (const wchar_t*)value, 0 );
-				char* tempValue = new char[lenMbs+1];
-				lenMbs = bindParam.impRecord->WcsToMbs(tempValue, (const wchar_t*)value, lenMbs );
-				binding->putBlobSegmentData (lenMbs, tempValue);
-				delete [] tempValue;
-
-				*wcEnd = wcSave;
+				if ( binding->conciseType == SQL_C_WCHAR )
+				{
+					CBindColumn &bindParam = (*listBindIn)[ parameterNeedData - 1 ];
+
+					// for WcsToMbs we need to assure a L'\0' terminated source buffer
+					wchar_t* wcEnd = ((wchar_t*) value) + valueSize / sizeof(wchar_t);
+					wchar_t wcSave = *wcEnd;
+					*wcEnd = L'\0';
+
+					// ipd->headSqlVarPtr->getSqlMultiple() cannot be used to calculate the conversion
+					// buffer size, because for blobs it seems to return always 1
+					// so we call the conversion function to calculate the required buffer size
+					// size_t lenMbs = valueSize / sizeof(wchar_t) * ipd->headSqlVarPtr->getSqlMultiple();
+					size_t lenMbs = bindParam.impRecord->WcsToMbs(NULL, (const wchar_t*)value, 0 );
+					char* tempValue = new char[lenMbs+1];
+					lenMbs = bindParam.impRecord->WcsToMbs(tempValue, (const wchar_t*)value, lenMbs );
+					*wcEnd = wcSave;
+
+					try
+					{
+						binding->putBlobSegmentData (lenMbs, tempValue);
+					}
+					catch ( ... )
+					{
+						delete [] tempValue;
+						throw;
+					}
+					delete [] tempValue;
+				}
+				else
+					binding->putBlobSegmentData (valueSize, value);
 			}
-			else
-				binding->putBlobSegmentData (valueSize, value);
+		}
+		catch ( std::exception &ex )
+		{
+			SQLException &exception = (SQLException&)ex;
+			postError ("HY000", exception);
+			return SQL_ERROR;
 		}
 	}
 	else
 	{
 		if ( !binding->startedTransfer )
 			binding->startedTransfer = true;
+		else if ( binding->isBlobOrArray )
+			binding->cancelBlobDataTransfer();
 
 		if ( valueSize == SQL_NTS )
 			if ( binding->conciseType == SQL_C_WCHAR )
@@ -3193,32 +3959,158 @@ SQLRETURN OdbcStatement::sqlPutData (SQLPOINTER value, SQLLEN valueSize)
 
 inline
 SQLRETURN OdbcStatement::returnData()
+{
+	return runConvertPlan( 1, convert->getBindOffsetPtrFrom(), convert->getBindOffsetPtrIndFrom(), 0,
+						   convert->getBindOffsetPtrTo(), convert->getBindOffsetPtrIndTo() );
+}
+
+//
+// Converts nRows rows of the bound columns following the conversion plan,
+// (re)built here only when the plan was cleared or the change counter of
+// the ARD or IRD moved since it was built.
+// With lengthRow == 0 this is the current row and the "from"/"to" offsets
+// already set in convert are used as they are; otherwise row n of the
+// block is at offsetFrom + n * lengthRow and countFetched is the number
+// of the last row of the block.
+//
+SQLRETURN OdbcStatement::runConvertPlan(int nRows, SQLLEN offsetFrom, SQLLEN offsetIndFrom, size_t lengthRow, SQLLEN offsetTo, SQLLEN offsetIndTo)
 {
 	SQLRETURN retCode, ret = SQL_SUCCESS;
 	int count = listBindOut->GetCount();
+
+	if ( !count )
+		return ret;
+
+	if ( !convertPlanEnabled )
+		return runConvertPerRow( nRows, offsetFrom, offsetIndFrom, lengthRow, offsetTo, offsetIndTo );
+
+	OdbcDesc *ard = applicationRowDescriptor;
+	OdbcDesc *ird = implementationRowDescriptor;
+	bool rowWise = schemaFetchData;
+
+	if ( !convertPlan->isCurrent( ard, ard->bindChanges, ird, ird->bindChanges, rowWise ) )
+	{
+		convert->buildConvertPlan( *convertPlan, listBindOut->GetRoot(), count, rowWise, ard->headBindType );
+		convertPlan->ard = ard;
+		convertPlan->ardChanges = ard->bindChanges;
+		convertPlan->ird = ird;
+		convertPlan->irdChanges = ird->bindChanges;
+	}
+
+	int countFetchedLast = countFetched;
+	SQLLEN offsetFromRow, offsetDataRow, offsetIndRow;
+
+	if ( lengthRow )
+	{
+		convert->setBindOffsetPtrFrom( &offsetFromRow, &offsetFromRow );
+		convert->setBindOffsetPtrTo( &offsetDataRow, &offsetIndRow );
+	}
+
 	convert->statusReturnData = true;
 
-	if ( count )
+	ConvertPlanStep *step = convertPlan->steps.data();
+
+	for ( ; count--; ++step )
+	{
+		if ( step->fnBlock )
+		{
+			step->fnBlock( step->dataFrom + offsetFrom,
+						   step->indicatorFrom ? step->indicatorFrom + offsetIndFrom : NULL,
+						   lengthRow,
+						   step->dataTo ? step->dataTo + offsetTo : NULL, step->strideData,
+						   step->indicatorTo ? step->indicatorTo + offsetIndTo : NULL, step->strideInd,
+						   nRows );
+			continue;
+		}
+
+		for ( int n = 0; n < nRows; ++n )
+		{
+			if ( lengthRow )
+			{
+				countFetched = countFetchedLast - nRows + n + 1;
+				offsetFromRow = offsetFrom + n * lengthRow;
+				offsetDataRow = offsetTo + n * step->strideData;
+				offsetIndRow = offsetIndTo + n * step->strideInd;
+			}
+
+			retCode = (convert->*step->from->fnConv)(step->from, step->to);
+			if ( retCode != SQL_SUCCESS && ret != SQL_ERROR )
+				ret = retCode;
+		}
+
+		if ( ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO )
+			break;
+	}
+
+	convert->statusReturnData = false;
+
+	if ( lengthRow )
+	{
+		countFetched = countFetchedLast;
+		convert->setBindOffsetPtrFrom( sqldataOutOffsetPtr, sqlindOutOffsetPtr );
+		convert->setBindOffsetPtrTo( NULL, NULL );
+	}
+
+	return ret;
+}
+
+//
+// The dispatch without a plan, as SQL_FBSTMT_CONVERT_PLAN = SQL_FALSE asks:
+// every bound column of every row through its fnConv, resolving the
+// buffers and the strides again each time. Kept to measure the plan against.
+//
+SQLRETURN OdbcStatement::runConvertPerRow(int nRows, SQLLEN offsetFrom, SQLLEN offsetIndFrom, size_t lengthRow, SQLLEN offsetTo, SQLLEN offsetIndTo)
+{
+	SQLRETURN retCode, ret = SQL_SUCCESS;
+	bool rowWise = schemaFetchData;
+	SQLLEN rowBindType = applicationRowDescriptor->headBindType;
+	int countFetchedLast = countFetched;
+	SQLLEN offsetFromRow, offsetDataRow, offsetIndRow;
+
+	if ( lengthRow )
 	{
+		convert->setBindOffsetPtrFrom( &offsetFromRow, &offsetFromRow );
+		convert->setBindOffsetPtrTo( &offsetDataRow, &offsetIndRow );
+	}
+
+	convert->statusReturnData = true;
+
+	for ( int n = 0; n < nRows && ret != SQL_ERROR; ++n )
+	{
+		int count = listBindOut->GetCount();
 		CBindColumn * bindCol = listBindOut->GetRoot();
 
-		while( count-- )
+		for ( ; count--; ++bindCol )
 		{
 			DescRecord *& imp = bindCol->impRecord;
+			DescRecord *& app = bindCol->appRecord;
 
-			retCode = (convert->*imp->fnConv)(imp, bindCol->appRecord);
-			if ( retCode != SQL_SUCCESS )
+			if ( lengthRow )
 			{
-				ret = retCode;
-				if ( ret != SQL_SUCCESS_WITH_INFO )
-					break;
+				countFetched = countFetchedLast - nRows + n + 1;
+				offsetFromRow = offsetFrom + n * lengthRow;
+				offsetDataRow = offsetTo + n * ( rowWise ? rowBindType : app->sizeColumnExtendedFetch );
+				offsetIndRow = offsetIndTo + n * ( rowWise ? rowBindType : (SQLLEN)sizeof(SQLLEN) );
 			}
 
-			bindCol++;
+			retCode = (convert->*imp->fnConv)(imp, app);
+			if ( retCode != SQL_SUCCESS && ret != SQL_ERROR )
+				ret = retCode;
+
+			if ( ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO )
+				break;
 		}
 	}
 
 	convert->statusReturnData = false;
+
+	if ( lengthRow )
+	{
+		countFetched = countFetchedLast;
+		convert->setBindOffsetPtrFrom( sqldataOutOffsetPtr, sqlindOutOffsetPtr );
+		convert->setBindOffsetPtrTo( NULL, NULL );
+	}
+
 	return ret;
 }
 
@@ -3266,7 +4158,44 @@ SQLRETURN OdbcStatement::sqlSetStmtAttr(int attribute, SQLPOINTER ptr, int lengt
 		switch (attribute)
 		{
 		case SQL_QUERY_TIMEOUT:				// 0
-			TRACE(SQL_QUERY_TIMEOUT);
+			statement->setQueryTimeout( (int)(intptr_t) ptr );
+			TRACE02(SQL_QUERY_TIMEOUT,(intptr_t) ptr);
+			break;
+
+		case SQL_FBSTMT_READAHEAD_ROWS:
+			if ( (intptr_t)ptr < 0 )
+				return sqlReturn (SQL_ERROR, "HY024", "Invalid attribute value");
+			readAheadRows = (int)(intptr_t) ptr;
+			TRACE02(SQL_FBSTMT_READAHEAD_ROWS,(intptr_t) ptr);
+			break;
+
+		case SQL_FBSTMT_SERVER_SCROLL:
+			serverScrollableCursor = (intptr_t) ptr == SQL_TRUE;
+			TRACE02(SQL_FBSTMT_SERVER_SCROLL,(intptr_t) ptr);
+			break;
+
+		case SQL_FBSTMT_STATIC_CURSOR_MEMORY:
+			if ( (intptr_t)ptr < 0 )
+				return sqlReturn (SQL_ERROR, "HY024", "Invalid attribute value");
+			staticCursorMemory = (int)(intptr_t) ptr;
+			TRACE02(SQL_FBSTMT_STATIC_CURSOR_MEMORY,(intptr_t) ptr);
+			break;
+
+		case SQL_FBSTMT_BLOB_CACHE_MEMORY:
+			if ( (intptr_t)ptr < 0 )
+				return sqlReturn (SQL_ERROR, "HY024", "Invalid attribute value");
+			blobCacheMemory = (int)(intptr_t) ptr;
+			TRACE02(SQL_FBSTMT_BLOB_CACHE_MEMORY,(intptr_t) ptr);
+			break;
+
+		case SQL_FBSTMT_EXECUTE_BLOCK:
+			executeBlockBatch = (intptr_t) ptr == SQL_TRUE;
+			TRACE02(SQL_FBSTMT_EXECUTE_BLOCK,(intptr_t) ptr);
+			break;
+
+		case SQL_FBSTMT_CONVERT_PLAN:
+			convertPlanEnabled = (intptr_t) ptr == SQL_TRUE;
+			TRACE02(SQL_FBSTMT_CONVERT_PLAN,(intptr_t) ptr);
 			break;
 
 		case SQL_ATTR_RETRIEVE_DATA:
@@ -3296,6 +4225,7 @@ SQLRETURN OdbcStatement::sqlSetStmtAttr(int attribute, SQLPOINTER ptr, int lengt
 
 		case SQL_ATTR_ROW_BIND_TYPE:		// SQL_BIND_TYPE 5
 			applicationRowDescriptor->headBindType = (intptr_t)ptr;
+			++applicationRowDescriptor->bindChanges;
 			TRACE02(SQL_ATTR_ROW_BIND_TYPE,(intptr_t) ptr);
 			break;
 
@@ -3317,6 +4247,7 @@ SQLRETURN OdbcStatement::sqlSetStmtAttr(int attribute, SQLPOINTER ptr, int lengt
 
 		case SQL_ATTR_ROW_BIND_OFFSET_PTR:	// 23
 			applicationRowDescriptor->headBindOffsetPtr = (SQLLEN*)ptr;
+			++applicationRowDescriptor->bindChanges;
 			TRACE02(SQL_ATTR_ROW_BIND_OFFSET_PTR,(intptr_t) ptr);
 			break;
 
@@ -3381,6 +4312,31 @@ SQLRETURN OdbcStatement::sqlSetStmtAttr(int attribute, SQLPOINTER ptr, int lengt
 			TRACE02(SQL_ATTR_ASYNC_ENABLE,(intptr_t) ptr);
 			break;
 
+		// read by the thread that completes the call
+		case SQL_ATTR_ASYNC_STMT_EVENT:			// 29
+			{
+				std::lock_guard<std::mutex> guard( asyncMutex );
+				asyncEvent = ptr;
+			}
+			TRACE02(SQL_ATTR_ASYNC_STMT_EVENT,(intptr_t) ptr);
+			break;
+
+		case SQL_ATTR_ASYNC_STMT_PCALLBACK:		// 30
+			{
+				std::lock_guard<std::mutex> guard( asyncMutex );
+				asyncCallback = (AsyncNotificationCallback)ptr;
+			}
+			TRACE02(SQL_ATTR_ASYNC_STMT_PCALLBACK,(intptr_t) ptr);
+			break;
+
+		case SQL_ATTR_ASYNC_STMT_PCONTEXT:		// 31
+			{
+				std::lock_guard<std::mutex> guard( asyncMutex );
+				asyncContext = ptr;
+			}
+			TRACE02(SQL_ATTR_ASYNC_STMT_PCONTEXT,(intptr_t) ptr);
+			break;
+
 		case SQL_ATTR_MAX_ROWS:					// SQL_MAX_ROWS 1
 			maxRows = (intptr_t) ptr;
 			TRACE02(SQL_ATTR_MAX_ROWS,(intptr_t) ptr);
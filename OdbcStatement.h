@@ -31,6 +31,9 @@
 #if !defined(_ODBCSTATEMENT_H_)
 #define _ODBCSTATEMENT_H_
 
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include "OdbcObject.h"
 
 namespace OdbcJdbcLibrary {
@@ -43,6 +46,7 @@ class OdbcDesc;
 class DescRecord;
 class OdbcStatement;
 class OdbcConvert;
+class ConvertPlan;
 
 //
 //	from odbcss.h
@@ -60,6 +64,10 @@ class OdbcStatement : public OdbcObject
 public:
 	SQLRETURN sqlMoreResults();
 	inline SQLRETURN fetchData();
+	bool isBlockFetchData();
+	int fetchDataBlock(int nCountRow);
+	SQLRETURN runConvertPlan(int nRows, SQLLEN offsetFrom, SQLLEN offsetIndFrom, size_t lengthRow, SQLLEN offsetTo, SQLLEN offsetIndTo);
+	SQLRETURN runConvertPerRow(int nRows, SQLLEN offsetFrom, SQLLEN offsetIndFrom, size_t lengthRow, SQLLEN offsetTo, SQLLEN offsetIndTo);
 	inline SQLRETURN returnData();
 	inline SQLRETURN returnDataFromExtendedFetch();
 #ifdef _WIN64
@@ -69,6 +77,8 @@ public:
 #endif
 	SQLRETURN sqlFetchScroll (int orientation, int offset);
 	SQLRETURN sqlFetchScrollCursorStatic(int orientation, int offset);
+	SQLRETURN sqlFetchScrollCursorServer(int orientation, int offset);
+	void positionServerCursor();
 	SQLRETURN sqlSetPos (SQLUSMALLINT rowNumber, SQLUSMALLINT operation, SQLUSMALLINT lockType);
 	SQLRETURN sqlBulkOperations( int operation );
 	SQLRETURN sqlSetScrollOptions (SQLUSMALLINT fConcurrency, SQLLEN crowKeyset, SQLUSMALLINT crowRowset);
@@ -82,10 +92,13 @@ public:
 	SQLRETURN inputParam( bool arrayColumnWiseBinding = false );
 	SQLRETURN executeStatement();
 	SQLRETURN executeStatementParamArray();
+	SQLRETURN executeStatementParamBatch();
+	void setParamBatchStatus( SQLUSMALLINT *statusPtr, SQLULEN *rowCountPt, int nCountRow );
 	SQLRETURN executeProcedure();
 	SQLRETURN executeCommit();
 	SQLRETURN executeRollback();
 	SQLRETURN executeNone();
+	SQLRETURN executeDirect();
 	SQLRETURN executeCreateDatabase();
 	SQLRETURN sqlGetCursorName (SQLCHAR *name, int bufferLength, SQLSMALLINT *nameLength);
 	SQLRETURN sqlGetStmtAttr (int attribute, SQLPOINTER value, int bufferLength, SQLINTEGER *lengthPtr);
@@ -116,7 +129,7 @@ public:
 	void setResultSet (ResultSet *results, bool fromSystemCatalog = true);
 	void releaseResultSet();
 	void releaseStatement();
-	SQLRETURN sqlPrepare (SQLCHAR *sql, int sqlLength);
+	SQLRETURN sqlPrepare (SQLCHAR *sql, int sqlLength, bool direct = false);
 
 	SQLRETURN sqlColumns (SQLCHAR * catalog, int catLength, SQLCHAR * schema, int schemaLength, SQLCHAR * table, int tableLength, SQLCHAR *column, int columnLength);
 	SQLRETURN sqlTables (SQLCHAR* catalog, int catLength, SQLCHAR* schema, int schemaLength, SQLCHAR*table, int tableLength, SQLCHAR *type, int typeLength);
@@ -132,7 +145,30 @@ public:
 	virtual OdbcObjectType getType();
 	OdbcStatement(OdbcConnection *connect, int statementNumber);
 	~OdbcStatement();
-	bool isStaticCursor(){ return cursorType != SQL_CURSOR_FORWARD_ONLY && cursorScrollable == SQL_SCROLLABLE || isResultSetFromSystemCatalog; }
+	bool Lock();
+	void UnLock();
+
+	//
+	// Runs a call on the statement, in a thread of the pool while
+	// SQL_ATTR_ASYNC_ENABLE is on or a call runs there already. The call
+	// takes the locks the function needs itself.
+	//
+	template <typename Call>
+	SQLRETURN asyncCall( int function, Call call )
+	{
+		if ( !asyncEnable && !isAsyncRunning() )
+			return call();
+		return asyncExecute( function, std::function<SQLRETURN()>( call ) );
+	}
+	bool isAsyncRunning()
+	{
+		std::lock_guard<std::mutex> guard( asyncMutex );
+		return asyncFunction != 0;
+	}
+	SQLRETURN asyncExecute( int function, std::function<SQLRETURN()> call );
+	void asyncRun( const std::function<SQLRETURN()> &call );
+	void asyncWait();
+	bool isStaticCursor(){ return ( cursorType != SQL_CURSOR_FORWARD_ONLY && cursorScrollable == SQL_SCROLLABLE || isResultSetFromSystemCatalog ) && !isServerScrollCursor; }
 	int getCurrentFetched(){ return countFetched; }
 	bool getSchemaFetchData(){ return applicationRowDescriptor->headBindType || applicationRowDescriptor->headBindOffsetPtr; }
 	inline StatementMetaData	*getStatementMetaDataIRD();
@@ -153,6 +189,7 @@ public:
 	OdbcDesc			*implementationParamDescriptor;
 	OdbcDesc			*implementationGetDataDescriptor;
 	OdbcConvert			*convert;
+	ConvertPlan			*convertPlan;
 	ListBindColumn		*listBindIn;
 	ListBindColumn		*listBindOut;
 	ListBindColumn		*listBindGetData;
@@ -179,6 +216,7 @@ public:
 
 	SQLLEN				fetchRetData;
 	SQLLEN				*sqldataOutOffsetPtr;
+	SQLLEN				*sqlindOutOffsetPtr;
 	SQLUINTEGER			enableAutoIPD;
 	SQLINTEGER			useBookmarks;
 	SQLINTEGER			cursorSensitivity;
@@ -190,12 +228,49 @@ public:
 	int					cursorType;
 	int					cursorScrollable;
 	bool				asyncEnable;
+	int					asyncFunction;		// SQL_API_* of the call started asynchronously, 0 - none
+	bool				asyncStarted;		// a thread of the pool runs it
+	bool				asyncDone;
+	bool				asyncCanceled;		// cancelled before a thread took it
+	SQLRETURN			asyncResult;
+	SQLPOINTER			asyncEvent;			// SQL_ATTR_ASYNC_STMT_EVENT
+	AsyncNotificationCallback	asyncCallback;	// SQL_ATTR_ASYNC_STMT_PCALLBACK, set by the driver manager
+	SQLPOINTER			asyncContext;
+	std::mutex			asyncMutex;			// guards asyncFunction and the state of the call, from asyncStarted on
+	std::condition_variable	asyncFinished;
 	int					rowNumber;
 	int					rowNumberParamArray;
 	int					lastRowsetSize;
 	SQLLEN				indicatorRowNumber;
 	int					maxRows;
 	int					maxLength;
+	int					readAheadRows;		// 0 - fetch synchronously
+	int					staticCursorMemory;	// megabytes, 0 - unlimited
+	int					blobCacheMemory;	// megabytes of BLOB contents cached by the static cursor
+	bool				serverScrollableCursor;	// scroll on the server instead of the static cursor
+	bool				executeBlockBatch;		// send parameter arrays in EXECUTE BLOCK, not IBatch
+	bool				convertPlanEnabled;		// convert bound columns with the plan, not column by column per row
+	bool				isServerScrollCursor;	// the current result set scrolls on the server
+	int					serverRowsetStart;		// first row of the rowset, 0 - unknown
+	int					serverRowsetRows;		// rows in the rowset
+	int					serverCursorOffset;		// server cursor position from the rowset start
+	int					serverRowPosition;		// row of the rowset SQLSetPos put the cursor on
+	std::recursive_mutex	mutex;			// held by the calls on the statement with DRIVER_LOCKED_LEVEL_STATEMENT
+};
+
+class SafeStatementThread
+{
+	OdbcStatement * statement;
+public:
+	SafeStatementThread(OdbcStatement * stmt)
+	{
+		statement = stmt && stmt->Lock() ? stmt : NULL;
+	}
+	~SafeStatementThread()
+	{
+		if(statement)
+			statement->UnLock();
+	}
 };
 
 }; // end namespace OdbcJdbcLibrary
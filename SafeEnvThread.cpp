@@ -5,7 +5,7 @@
 #include "OdbcJdbc.h"
 #include "SafeEnvThread.h"
 
-#if(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_ENV || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_CONNECT)
+#if(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_ENV || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_CONNECT || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_STATEMENT)
 
 namespace OdbcJdbcLibrary {
 
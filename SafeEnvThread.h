@@ -1,7 +1,7 @@
 #if !defined(_SafeEnvThread__INCLUDED_)
 #define _SafeEnvThread__INCLUDED_
 
-#if(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_ENV || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_CONNECT)
+#if(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_ENV || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_CONNECT || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_STATEMENT)
 
 #ifdef _PTHREADS
 #include <pthread.h>
@@ -67,6 +67,6 @@ public:
 
 }; // end namespace OdbcJdbcLibrary
 
-#endif // #if(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_ENV || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_CONNECT)
+#endif // #if(DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_ENV || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_CONNECT || DRIVER_LOCKED_LEVEL == DRIVER_LOCKED_LEVEL_STATEMENT)
 
 #endif // !defined(_SafeEnvThread__INCLUDED_)
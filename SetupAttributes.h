@@ -84,6 +84,8 @@
 #define SETUP_JDBC_DRIVER	"JdbcDriver"
 #define SETUP_READONLY_TPB	"ReadOnly"
 #define SETUP_NOWAIT_TPB	"NoWait"
+#define SETUP_AUTOCOMMIT_TPB	"ServerAutoCommit"
+#define SETUP_READONLY_QUERIES	"ReadOnlyQueries"
 #define SETUP_DIALECT		"Dialect"
 #define SETUP_TIMEOUT		"Timeout"
 #define SETUP_USESCHEMA		"UseSchemaIdentifier"
@@ -96,6 +98,15 @@
 #define SETUP_SET_COMPAT_BIND "SetCompatBind"
 #define SETUP_ENABLE_COMPAT_BIND "EnableCompatBind"
 #define SETUP_ENABLE_WIRECOMPRESSION "EnableWireCompression"
+#define SETUP_READAHEAD		"ReadAheadRows"
+#define SETUP_SERVERSCROLL	"ServerScrollableCursor"
+#define SETUP_STATICMEMORY	"StaticCursorMemory"
+#define SETUP_BLOBCACHE		"BlobCacheMemory"
+#define SETUP_STMTCACHE		"StatementCacheSize"
+#define SETUP_STMTCACHEMEMORY	"StatementCacheMemory"
+#define SETUP_POOL			"PoolSize"
+#define SETUP_POOLIDLETIMEOUT	"PoolIdleTimeout"
+#define SETUP_POOLLIFETIME	"PoolLifetime"
 
 #define FLAG_DATABASEACCESS	"DatabaseAccess"
 
@@ -122,6 +133,15 @@
 #define KEY_DSN_SETCOMPATBIND "SETCOMPATBIND"
 #define KEY_DSN_ENABLECOMPATBIND "ENABLECOMPATBIND"
 #define KEY_DSN_ENABLEWIRECOMPRESSION "ENABLEWIRECOMPRESSION"
+#define KEY_DSN_READAHEAD	"READAHEAD"
+#define KEY_DSN_SERVERSCROLL	"SERVERSCROLL"
+#define KEY_DSN_STATICMEMORY	"STATICMEMORY"
+#define KEY_DSN_BLOBCACHE	"BLOBCACHE"
+#define KEY_DSN_STMTCACHE	"STMTCACHE"
+#define KEY_DSN_STMTCACHEMEMORY	"STMTCACHEMEMORY"
+#define KEY_DSN_POOL		"POOL"
+#define KEY_DSN_POOLIDLETIMEOUT	"POOLIDLETIMEOUT"
+#define KEY_DSN_POOLLIFETIME	"POOLLIFETIME"
 
 #define LEN_KEY(keydsn) sizeof(keydsn) - 1
 
@@ -0,0 +1,235 @@
+// fetch_conversion_benchmark.cpp — Microbenchmark of bound column conversion
+//
+// Fetches a generated result set of INTEGER, BIGINT and DOUBLE PRECISION
+// columns through the Driver Manager with several bindings: the C type of
+// every column, one row and a rowset at a time, row-wise and column-wise,
+// converted to other numeric C types, and every column bound as text for
+// comparison. Each binding is measured twice, with SQL_FBSTMT_CONVERT_PLAN
+// off (every column of every row dispatched through its conversion
+// function, as the driver did before the plan) and on, and the two are
+// reported side by side. The rows are produced by an EXECUTE BLOCK, so no
+// table is needed, but the benchmark does need a database:
+//
+//   fetch_conversion_benchmark [connection string] [rows] [iterations]
+//
+// The connection string defaults to FIREBIRD_ODBC_CONNECTION.
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#define COLUMN_GROUPS	4		// of an INTEGER, a BIGINT and a DOUBLE PRECISION
+#define COLUMNS			( COLUMN_GROUPS * 3 )
+#define ROWSET_SIZE		100
+
+#ifndef SQL_FBSTMT_CONVERT_PLAN
+#define SQL_FBSTMT_CONVERT_PLAN	11985
+#endif
+
+static SQLHDBC connection;
+
+static void printError( SQLSMALLINT type, SQLHANDLE handle )
+{
+	SQLCHAR state[6] = {}, text[512] = {};
+	SQLINTEGER native = 0;
+	SQLSMALLINT length = 0;
+
+	SQLGetDiagRec( type, handle, 1, state, &native, text, sizeof( text ), &length );
+	fprintf( stderr, "%s %s\n", state, text );
+}
+
+static std::string generatorSql( int rows )
+{
+	std::string sql = "EXECUTE BLOCK RETURNS (";
+
+	for ( int n = 0; n < COLUMN_GROUPS; ++n )
+	{
+		char columns[96];
+		sprintf( columns, "%sI%d INTEGER, B%d BIGINT, D%d DOUBLE PRECISION", n ? ", " : "", n, n, n );
+		sql += columns;
+	}
+
+	char loop[128];
+	sprintf( loop, ") AS DECLARE N INTEGER = 0; BEGIN WHILE (N < %d) DO BEGIN N = N + 1;", rows );
+	sql += loop;
+
+	for ( int n = 0; n < COLUMN_GROUPS; ++n )
+	{
+		char columns[128];
+		sprintf( columns, " I%d = N + %d; B%d = N * 1000000000000; D%d = N / 4e0;", n, n, n, n );
+		sql += columns;
+	}
+
+	return sql + " SUSPEND; END END";
+}
+
+//
+// Binds the columns through bind, executes and fetches to the end,
+// iterations times, with or without the conversion plan; returns the
+// time per row in nanoseconds, 0 on error.
+//
+template <typename Bind>
+static double measureOnce( const std::string &sql, int iterations, SQLULEN rowsetSize, SQLULEN bindType, bool plan, Bind bind )
+{
+	SQLHSTMT statement = SQL_NULL_HSTMT;
+	SQLAllocHandle( SQL_HANDLE_STMT, connection, &statement );
+
+	SQLULEN fetched = 0;
+	SQLSetStmtAttr( statement, SQL_FBSTMT_CONVERT_PLAN, (SQLPOINTER)(intptr_t)( plan ? SQL_TRUE : SQL_FALSE ), 0 );
+	SQLSetStmtAttr( statement, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)bindType, 0 );
+	SQLSetStmtAttr( statement, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)rowsetSize, 0 );
+	SQLSetStmtAttr( statement, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0 );
+	bind( statement );
+
+	if ( !SQL_SUCCEEDED( SQLPrepare( statement, (SQLCHAR*)sql.c_str(), SQL_NTS ) ) )
+	{
+		printError( SQL_HANDLE_STMT, statement );
+		SQLFreeHandle( SQL_HANDLE_STMT, statement );
+		return 0;
+	}
+
+	double rows = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for ( int n = 0; n < iterations; ++n )
+	{
+		SQLExecute( statement );
+		while ( SQL_SUCCEEDED( SQLFetch( statement ) ) )
+			rows += fetched;
+		SQLFreeStmt( statement, SQL_CLOSE );
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	SQLFreeHandle( SQL_HANDLE_STMT, statement );
+
+	return rows ? elapsed.count() * 1e9 / rows : 0;
+}
+
+//
+// Reports a binding fetched without and with the conversion plan.
+//
+template <typename Bind>
+static void measure( const char *name, const std::string &sql, int iterations, SQLULEN rowsetSize, SQLULEN bindType, Bind bind )
+{
+	double perRow = measureOnce( sql, iterations, rowsetSize, bindType, false, bind );
+	double plan = measureOnce( sql, iterations, rowsetSize, bindType, true, bind );
+
+	if ( !perRow || !plan )
+		return;
+
+	printf( "%-36s %10.1f ns/row %10.1f ns/row %8.2fx\n", name, perRow, plan, perRow / plan );
+}
+
+struct Row
+{
+	SQLINTEGER	i[COLUMN_GROUPS];
+	SQLBIGINT	b[COLUMN_GROUPS];
+	SQLDOUBLE	d[COLUMN_GROUPS];
+	SQLREAL		f[COLUMN_GROUPS];
+	SQLLEN		ind[COLUMNS];
+};
+
+struct TextRow
+{
+	SQLCHAR		text[COLUMNS][32];
+	SQLLEN		ind[COLUMNS];
+};
+
+static void bindRow( SQLHSTMT statement, Row *row )
+{
+	for ( int n = 0; n < COLUMN_GROUPS; ++n )
+	{
+		SQLBindCol( statement, n * 3 + 1, SQL_C_SLONG, &row->i[n], 0, &row->ind[n * 3] );
+		SQLBindCol( statement, n * 3 + 2, SQL_C_SBIGINT, &row->b[n], 0, &row->ind[n * 3 + 1] );
+		SQLBindCol( statement, n * 3 + 3, SQL_C_DOUBLE, &row->d[n], 0, &row->ind[n * 3 + 2] );
+	}
+}
+
+int main( int argc, char **argv )
+{
+	const char *dsn = argc > 1 ? argv[1] : getenv( "FIREBIRD_ODBC_CONNECTION" );
+	int rows = argc > 2 ? atoi( argv[2] ) : 100000;
+	int iterations = argc > 3 ? atoi( argv[3] ) : 10;
+
+	if ( !dsn || !*dsn )
+	{
+		fprintf( stderr, "no connection string, pass one or set FIREBIRD_ODBC_CONNECTION\n" );
+		return 1;
+	}
+
+	SQLHENV environment = SQL_NULL_HENV;
+	SQLAllocHandle( SQL_HANDLE_ENV, SQL_NULL_HANDLE, &environment );
+	SQLSetEnvAttr( environment, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0 );
+	SQLAllocHandle( SQL_HANDLE_DBC, environment, &connection );
+
+	if ( !SQL_SUCCEEDED( SQLDriverConnect( connection, NULL, (SQLCHAR*)dsn, SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT ) ) )
+	{
+		printError( SQL_HANDLE_DBC, connection );
+		return 1;
+	}
+
+	std::string sql = generatorSql( rows );
+	printf( "%d rows of %d columns, %d iterations\n\n", rows, COLUMNS, iterations );
+	printf( "%-36s %17s %17s %9s\n", "binding", "per-row dispatch", "plan", "speedup" );
+
+	std::vector<Row> rowset( ROWSET_SIZE );
+	std::vector<TextRow> textRowset( ROWSET_SIZE );
+
+	measure( "C types, one row", sql, iterations, 1, sizeof( Row ), [&]( SQLHSTMT statement )
+	{
+		bindRow( statement, &rowset[0] );
+	} );
+
+	measure( "C types, row-wise rowset", sql, iterations, ROWSET_SIZE, sizeof( Row ), [&]( SQLHSTMT statement )
+	{
+		bindRow( statement, &rowset[0] );
+	} );
+
+	static SQLINTEGER columnI[COLUMN_GROUPS][ROWSET_SIZE];
+	static SQLBIGINT columnB[COLUMN_GROUPS][ROWSET_SIZE];
+	static SQLDOUBLE columnD[COLUMN_GROUPS][ROWSET_SIZE];
+	static SQLLEN columnInd[COLUMNS][ROWSET_SIZE];
+
+	measure( "C types, column-wise rowset", sql, iterations, ROWSET_SIZE, SQL_BIND_BY_COLUMN, [&]( SQLHSTMT statement )
+	{
+		for ( int n = 0; n < COLUMN_GROUPS; ++n )
+		{
+			SQLBindCol( statement, n * 3 + 1, SQL_C_SLONG, columnI[n], 0, columnInd[n * 3] );
+			SQLBindCol( statement, n * 3 + 2, SQL_C_SBIGINT, columnB[n], 0, columnInd[n * 3 + 1] );
+			SQLBindCol( statement, n * 3 + 3, SQL_C_DOUBLE, columnD[n], 0, columnInd[n * 3 + 2] );
+		}
+	} );
+
+	measure( "other C types, row-wise rowset", sql, iterations, ROWSET_SIZE, sizeof( Row ), [&]( SQLHSTMT statement )
+	{
+		Row *row = &rowset[0];
+
+		for ( int n = 0; n < COLUMN_GROUPS; ++n )
+		{
+			SQLBindCol( statement, n * 3 + 1, SQL_C_DOUBLE, &row->d[n], 0, &row->ind[n * 3] );
+			SQLBindCol( statement, n * 3 + 2, SQL_C_SBIGINT, &row->b[n], 0, &row->ind[n * 3 + 1] );
+			SQLBindCol( statement, n * 3 + 3, SQL_C_FLOAT, &row->f[n], 0, &row->ind[n * 3 + 2] );
+		}
+	} );
+
+	measure( "text, row-wise rowset", sql, iterations, ROWSET_SIZE, sizeof( TextRow ), [&]( SQLHSTMT statement )
+	{
+		for ( int n = 0; n < COLUMNS; ++n )
+			SQLBindCol( statement, n + 1, SQL_C_CHAR, textRowset[0].text[n], sizeof( textRowset[0].text[n] ), &textRowset[0].ind[n] );
+	} );
+
+	SQLDisconnect( connection );
+	SQLFreeHandle( SQL_HANDLE_DBC, connection );
+	SQLFreeHandle( SQL_HANDLE_ENV, environment );
+
+	return 0;
+}
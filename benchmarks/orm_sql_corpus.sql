@@ -0,0 +1,31 @@
+SELECT "c"."Id", "c"."Name", "c"."Email", "c"."CreatedAt" FROM "Customers" AS "c" WHERE "c"."Id" = ?
+SELECT FIRST 1 "c"."Id", "c"."Name", "c"."Email" FROM "Customers" AS "c" WHERE "c"."Email" = ?
+SELECT "o"."Id", "o"."CustomerId", "o"."OrderDate", "o"."Total", "o0"."Id", "o0"."OrderId", "o0"."ProductId", "o0"."Quantity", "o0"."UnitPrice" FROM "Orders" AS "o" LEFT JOIN "OrderLines" AS "o0" ON "o"."Id" = "o0"."OrderId" WHERE "o"."CustomerId" = ? ORDER BY "o"."Id", "o0"."Id"
+INSERT INTO "Customers" ("Name", "Email", "CreatedAt") VALUES (?, ?, ?) RETURNING "Id"
+UPDATE "Customers" SET "Name" = ?, "Email" = ? WHERE "Id" = ?
+DELETE FROM "OrderLines" WHERE "Id" = ?
+SELECT COUNT(*) FROM "Orders" AS "o" WHERE ("o"."OrderDate" >= ?) AND ("o"."OrderDate" < ?)
+SELECT "p"."Id", "p"."Name", "p"."Price" FROM "Products" AS "p" WHERE "p"."Name" LIKE ? ESCAPE '\' ORDER BY "p"."Name" ROWS (? + 1) TO (? + ?)
+SELECT "t"."Id", "t"."Name" FROM (SELECT FIRST ? "p"."Id", "p"."Name" FROM "Products" AS "p" ORDER BY "p"."Price" DESC) AS "t" ORDER BY "t"."Name"
+select user0_.ID as ID1_4_0_, user0_.EMAIL as EMAIL2_4_0_, user0_.FIRST_NAME as FIRST_NA3_4_0_, user0_.LAST_NAME as LAST_NAM4_4_0_ from USERS user0_ where user0_.ID=?
+select orders0_.CUSTOMER_ID as CUSTOMER5_2_0_, orders0_.ID as ID1_2_0_, orders0_.ID as ID1_2_1_, orders0_.CREATED as CREATED2_2_1_, orders0_.STATUS as STATUS3_2_1_ from ORDERS orders0_ where orders0_.CUSTOMER_ID=?
+insert into ORDERS (CREATED, CUSTOMER_ID, STATUS, ID) values (?, ?, ?, ?)
+update ORDERS set CREATED=?, CUSTOMER_ID=?, STATUS=? where ID=?
+select gen_id(HIBERNATE_SEQUENCE, 1) from RDB$DATABASE
+select first ? product0_.ID as ID1_3_, product0_.NAME as NAME2_3_, product0_.PRICE as PRICE3_3_ from PRODUCTS product0_ where lower(product0_.NAME) like ? order by product0_.NAME asc
+SELECT users.id AS users_id, users.name AS users_name, users.fullname AS users_fullname FROM users WHERE users.name = ?
+SELECT addresses.id AS addresses_id, addresses.email_address AS addresses_email_address, addresses.user_id AS addresses_user_id FROM addresses WHERE ? = addresses.user_id ORDER BY addresses.id
+INSERT INTO addresses (id, email_address, user_id) VALUES (?, ?, ?)
+SELECT "auth_user"."id", "auth_user"."password", "auth_user"."last_login", "auth_user"."is_superuser", "auth_user"."username" FROM "auth_user" WHERE "auth_user"."username" = ?
+SELECT "django_session"."session_key", "django_session"."session_data", "django_session"."expire_date" FROM "django_session" WHERE ("django_session"."expire_date" > ? AND "django_session"."session_key" = ?)
+SELECT "Extent1"."ID" AS "ID", "Extent1"."NAME" AS "NAME", "Extent1"."CITY" AS "CITY" FROM "CUSTOMER" AS "Extent1" WHERE ("Extent1"."CITY" = ?) OR (("Extent1"."CITY" IS NULL) AND (? IS NULL))
+SELECT "GroupBy1"."A1" AS "C1" FROM (SELECT COUNT(1) AS "A1" FROM "ORDERS" AS "Extent1" WHERE "Extent1"."STATUS" = 'OPEN') AS "GroupBy1"
+SELECT "CUSTOMER"."NAME", {fn UCASE("CUSTOMER"."CITY")} FROM "CUSTOMER" WHERE "CUSTOMER"."ID" = ?
+SELECT "ORDERS"."ID", "ORDERS"."CREATED" FROM "ORDERS" WHERE "ORDERS"."CREATED" >= {d '2024-01-01'} AND "ORDERS"."CREATED" < {ts '2024-02-01 00:00:00'}
+SELECT {fn CONCAT("FIRST_NAME", {fn CONCAT(' ', "LAST_NAME")})} AS "FULL_NAME" FROM "EMPLOYEE" WHERE {fn LCASE("DEPT_NO")} = ?
+SELECT "E"."EMP_NO", "D"."DEPARTMENT" FROM {oj "EMPLOYEE" "E" LEFT OUTER JOIN "DEPARTMENT" "D" ON "E"."DEPT_NO" = "D"."DEPT_NO"} WHERE "E"."JOB_COUNTRY" = 'USA'
+{call GET_EMP_PROJ(?)}
+{? = call ORG_CHART}
+SELECT "OrderId", "ProductId", SUM("Quantity") FROM "OrderLines" /* report: totals per order */ GROUP BY "OrderId", "ProductId" HAVING SUM("Quantity") > ?
+SELECT "c"."Id" FROM "Customers" AS "c" /* it's a lookup by name */ WHERE "c"."Name" = 'O''Brien'
+MERGE INTO "Stock" AS "s" USING (SELECT CAST(? AS INTEGER) AS "ProductId", CAST(? AS INTEGER) AS "Quantity" FROM RDB$DATABASE) AS "n" ON "s"."ProductId" = "n"."ProductId" WHEN MATCHED THEN UPDATE SET "Quantity" = "s"."Quantity" + "n"."Quantity" WHEN NOT MATCHED THEN INSERT ("ProductId", "Quantity") VALUES ("n"."ProductId", "n"."Quantity")
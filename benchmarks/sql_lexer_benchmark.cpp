@@ -0,0 +1,115 @@
+// sql_lexer_benchmark.cpp — Microbenchmark of the SQL lexer
+//
+// Runs the statements of an ORM-generated SQL corpus, one per line,
+// through the checks every SQLPrepare does before the statement reaches
+// the server: the escape sequence scan that lets most statements skip
+// translation, and a full pass of the lexer over the text.
+//
+//   sql_lexer_benchmark [corpus.sql] [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include "IscSqlLexer.h"
+
+using namespace IscDbcLibrary;
+
+#ifndef SQL_CORPUS
+#define SQL_CORPUS "orm_sql_corpus.sql"
+#endif
+
+static volatile size_t sink;
+
+template <typename Pass>
+static void measure( const char *name, const std::vector<std::string> &corpus, int iterations, size_t bytes, Pass pass )
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for ( int n = 0; n < iterations; ++n )
+		for ( const std::string &sql : corpus )
+			sink = sink + pass( sql );
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	double statements = (double)iterations * corpus.size();
+
+	printf( "%-28s %10.1f ns/statement %10.1f MB/s\n", name,
+			elapsed.count() * 1e9 / statements,
+			(double)bytes * iterations / elapsed.count() / ( 1024 * 1024 ) );
+}
+
+int main( int argc, char **argv )
+{
+	const char *path = argc > 1 ? argv[1] : SQL_CORPUS;
+	int iterations = argc > 2 ? atoi( argv[2] ) : 20000;
+
+	std::ifstream file( path );
+	std::vector<std::string> corpus;
+	std::string line;
+	size_t bytes = 0;
+	size_t plain = 0;
+
+	while ( std::getline( file, line ) )
+		if ( !line.empty() )
+		{
+			corpus.push_back( line );
+			bytes += line.size();
+			if ( !IscSqlLexer::findEscape( line.c_str(), line.size() ) )
+				++plain;
+		}
+
+	if ( corpus.empty() )
+	{
+		fprintf( stderr, "no statements in %s\n", path );
+		return 1;
+	}
+
+	printf( "%zu statements, %zu bytes, %zu without escape sequences, %d iterations\n\n",
+			corpus.size(), bytes, plain, iterations );
+
+	measure( "byte loop for '{'", corpus, iterations, bytes, []( const std::string &sql )
+	{
+		const char *p = sql.c_str();
+		const char *end = p + sql.size();
+		while ( p < end && *p != '{' )
+			++p;
+		return (size_t)( p - sql.c_str() );
+	} );
+
+	measure( "findEscape", corpus, iterations, bytes, []( const std::string &sql )
+	{
+		return (size_t)IscSqlLexer::findEscape( sql.c_str(), sql.size() );
+	} );
+
+	measure( "lexer, every token", corpus, iterations, bytes, []( const std::string &sql )
+	{
+		IscSqlLexer lexer( sql.c_str(), sql.size() );
+		SqlToken token;
+		size_t count = 0;
+		while ( lexer.next( token ) )
+			++count;
+		return count;
+	} );
+
+	measure( "lexer, parameter markers", corpus, iterations, bytes, []( const std::string &sql )
+	{
+		IscSqlLexer lexer( sql.c_str(), sql.size() );
+		SqlToken token;
+		size_t count = 0;
+		while ( lexer.next( token ) )
+			if ( token.kind == '?' )
+				++count;
+		return count;
+	} );
+
+	measure( "tokenize", corpus, iterations, bytes, []( const std::string &sql )
+	{
+		std::vector<SqlToken> tokens;
+		IscSqlLexer::tokenize( sql.c_str(), tokens );
+		return tokens.size();
+	} );
+
+	return 0;
+}
@@ -8,6 +8,10 @@
 #include <array>
 #include <vector>
 
+#ifndef SQL_FBSTMT_EXECUTE_BLOCK
+#define SQL_FBSTMT_EXECUTE_BLOCK 11986
+#endif
+
 // ============================================================================
 // ArrayBindingTest: ODBC Array of Parameter Values
 // ============================================================================
@@ -987,3 +991,457 @@ TEST_F(ArrayBindingTest, WithoutStatusPointers) {
     Commit();
     EXPECT_EQ(CountRows(), ARRAY_SIZE);
 }
+
+// ============================================================================
+// 18. Large row-wise array with BLOB values (one IBatch on Firebird 4+)
+// ============================================================================
+TEST_F(ArrayBindingTest, RowWiseBatchWithBlobs) {
+    SKIP_ON_FIREBIRD6();
+    const int ARRAY_SIZE = 1000;
+    SQLRETURN ret;
+
+    ExecIgnoreError("DROP TABLE ARRAY_BIND_BLOB");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE TABLE ARRAY_BIND_BLOB (I INTEGER NOT NULL, B BLOB SUB_TYPE TEXT)");
+    Commit();
+    ReallocStmt();
+
+    struct ParamRow {
+        SQLINTEGER i;
+        SQLLEN     iInd;
+        SQLCHAR    b[64];
+        SQLLEN     bInd;
+    };
+
+    std::vector<ParamRow> rows(ARRAY_SIZE);
+    for (int n = 0; n < ARRAY_SIZE; ++n) {
+        rows[n].i = n + 1;
+        rows[n].iInd = 0;
+        sprintf((char*)rows[n].b, "Blob value %d", n + 1);
+        rows[n].bInd = n % 10 == 9 ? SQL_NULL_DATA : SQL_NTS;
+    }
+
+    std::vector<SQLUSMALLINT> status_array(ARRAY_SIZE);
+    SQLULEN nprocessed = 0;
+
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)(intptr_t)sizeof(ParamRow), 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)ARRAY_SIZE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, status_array.data(), 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &nprocessed, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLPrepare(hStmt, (SQLCHAR*)"INSERT INTO ARRAY_BIND_BLOB (I, B) VALUES (?, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ret = SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                           0, 0, &rows[0].i, sizeof(rows[0].i), &rows[0].iInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindParameter(hStmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+                           63, 0, rows[0].b, sizeof(rows[0].b), &rows[0].bInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLExecute(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    EXPECT_EQ(nprocessed, (SQLULEN)ARRAY_SIZE);
+    for (int n = 0; n < ARRAY_SIZE; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_SUCCESS) << "Row " << n;
+
+    Commit();
+
+    SQLHSTMT hStmt2 = SQL_NULL_HSTMT;
+    SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt2);
+    ret = SQLExecDirect(hStmt2, (SQLCHAR*)"SELECT COUNT(*), COUNT(B), MAX(CAST(B AS VARCHAR(64))) FROM ARRAY_BIND_BLOB WHERE I IN (1, 777, 1000)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt2);
+    SQLINTEGER count = 0, countBlobs = 0;
+    SQLCHAR maxBlob[65] = {};
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt2, 1, SQL_C_SLONG, &count, 0, &ind);
+    SQLBindCol(hStmt2, 2, SQL_C_SLONG, &countBlobs, 0, &ind);
+    SQLBindCol(hStmt2, 3, SQL_C_CHAR, maxBlob, sizeof(maxBlob), &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt2)));
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt2);
+
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(countBlobs, 2);      // row 1000 was bound NULL
+    EXPECT_STREQ((char*)maxBlob, "Blob value 777");
+
+    ExecIgnoreError("DROP TABLE ARRAY_BIND_BLOB");
+    Commit();
+}
+
+// ============================================================================
+// 19. A failing parameter set stops the array and is reported per row
+// ============================================================================
+TEST_F(ArrayBindingTest, RowWiseFailedRowStatus) {
+    SKIP_ON_FIREBIRD6();
+    const int ARRAY_SIZE = 10;
+    const int FAILED_ROW = 6;
+    SQLRETURN ret;
+
+    struct ParamRow {
+        SQLINTEGER i;
+        SQLLEN     iInd;
+        SQLCHAR    t[51];
+        SQLLEN     tInd;
+    };
+
+    ParamRow rows[ARRAY_SIZE] = {};
+    for (int n = 0; n < ARRAY_SIZE; ++n)
+        rows[n] = {n + 1, n == FAILED_ROW ? SQL_NULL_DATA : 0, "Row", SQL_NTS};
+
+    SQLUSMALLINT status_array[ARRAY_SIZE] = {};
+    SQLULEN nprocessed = 0;
+
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)(intptr_t)sizeof(ParamRow), 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)ARRAY_SIZE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, status_array, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &nprocessed, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLPrepare(hStmt, (SQLCHAR*)"INSERT INTO ARRAY_BIND_TEST (I, T) VALUES (?, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ret = SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                           0, 0, &rows[0].i, sizeof(rows[0].i), &rows[0].iInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindParameter(hStmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                           50, 0, rows[0].t, 51, &rows[0].tInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    // I is NOT NULL
+    ret = SQLExecute(hStmt);
+    EXPECT_EQ(ret, SQL_ERROR);
+
+    EXPECT_EQ(nprocessed, (SQLULEN)FAILED_ROW + 1);
+    for (int n = 0; n < FAILED_ROW; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_SUCCESS) << "Row " << n;
+    EXPECT_EQ(status_array[FAILED_ROW], SQL_PARAM_ERROR);
+    for (int n = FAILED_ROW + 1; n < ARRAY_SIZE; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_UNUSED) << "Row " << n;
+
+    Commit();
+    EXPECT_EQ(CountRows(), FAILED_ROW);
+}
+
+// ============================================================================
+// 20. SQL_FBSTMT_EXECUTE_BLOCK is off by default and can be switched on
+// ============================================================================
+TEST_F(ArrayBindingTest, ExecuteBlockAttribute) {
+    SQLULEN value = SQL_TRUE;
+    SQLRETURN ret = SQLGetStmtAttr(hStmt, SQL_FBSTMT_EXECUTE_BLOCK, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(value, (SQLULEN)SQL_FALSE);
+
+    ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_EXECUTE_BLOCK, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLGetStmtAttr(hStmt, SQL_FBSTMT_EXECUTE_BLOCK, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(value, (SQLULEN)SQL_TRUE);
+}
+
+// ============================================================================
+// 21. EXECUTE BLOCK: the update counts of all sets add up in SQLRowCount
+// ============================================================================
+TEST_F(ArrayBindingTest, ExecuteBlockRowCounts) {
+    SKIP_ON_FIREBIRD6();
+    // I = 1 once, 2 twice, 3 three times; 4 is not there
+    for (int i = 1; i <= 3; ++i)
+        for (int n = 0; n < i; ++n) {
+            char sql[128];
+            sprintf(sql, "INSERT INTO ARRAY_BIND_TEST (I, T) VALUES (%d, 'old')", i);
+            ExecDirect(sql);
+        }
+    Commit();
+    ReallocStmt();
+
+    const int ARRAY_SIZE = 4;
+    SQLINTEGER ids[ARRAY_SIZE] = {1, 2, 3, 4};
+    SQLLEN id_ind[ARRAY_SIZE] = {0, 0, 0, 0};
+    SQLUSMALLINT status_array[ARRAY_SIZE] = {};
+    SQLULEN nprocessed = 0;
+    SQLRETURN ret;
+
+    ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_EXECUTE_BLOCK, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)ARRAY_SIZE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, status_array, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &nprocessed, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                           ids, sizeof(*ids), id_ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"UPDATE ARRAY_BIND_TEST SET T = 'new' WHERE I = ?", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    EXPECT_EQ(nprocessed, (SQLULEN)ARRAY_SIZE);
+    for (int n = 0; n < ARRAY_SIZE; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_SUCCESS) << "Row " << n;
+
+    SQLLEN rowCount = 0;
+    ret = SQLRowCount(hStmt, &rowCount);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(rowCount, 6);
+
+    Commit();
+    EXPECT_EQ(CountRows(), 6);
+    EXPECT_EQ(GetValue(3), "new");
+}
+
+// ============================================================================
+// 22. EXECUTE BLOCK: a constraint violation mid-array keeps the sets before it
+// ============================================================================
+TEST_F(ArrayBindingTest, ExecuteBlockFailedRowStatus) {
+    SKIP_ON_FIREBIRD6();
+    TempTable table(this, "ARRAY_BIND_BLOCK", "I INTEGER NOT NULL PRIMARY KEY, T VARCHAR(20)");
+
+    const int ARRAY_SIZE = 10;
+    const int FAILED_ROW = 6;
+    SQLINTEGER ids[ARRAY_SIZE];
+    SQLLEN id_ind[ARRAY_SIZE];
+    SQLUSMALLINT status_array[ARRAY_SIZE] = {};
+    SQLULEN nprocessed = 0;
+    SQLRETURN ret;
+
+    for (int n = 0; n < ARRAY_SIZE; ++n) {
+        ids[n] = n == FAILED_ROW ? 2 : n + 1;   // duplicates the key of row 1
+        id_ind[n] = 0;
+    }
+
+    ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_EXECUTE_BLOCK, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)ARRAY_SIZE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, status_array, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &nprocessed, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                           ids, sizeof(*ids), id_ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"INSERT INTO ARRAY_BIND_BLOCK (I, T) VALUES (?, 'Row')", SQL_NTS);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(GetSqlState(SQL_HANDLE_STMT, hStmt), "23000");
+
+    EXPECT_EQ(nprocessed, (SQLULEN)FAILED_ROW + 1);
+    for (int n = 0; n < FAILED_ROW; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_SUCCESS) << "Row " << n;
+    EXPECT_EQ(status_array[FAILED_ROW], SQL_PARAM_ERROR);
+    for (int n = FAILED_ROW + 1; n < ARRAY_SIZE; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_UNUSED) << "Row " << n;
+
+    Commit();
+    ReallocStmt();
+
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT COUNT(*), MAX(I) FROM ARRAY_BIND_BLOCK", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLINTEGER count = 0, maxId = 0;
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &count, 0, &ind);
+    SQLBindCol(hStmt, 2, SQL_C_SLONG, &maxId, 0, &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+    EXPECT_EQ(count, FAILED_ROW);
+    EXPECT_EQ(maxId, FAILED_ROW);
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+}
+
+// ============================================================================
+// 23. EXECUTE BLOCK: CHAR, VARCHAR, NUMERIC and BLOB parameters, with NULLs
+// ============================================================================
+TEST_F(ArrayBindingTest, ExecuteBlockParameterTypes) {
+    SKIP_ON_FIREBIRD6();
+    TempTable table(this, "ARRAY_BIND_BLOCK",
+        "I INTEGER NOT NULL, C CHAR(10), V VARCHAR(40), N NUMERIC(15, 2), B BLOB SUB_TYPE TEXT");
+
+    const int ARRAY_SIZE = 20;
+    SQLRETURN ret;
+
+    struct ParamRow {
+        SQLINTEGER i;
+        SQLLEN     iInd;
+        SQLCHAR    c[11];
+        SQLLEN     cInd;
+        SQLCHAR    v[41];
+        SQLLEN     vInd;
+        SQLCHAR    num[20];
+        SQLLEN     numInd;
+        SQLCHAR    b[64];
+        SQLLEN     bInd;
+    };
+
+    std::vector<ParamRow> rows(ARRAY_SIZE);
+    for (int n = 0; n < ARRAY_SIZE; ++n) {
+        rows[n].i = n + 1;
+        rows[n].iInd = 0;
+        sprintf((char*)rows[n].c, "C%d", n + 1);
+        rows[n].cInd = SQL_NTS;
+        sprintf((char*)rows[n].v, "Varchar value %d", n + 1);
+        rows[n].vInd = n % 5 == 4 ? SQL_NULL_DATA : SQL_NTS;
+        sprintf((char*)rows[n].num, "%d.%02d", (n + 1) * 1000, n + 1);
+        rows[n].numInd = SQL_NTS;
+        sprintf((char*)rows[n].b, "Blob value %d", n + 1);
+        rows[n].bInd = n % 7 == 6 ? SQL_NULL_DATA : SQL_NTS;
+    }
+
+    std::vector<SQLUSMALLINT> status_array(ARRAY_SIZE);
+    SQLULEN nprocessed = 0;
+
+    ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_EXECUTE_BLOCK, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)(intptr_t)sizeof(ParamRow), 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)ARRAY_SIZE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, status_array.data(), 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &nprocessed, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLPrepare(hStmt, (SQLCHAR*)"INSERT INTO ARRAY_BIND_BLOCK (I, C, V, N, B) VALUES (?, ?, ?, ?, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ret = SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                           0, 0, &rows[0].i, sizeof(rows[0].i), &rows[0].iInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindParameter(hStmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR,
+                           10, 0, rows[0].c, sizeof(rows[0].c), &rows[0].cInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindParameter(hStmt, 3, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                           40, 0, rows[0].v, sizeof(rows[0].v), &rows[0].vInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindParameter(hStmt, 4, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_NUMERIC,
+                           15, 2, rows[0].num, sizeof(rows[0].num), &rows[0].numInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindParameter(hStmt, 5, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+                           63, 0, rows[0].b, sizeof(rows[0].b), &rows[0].bInd);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLExecute(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    EXPECT_EQ(nprocessed, (SQLULEN)ARRAY_SIZE);
+    for (int n = 0; n < ARRAY_SIZE; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_SUCCESS) << "Row " << n;
+
+    Commit();
+    ReallocStmt();
+
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT I, C, V, N, CAST(B AS VARCHAR(64)) FROM ARRAY_BIND_BLOCK ORDER BY I", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLINTEGER i = 0;
+    SQLCHAR c[11] = {}, v[41] = {}, num[20] = {}, b[65] = {};
+    SQLLEN iInd = 0, cInd = 0, vInd = 0, numInd = 0, bInd = 0;
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &i, 0, &iInd);
+    SQLBindCol(hStmt, 2, SQL_C_CHAR, c, sizeof(c), &cInd);
+    SQLBindCol(hStmt, 3, SQL_C_CHAR, v, sizeof(v), &vInd);
+    SQLBindCol(hStmt, 4, SQL_C_CHAR, num, sizeof(num), &numInd);
+    SQLBindCol(hStmt, 5, SQL_C_CHAR, b, sizeof(b), &bInd);
+
+    for (int n = 0; n < ARRAY_SIZE; ++n) {
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt))) << "Row " << n;
+        EXPECT_EQ(i, rows[n].i);
+
+        char expected[64];
+        sprintf(expected, "%-10s", (char*)rows[n].c);
+        EXPECT_STREQ((char*)c, expected) << "Row " << n;
+
+        if (rows[n].vInd == SQL_NULL_DATA)
+            EXPECT_EQ(vInd, SQL_NULL_DATA) << "Row " << n;
+        else
+            EXPECT_STREQ((char*)v, (char*)rows[n].v) << "Row " << n;
+
+        EXPECT_STREQ((char*)num, (char*)rows[n].num) << "Row " << n;
+
+        if (rows[n].bInd == SQL_NULL_DATA)
+            EXPECT_EQ(bInd, SQL_NULL_DATA) << "Row " << n;
+        else
+            EXPECT_STREQ((char*)b, (char*)rows[n].b) << "Row " << n;
+    }
+    EXPECT_EQ(SQLFetch(hStmt), SQL_NO_DATA);
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+}
+
+// ============================================================================
+// 24. Binary BLOB values in a batch: small ones travel in the batch buffer,
+//     one over 1 MB is written on its own; all read back byte for byte
+// ============================================================================
+TEST_F(ArrayBindingTest, ColumnWiseBatchWithBinaryBlobs) {
+    SKIP_ON_FIREBIRD6();
+    const int ARRAY_SIZE = 4;
+    const SQLLEN BUFFER = 1536 * 1024;
+    const SQLLEN lengths[ARRAY_SIZE] = { 100, BUFFER, SQL_NULL_DATA, 3000 };
+    SQLRETURN ret;
+
+    ExecIgnoreError("DROP TABLE ARRAY_BIND_BINBLOB");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE TABLE ARRAY_BIND_BINBLOB (I INTEGER NOT NULL, B BLOB SUB_TYPE BINARY)");
+    Commit();
+    ReallocStmt();
+
+    SQLINTEGER ids[ARRAY_SIZE];
+    SQLLEN idInd[ARRAY_SIZE] = {};
+    std::vector<unsigned char> blobs(ARRAY_SIZE * BUFFER);
+    SQLLEN blobInd[ARRAY_SIZE];
+
+    for (int n = 0; n < ARRAY_SIZE; ++n) {
+        ids[n] = n + 1;
+        blobInd[n] = lengths[n];
+        for (SQLLEN k = 0; k < BUFFER; ++k)
+            blobs[n * BUFFER + k] = (unsigned char)(k * 7 + n);
+    }
+
+    std::vector<SQLUSMALLINT> status_array(ARRAY_SIZE);
+
+    SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)ARRAY_SIZE, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, status_array.data(), 0);
+
+    ret = SQLPrepare(hStmt, (SQLCHAR*)"INSERT INTO ARRAY_BIND_BINBLOB (I, B) VALUES (?, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                     0, 0, ids, 0, idInd);
+    SQLBindParameter(hStmt, 2, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY,
+                     BUFFER, 0, blobs.data(), BUFFER, blobInd);
+
+    ret = SQLExecute(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    for (int n = 0; n < ARRAY_SIZE; ++n)
+        EXPECT_EQ(status_array[n], SQL_PARAM_SUCCESS) << "Row " << n;
+    Commit();
+
+    ReallocStmt();
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT I, B FROM ARRAY_BIND_BINBLOB ORDER BY I", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    std::vector<unsigned char> value(BUFFER);
+    for (int n = 0; n < ARRAY_SIZE; ++n) {
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt))) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLLEN ind = 0;
+        ret = SQLGetData(hStmt, 2, SQL_C_BINARY, value.data(), BUFFER, &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        ASSERT_EQ(ind, lengths[n]) << "Row " << n;
+        if (ind != SQL_NULL_DATA)
+            EXPECT_EQ(memcmp(value.data(), &blobs[n * BUFFER], ind), 0) << "Row " << n;
+    }
+    EXPECT_EQ(SQLFetch(hStmt), SQL_NO_DATA);
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+
+    ExecIgnoreError("DROP TABLE ARRAY_BIND_BINBLOB");
+    Commit();
+}
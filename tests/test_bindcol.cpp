@@ -249,3 +249,396 @@ TEST_F(BindColTest, BindBeyondResultSetWidth) {
     // Extra column should not have been modified
     EXPECT_STREQ((char*)extra, "untouched");
 }
+
+// --- Rowset fetch (SQL_ATTR_ROW_ARRAY_SIZE > 1) ---
+// The rowset is fetched as one block and converted column by column:
+// the numeric columns go through the columnar kernels, LABEL through
+// the per-row conversion. 10 rows in rowsets of 4 give 4 + 4 + 2.
+
+static const char *rowsetSql =
+    "SELECT ID, CAST(ID AS DOUBLE PRECISION) / 2, LABEL, "
+    "CASE WHEN MOD(ID, 3) = 0 THEN NULL ELSE ID END "
+    "FROM ODBC_TEST_BINDCOL ORDER BY ID";
+
+TEST_F(BindColTest, RowsetColumnWiseBinding) {
+    const int N = 4;
+    SQLINTEGER id[N] = {};
+    SQLLEN idInd[N] = {};
+    SQLDOUBLE half[N] = {};
+    SQLLEN halfInd[N] = {};
+    SQLCHAR label[N][16] = {};
+    SQLLEN labelInd[N] = {};
+    SQLINTEGER opt[N] = {};
+    SQLLEN optInd[N] = {};
+    SQLULEN fetched = 0;
+    SQLUSMALLINT status[N] = {};
+
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)N, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_STATUS_PTR, status, 0);
+
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, id, 0, idInd);
+    SQLBindCol(hStmt, 2, SQL_C_DOUBLE, half, 0, halfInd);
+    SQLBindCol(hStmt, 3, SQL_C_CHAR, label, sizeof(label[0]), labelInd);
+    SQLBindCol(hStmt, 4, SQL_C_SLONG, opt, 0, optInd);
+
+    SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)rowsetSql, SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    int total = 0;
+    while (SQL_SUCCEEDED(rc = SQLFetch(hStmt))) {
+        ASSERT_GT(fetched, 0u);
+        for (SQLULEN r = 0; r < fetched; r++) {
+            int expect = ++total;
+            EXPECT_EQ(status[r], SQL_ROW_SUCCESS);
+            EXPECT_EQ(id[r], expect);
+            EXPECT_DOUBLE_EQ(half[r], expect / 2.0);
+            char expected[32];
+            snprintf(expected, sizeof(expected), "foo%d", expect);
+            EXPECT_STREQ((char*)label[r], expected);
+            if (expect % 3 == 0) {
+                EXPECT_EQ(optInd[r], SQL_NULL_DATA);
+            } else {
+                EXPECT_EQ(optInd[r], (SQLLEN)sizeof(SQLINTEGER));
+                EXPECT_EQ(opt[r], expect);
+            }
+        }
+        if (fetched < N)
+            EXPECT_EQ(status[fetched], SQL_ROW_NOROW);
+    }
+    EXPECT_EQ(rc, SQL_NO_DATA);
+    EXPECT_EQ(total, 10);
+}
+
+TEST_F(BindColTest, RowsetRowWiseBinding) {
+    struct Row {
+        SQLINTEGER id;      SQLLEN idInd;
+        SQLDOUBLE half;     SQLLEN halfInd;
+        SQLCHAR label[16];  SQLLEN labelInd;
+        SQLINTEGER opt;     SQLLEN optInd;
+    };
+    const int N = 4;
+    Row rows[N] = {};
+    SQLULEN fetched = 0;
+
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)sizeof(Row), 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)N, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &rows[0].id, 0, &rows[0].idInd);
+    SQLBindCol(hStmt, 2, SQL_C_DOUBLE, &rows[0].half, 0, &rows[0].halfInd);
+    SQLBindCol(hStmt, 3, SQL_C_CHAR, rows[0].label, sizeof(rows[0].label), &rows[0].labelInd);
+    SQLBindCol(hStmt, 4, SQL_C_SLONG, &rows[0].opt, 0, &rows[0].optInd);
+
+    SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)rowsetSql, SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    int total = 0;
+    while (SQL_SUCCEEDED(rc = SQLFetch(hStmt))) {
+        for (SQLULEN r = 0; r < fetched; r++) {
+            int expect = ++total;
+            EXPECT_EQ(rows[r].id, expect);
+            EXPECT_DOUBLE_EQ(rows[r].half, expect / 2.0);
+            char expected[32];
+            snprintf(expected, sizeof(expected), "foo%d", expect);
+            EXPECT_STREQ((char*)rows[r].label, expected);
+            if (expect % 3 == 0) {
+                EXPECT_EQ(rows[r].optInd, SQL_NULL_DATA);
+            } else {
+                EXPECT_EQ(rows[r].opt, expect);
+            }
+        }
+    }
+    EXPECT_EQ(rc, SQL_NO_DATA);
+    EXPECT_EQ(total, 10);
+}
+
+// --- Wide binding through the conversion plan ---
+// 24 fixed-width columns bound to one contiguous row structure, fetched
+// one row at a time and as a rowset; every column must land at its place.
+
+TEST_F(BindColTest, WideRowBindingConversionPlan) {
+    const int COLS = 24;
+    struct Row {
+        SQLINTEGER ints[COLS / 2];
+        SQLDOUBLE doubles[COLS / 2];
+        SQLLEN ind[COLS];
+    };
+
+    std::string sql = "SELECT ";
+    for (int c = 0; c < COLS / 2; c++) {
+        char col[96];
+        snprintf(col, sizeof(col), "%sID + %d", c ? ", " : "", c);
+        sql += col;
+    }
+    for (int c = 0; c < COLS / 2; c++) {
+        char col[96];
+        snprintf(col, sizeof(col), ", CAST(ID AS DOUBLE PRECISION) * %d", c);
+        sql += col;
+    }
+    sql += " FROM ODBC_TEST_BINDCOL ORDER BY ID";
+
+    for (int arraySize : {1, 8}) {
+        ReallocStmt();
+        Row rows[8] = {};
+        SQLULEN fetched = 0;
+
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)sizeof(Row), 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)arraySize, 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+
+        for (int c = 0; c < COLS / 2; c++) {
+            SQLBindCol(hStmt, c + 1, SQL_C_SLONG, &rows[0].ints[c], 0, &rows[0].ind[c]);
+            SQLBindCol(hStmt, COLS / 2 + c + 1, SQL_C_DOUBLE, &rows[0].doubles[c], 0,
+                       &rows[0].ind[COLS / 2 + c]);
+        }
+
+        SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)sql.c_str(), SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+        int total = 0;
+        while (SQL_SUCCEEDED(SQLFetch(hStmt))) {
+            for (SQLULEN r = 0; r < fetched; r++) {
+                int id = ++total;
+                for (int c = 0; c < COLS / 2; c++) {
+                    EXPECT_EQ(rows[r].ints[c], id + c);
+                    EXPECT_DOUBLE_EQ(rows[r].doubles[c], (double)id * c);
+                    EXPECT_EQ(rows[r].ind[c], (SQLLEN)sizeof(SQLINTEGER));
+                }
+            }
+        }
+        EXPECT_EQ(total, 10) << "array size " << arraySize;
+    }
+}
+
+// --- Identity kernels of the conversion plan ---
+// Every column bound to the C type of its SQL type, adjacent in the row
+// structure, with NULLs in between; fetched row-wise one row at a time,
+// row-wise as a rowset and column-wise as a rowset.
+
+TEST_F(BindColTest, MatchingCTypesConversionPlan) {
+    const char *sql =
+        "SELECT CAST(ID AS SMALLINT), ID, CAST(ID * 1000000000000 AS BIGINT),"
+        " CAST(ID / 2.0 AS FLOAT), CAST(ID AS DOUBLE PRECISION) / 4,"
+        " IIF(MOD(ID, 3) = 0, NULL, CAST(ID - 100 AS BIGINT))"
+        " FROM ODBC_TEST_BINDCOL ORDER BY ID";
+
+    struct Row {
+        SQLSMALLINT s;
+        SQLINTEGER i;
+        SQLBIGINT b;
+        SQLREAL f;
+        SQLDOUBLE d;
+        SQLBIGINT n;
+        SQLLEN ind[6];
+    };
+
+    auto check = [](int id, SQLSMALLINT s, SQLINTEGER i, SQLBIGINT b, SQLREAL f,
+                    SQLDOUBLE d, SQLBIGINT n, const SQLLEN *ind, size_t strideInd) {
+        EXPECT_EQ(s, id);
+        EXPECT_EQ(i, id);
+        EXPECT_EQ(b, (SQLBIGINT)id * 1000000000000LL);
+        EXPECT_FLOAT_EQ(f, id / 2.0f);
+        EXPECT_DOUBLE_EQ(d, id / 4.0);
+        const SQLLEN sizes[6] = {sizeof(SQLSMALLINT), sizeof(SQLINTEGER), sizeof(SQLBIGINT),
+                                 sizeof(SQLREAL), sizeof(SQLDOUBLE), sizeof(SQLBIGINT)};
+        for (int c = 0; c < 5; c++)
+            EXPECT_EQ(*(const SQLLEN*)((const char*)ind + c * strideInd), sizes[c]) << "column " << c + 1;
+        const SQLLEN nInd = *(const SQLLEN*)((const char*)ind + 5 * strideInd);
+        if (id % 3 == 0) {
+            EXPECT_EQ(nInd, SQL_NULL_DATA) << "row " << id;
+        } else {
+            EXPECT_EQ(nInd, (SQLLEN)sizeof(SQLBIGINT)) << "row " << id;
+            EXPECT_EQ(n, (SQLBIGINT)id - 100);
+        }
+    };
+
+    for (int arraySize : {1, 8}) {
+        ReallocStmt();
+        Row rows[8] = {};
+        SQLULEN fetched = 0;
+
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)sizeof(Row), 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)arraySize, 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+
+        SQLBindCol(hStmt, 1, SQL_C_SSHORT, &rows[0].s, 0, &rows[0].ind[0]);
+        SQLBindCol(hStmt, 2, SQL_C_SLONG, &rows[0].i, 0, &rows[0].ind[1]);
+        SQLBindCol(hStmt, 3, SQL_C_SBIGINT, &rows[0].b, 0, &rows[0].ind[2]);
+        SQLBindCol(hStmt, 4, SQL_C_FLOAT, &rows[0].f, 0, &rows[0].ind[3]);
+        SQLBindCol(hStmt, 5, SQL_C_DOUBLE, &rows[0].d, 0, &rows[0].ind[4]);
+        SQLBindCol(hStmt, 6, SQL_C_SBIGINT, &rows[0].n, 0, &rows[0].ind[5]);
+
+        SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)sql, SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+        int total = 0;
+        while (SQL_SUCCEEDED(SQLFetch(hStmt))) {
+            for (SQLULEN r = 0; r < fetched; r++) {
+                const Row &row = rows[r];
+                check(++total, row.s, row.i, row.b, row.f, row.d, row.n, row.ind, sizeof(SQLLEN));
+            }
+        }
+        EXPECT_EQ(total, 10) << "row-wise, array size " << arraySize;
+    }
+
+    // column-wise
+    ReallocStmt();
+    const int ROWS = 8;
+    SQLSMALLINT s[ROWS];
+    SQLINTEGER i[ROWS];
+    SQLBIGINT b[ROWS], n[ROWS];
+    SQLREAL f[ROWS];
+    SQLDOUBLE d[ROWS];
+    SQLLEN ind[6][ROWS];
+    SQLULEN fetched = 0;
+
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)ROWS, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+
+    SQLBindCol(hStmt, 1, SQL_C_SSHORT, s, 0, ind[0]);
+    SQLBindCol(hStmt, 2, SQL_C_SLONG, i, 0, ind[1]);
+    SQLBindCol(hStmt, 3, SQL_C_SBIGINT, b, 0, ind[2]);
+    SQLBindCol(hStmt, 4, SQL_C_FLOAT, f, 0, ind[3]);
+    SQLBindCol(hStmt, 5, SQL_C_DOUBLE, d, 0, ind[4]);
+    SQLBindCol(hStmt, 6, SQL_C_SBIGINT, n, 0, ind[5]);
+
+    SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)sql, SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    int total = 0;
+    while (SQL_SUCCEEDED(SQLFetch(hStmt))) {
+        for (SQLULEN r = 0; r < fetched; r++)
+            check(++total, s[r], i[r], b[r], f[r], d[r], n[r], &ind[0][r], sizeof(ind[0]));
+    }
+    EXPECT_EQ(total, 10) << "column-wise";
+}
+
+// --- Converting kernels of the conversion plan ---
+// Columns bound to C types other than their own, with a NULL column,
+// fetched as a row-wise rowset with SQL_FBSTMT_CONVERT_PLAN off (every
+// column of every row through its conversion function) and on; both
+// must fill the rows byte for byte the same.
+
+#ifndef SQL_FBSTMT_CONVERT_PLAN
+#define SQL_FBSTMT_CONVERT_PLAN 11985
+#endif
+
+TEST_F(BindColTest, ConvertingCTypesPlanMatchesPerRow) {
+    const char *sql =
+        "SELECT CAST(ID AS SMALLINT), CAST(ID AS SMALLINT), ID, ID * 1000,"
+        " CAST(ID AS DOUBLE PRECISION) / 8, CAST(ID * 100000 AS BIGINT),"
+        " IIF(MOD(ID, 3) = 0, NULL, ID - 100)"
+        " FROM ODBC_TEST_BINDCOL ORDER BY ID";
+
+    struct Row {
+        SQLDOUBLE sd;
+        SQLBIGINT sb;
+        SQLREAL iff;
+        SQLSMALLINT is;
+        SQLREAL df;
+        SQLINTEGER bi;
+        SQLDOUBLE nd;
+        SQLLEN ind[7];
+    };
+
+    SQLULEN fetched = 0;
+    Row rows[2][4];
+    int totals[2] = {};
+
+    for (int plan = 0; plan < 2; plan++) {
+        ReallocStmt();
+        memset(rows[plan], 0x5A, sizeof(rows[plan]));
+        Row *r = rows[plan];
+
+        SQLRETURN rc = SQLSetStmtAttr(hStmt, SQL_FBSTMT_CONVERT_PLAN,
+                                      (SQLPOINTER)(intptr_t)(plan ? SQL_TRUE : SQL_FALSE), 0);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLINTEGER value = -1;
+        SQLGetStmtAttr(hStmt, SQL_FBSTMT_CONVERT_PLAN, &value, 0, NULL);
+        EXPECT_EQ(value, plan ? SQL_TRUE : SQL_FALSE);
+
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)sizeof(Row), 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)4, 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+
+        SQLBindCol(hStmt, 1, SQL_C_DOUBLE, &r->sd, 0, &r->ind[0]);
+        SQLBindCol(hStmt, 2, SQL_C_SBIGINT, &r->sb, 0, &r->ind[1]);
+        SQLBindCol(hStmt, 3, SQL_C_FLOAT, &r->iff, 0, &r->ind[2]);
+        SQLBindCol(hStmt, 4, SQL_C_SSHORT, &r->is, 0, &r->ind[3]);
+        SQLBindCol(hStmt, 5, SQL_C_FLOAT, &r->df, 0, &r->ind[4]);
+        SQLBindCol(hStmt, 6, SQL_C_SLONG, &r->bi, 0, &r->ind[5]);
+        SQLBindCol(hStmt, 7, SQL_C_DOUBLE, &r->nd, 0, &r->ind[6]);
+
+        rc = SQLExecDirect(hStmt, (SQLCHAR*)sql, SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+        // the first rowset, with a NULL in row 3
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt))) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        ASSERT_EQ(fetched, 4u);
+        for (int n = 0; n < 4; n++) {
+            int id = n + 1;
+            EXPECT_DOUBLE_EQ(r[n].sd, id);
+            EXPECT_EQ(r[n].sb, id);
+            EXPECT_FLOAT_EQ(r[n].iff, (float)id);
+            EXPECT_EQ(r[n].is, id * 1000);
+            EXPECT_FLOAT_EQ(r[n].df, id / 8.0f);
+            EXPECT_EQ(r[n].bi, id * 100000);
+            if (id % 3 == 0) {
+                EXPECT_EQ(r[n].ind[6], SQL_NULL_DATA);
+            } else {
+                EXPECT_EQ(r[n].ind[6], (SQLLEN)sizeof(SQLDOUBLE));
+                EXPECT_DOUBLE_EQ(r[n].nd, id - 100);
+            }
+        }
+        totals[plan] = (int)fetched;
+        while (SQL_SUCCEEDED(SQLFetch(hStmt)))
+            totals[plan] += (int)fetched;
+    }
+
+    EXPECT_EQ(totals[0], 10);
+    EXPECT_EQ(totals[1], 10);
+    EXPECT_EQ(memcmp(rows[0], rows[1], sizeof(rows[0])), 0);
+}
+
+// --- Invalidating the conversion plan ---
+// The plan is kept between fetches and must be rebuilt when the ARD is
+// changed through SQLSetDescField or the bind offset is moved.
+
+TEST_F(BindColTest, DescriptorChangesBetweenFetchesRebuildPlan) {
+    struct Pair {
+        SQLINTEGER id;
+        SQLLEN ind;
+    } pairs[2] = {};
+
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &pairs[0].id, 0, &pairs[0].ind);
+    SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT ID FROM ODBC_TEST_BINDCOL ORDER BY ID", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+    EXPECT_EQ(pairs[0].id, 1);
+
+    // move the column to the second pair through the ARD
+    SQLHDESC ard = SQL_NULL_HDESC;
+    SQLGetStmtAttr(hStmt, SQL_ATTR_APP_ROW_DESC, &ard, 0, NULL);
+    rc = SQLSetDescField(ard, 1, SQL_DESC_DATA_PTR, &pairs[1].id, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_DESC, ard);
+    rc = SQLSetDescField(ard, 1, SQL_DESC_INDICATOR_PTR, &pairs[1].ind, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_DESC, ard);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+    EXPECT_EQ(pairs[0].id, 1);
+    EXPECT_EQ(pairs[1].id, 2);
+    EXPECT_EQ(pairs[1].ind, (SQLLEN)sizeof(SQLINTEGER));
+
+    // a bind offset of minus one pair brings it back to the first one
+    SQLLEN offset = -(SQLLEN)sizeof(Pair);
+    rc = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_OFFSET_PTR, &offset, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+    EXPECT_EQ(pairs[0].id, 3);
+    EXPECT_EQ(pairs[0].ind, (SQLLEN)sizeof(SQLINTEGER));
+    EXPECT_EQ(pairs[1].id, 2);
+}
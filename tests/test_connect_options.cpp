@@ -5,6 +5,10 @@
 #include "test_helpers.h"
 #include <thread>
 #include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
 
 // ===== Raw connection tests (not using the fixture) =====
 
@@ -42,8 +46,8 @@ protected:
         ASSERT_TRUE(SQL_SUCCEEDED(ret));
     }
 
-    void Connect() {
-        std::string connStr = GetConnectionString();
+    void Connect(const char* extra = "") {
+        std::string connStr = GetConnectionString() + extra;
         SQLCHAR outStr[1024];
         SQLSMALLINT outLen;
         SQLRETURN ret = SQLDriverConnect(hDbc, NULL,
@@ -250,6 +254,403 @@ TEST_F(ConnectOptionsTest, AccessModeAttribute) {
     EXPECT_EQ(mode, (SQLULEN)SQL_MODE_READ_WRITE);
 }
 
+#ifndef SQL_FBGETCONN_STMT_CACHE_HITS
+#define SQL_FBGETCONN_STMT_CACHE_HITS     11980
+#define SQL_FBGETCONN_STMT_CACHE_MISSES   11979
+#define SQL_FBGETCONN_STMT_CACHE_ENTRIES  11978
+#endif
+
+// Test STMTCACHE: freed statements are prepared again from the cache, DDL clears it
+TEST_F(ConnectOptionsTest, StatementCacheReusesPreparedStatements) {
+    AllocEnvAndDbc();
+    Connect(";STMTCACHE=8");
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_STMTCACHE", SQL_NTS);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"CREATE TABLE ODBC_TEST_STMTCACHE (ID INTEGER)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    hStmt = SQL_NULL_HSTMT;
+
+    for (SQLINTEGER i = 1; i <= 3; ++i) {
+        ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ret = SQLPrepare(hStmt, (SQLCHAR*)"INSERT INTO ODBC_TEST_STMTCACHE (ID) VALUES (?)", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLINTEGER value = i;
+        SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &value, 0, NULL);
+        ret = SQLExecute(hStmt);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+        hStmt = SQL_NULL_HSTMT;
+    }
+
+    SQLINTEGER hits = 0, entries = 0;
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_STMT_CACHE_HITS, &hits, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_GE(hits, 2);
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_STMT_CACHE_ENTRIES, &entries, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_GE(entries, 1);
+
+    // The table can be dropped: the cached statements are freed first
+    ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_STMTCACHE", SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+}
+
+// Test STMTCACHE: a session setting run by SQLExecDirect keeps the cache, DDL does not
+TEST_F(ConnectOptionsTest, SessionSettingKeepsStatementCache) {
+    AllocEnvAndDbc();
+    Connect(";STMTCACHE=8");
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLPrepare(hStmt, (SQLCHAR*)"SELECT 1 FROM RDB$DATABASE WHERE 1 = ?", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    hStmt = SQL_NULL_HSTMT;
+
+    SQLINTEGER entries = 0;
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_STMT_CACHE_ENTRIES, &entries, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ASSERT_EQ(entries, 1);
+
+    ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SET TIME ZONE 'UTC'", SQL_NTS);
+    if (!SQL_SUCCEEDED(ret))
+        GTEST_SKIP() << "SET TIME ZONE needs Firebird 4";
+
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_STMT_CACHE_ENTRIES, &entries, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(entries, 1);
+
+    // a bind changes how the cached text compiles
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SET BIND OF TIME ZONE TO LEGACY", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_STMT_CACHE_ENTRIES, &entries, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(entries, 0);
+}
+
+// Test SERVERAUTOCOMMIT: the server commits each statement of the open transaction
+TEST_F(ConnectOptionsTest, ServerAutoCommitCommitsEveryStatement) {
+    AllocEnvAndDbc();
+    Connect(";SERVERAUTOCOMMIT=Y");
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_SRVAUTOCOMMIT", SQL_NTS);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"CREATE TABLE ODBC_TEST_SRVAUTOCOMMIT (ID INTEGER)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"INSERT INTO ODBC_TEST_SRVAUTOCOMMIT (ID) VALUES (1)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    auto countRows = [this]() {
+        SQLHDBC hDbc2 = SQL_NULL_HDBC;
+        SQLHSTMT hStmt2 = SQL_NULL_HSTMT;
+        SQLAllocHandle(SQL_HANDLE_DBC, hEnv, &hDbc2);
+        std::string connStr = GetConnectionString();
+        SQLRETURN rc = SQLDriverConnect(hDbc2, NULL, (SQLCHAR*)connStr.c_str(), SQL_NTS,
+            NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        SQLINTEGER count = -1;
+        if (SQL_SUCCEEDED(rc)) {
+            SQLAllocHandle(SQL_HANDLE_STMT, hDbc2, &hStmt2);
+            SQLExecDirect(hStmt2, (SQLCHAR*)"SELECT COUNT(*) FROM ODBC_TEST_SRVAUTOCOMMIT", SQL_NTS);
+            SQLBindCol(hStmt2, 1, SQL_C_SLONG, &count, 0, NULL);
+            SQLFetch(hStmt2);
+            SQLFreeHandle(SQL_HANDLE_STMT, hStmt2);
+            SQLDisconnect(hDbc2);
+        }
+        SQLFreeHandle(SQL_HANDLE_DBC, hDbc2);
+        return count;
+    };
+
+    // Another connection sees the row while this one keeps its transaction
+    EXPECT_EQ(countRows(), 1);
+
+    // Without autocommit a rollback undoes the statements again
+    ret = SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"INSERT INTO ODBC_TEST_SRVAUTOCOMMIT (ID) VALUES (2)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLEndTran(SQL_HANDLE_DBC, hDbc, SQL_ROLLBACK);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(countRows(), 1);
+
+    ret = SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_SRVAUTOCOMMIT", SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+}
+
+TEST_F(ConnectOptionsTest, ReadOnlyQueriesSeeCommittedAndOwnChanges) {
+    AllocEnvAndDbc();
+    Connect(";READONLYQUERIES=Y");
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_ROQUERIES", SQL_NTS);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"CREATE TABLE ODBC_TEST_ROQUERIES (ID INTEGER)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    auto countRows = [this]() {
+        SQLINTEGER count = -1;
+        SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT COUNT(*) FROM ODBC_TEST_ROQUERIES", SQL_NTS);
+        EXPECT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLBindCol(hStmt, 1, SQL_C_SLONG, &count, 0, NULL);
+        SQLFetch(hStmt);
+        SQLCloseCursor(hStmt);
+        SQLFreeStmt(hStmt, SQL_UNBIND);
+        return count;
+    };
+
+    // Queries in autocommit mode see what was committed before them
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"INSERT INTO ODBC_TEST_ROQUERIES (ID) VALUES (1)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(countRows(), 1);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"INSERT INTO ODBC_TEST_ROQUERIES (ID) VALUES (2)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(countRows(), 2);
+
+    // A query that needs a writable transaction still runs
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT ID FROM ODBC_TEST_ROQUERIES WITH LOCK", SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLCloseCursor(hStmt);
+
+    // Without autocommit queries see the uncommitted changes of the transaction
+    ret = SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"INSERT INTO ODBC_TEST_ROQUERIES (ID) VALUES (3)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(countRows(), 3);
+    ret = SQLEndTran(SQL_HANDLE_DBC, hDbc, SQL_ROLLBACK);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(countRows(), 2);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_ROQUERIES", SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+}
+
+// Test READONLYQUERIES: queries of selectable procedures that write run in the normal transaction
+TEST_F(ConnectOptionsTest, ReadOnlyQueriesOfWritingProcedures) {
+    AllocEnvAndDbc();
+    Connect(";READONLYQUERIES=Y");
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP PROCEDURE ODBC_TEST_ROQUERIES_ARG", SQL_NTS);
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP PROCEDURE ODBC_TEST_ROQUERIES_NOARG", SQL_NTS);
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_ROQUERIES", SQL_NTS);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"CREATE TABLE ODBC_TEST_ROQUERIES (ID INTEGER)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)
+        "CREATE PROCEDURE ODBC_TEST_ROQUERIES_ARG (N INTEGER) RETURNS (ID INTEGER) AS "
+        "BEGIN INSERT INTO ODBC_TEST_ROQUERIES (ID) VALUES (:N); ID = N; SUSPEND; END", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)
+        "CREATE PROCEDURE ODBC_TEST_ROQUERIES_NOARG RETURNS (ID INTEGER) AS "
+        "BEGIN INSERT INTO ODBC_TEST_ROQUERIES (ID) VALUES (2); ID = 2; SUSPEND; END", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    auto selectId = [this](const char *sql) {
+        SQLINTEGER id = -1;
+        SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)sql, SQL_NTS);
+        EXPECT_TRUE(SQL_SUCCEEDED(rc)) << sql << ": " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLBindCol(hStmt, 1, SQL_C_SLONG, &id, 0, NULL);
+        rc = SQLFetch(hStmt);
+        EXPECT_TRUE(SQL_SUCCEEDED(rc)) << sql << ": " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLCloseCursor(hStmt);
+        SQLFreeStmt(hStmt, SQL_UNBIND);
+        return id;
+    };
+
+    // A procedure called with arguments is told from a table
+    EXPECT_EQ(selectId("SELECT ID FROM ODBC_TEST_ROQUERIES_ARG(1)"), 1);
+
+    // One without parameters reads like a table and is executed again
+    EXPECT_EQ(selectId("SELECT ID FROM ODBC_TEST_ROQUERIES_NOARG"), 2);
+    EXPECT_EQ(selectId("SELECT ID FROM ODBC_TEST_ROQUERIES_NOARG"), 2);
+
+    // Built-in functions keep the read-only transaction and the writes were committed
+    EXPECT_EQ(selectId("SELECT COALESCE(COUNT(*), 0) FROM ODBC_TEST_ROQUERIES"), 3);
+
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP PROCEDURE ODBC_TEST_ROQUERIES_ARG", SQL_NTS);
+    SQLExecDirect(hStmt, (SQLCHAR*)"DROP PROCEDURE ODBC_TEST_ROQUERIES_NOARG", SQL_NTS);
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"DROP TABLE ODBC_TEST_ROQUERIES", SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+}
+
+#ifndef SQL_FBGETCONN_POOL_HITS
+#define SQL_FBGETCONN_POOL_HITS     11974
+#define SQL_FBGETCONN_POOL_MISSES   11973
+#define SQL_FBGETCONN_POOL_IDLE     11972
+#endif
+
+// Test POOL: a second connection takes the attachment of the first, with its session reset
+TEST_F(ConnectOptionsTest, PoolReusesResetAttachment) {
+    AllocEnvAndDbc();
+    Connect(";POOL=2");
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    char version[32] = {};
+    SQLLEN ind = 0;
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)
+        "SELECT RDB$GET_CONTEXT('SYSTEM', 'ENGINE_VERSION') FROM RDB$DATABASE", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLBindCol(hStmt, 1, SQL_C_CHAR, version, sizeof(version), &ind);
+    SQLFetch(hStmt);
+    SQLCloseCursor(hStmt);
+    SQLFreeStmt(hStmt, SQL_UNBIND);
+
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)
+        "SELECT RDB$SET_CONTEXT('USER_SESSION', 'ODBC_TEST_POOL', 'set') FROM RDB$DATABASE", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLFetch(hStmt);
+    SQLCloseCursor(hStmt);
+
+    SQLINTEGER hits = 0;
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_POOL_HITS, &hits, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    hStmt = SQL_NULL_HSTMT;
+    ret = SQLDisconnect(hDbc);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    Connect(";POOL=2");
+
+    SQLINTEGER hitsAfter = 0;
+    ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_POOL_HITS, &hitsAfter, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(hitsAfter, hits + 1);
+
+    ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    char value[16] = {};
+    ind = 0;
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)
+        "SELECT RDB$GET_CONTEXT('USER_SESSION', 'ODBC_TEST_POOL') FROM RDB$DATABASE", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLBindCol(hStmt, 1, SQL_C_CHAR, value, sizeof(value), &ind);
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    // Servers before Firebird 4 cannot reset the session
+    if (atoi(version) >= 4)
+        EXPECT_EQ(ind, SQL_NULL_DATA) << "Session context survived the pool";
+}
+
+#ifndef SQL_FBGETCONN_CLIENT_LOADS
+#define SQL_FBGETCONN_CLIENT_LOADS  11971
+#define SQL_FBGETCONN_CLIENT_USERS  11970
+#endif
+
+// The path of the Firebird client library loaded by the process, empty if none is found
+static std::string LoadedClientPath() {
+#ifdef _WIN32
+    HMODULE module = GetModuleHandleA("fbclient.dll");
+    char path[MAX_PATH] = {};
+    return module ? std::string(path, GetModuleFileNameA(module, path, sizeof(path))) : std::string();
+#else
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        size_t start = line.find('/');
+        if (start != std::string::npos && line.find("libfbclient", start) != std::string::npos)
+            return line.substr(start);
+    }
+    return std::string();
+#endif
+}
+
+// Test CLIENT: connections naming the same client library, by the same or another path, load it once
+TEST_F(ConnectOptionsTest, ClientLibraryLoadedOnceAndReleased) {
+    AllocEnvAndDbc();
+    Connect();
+
+    std::string path = LoadedClientPath();
+    if (path.empty())
+        GTEST_SKIP() << "Cannot find the path of the loaded client library";
+
+    SQLINTEGER loads = 0, users = 0;
+    SQLGetConnectAttr(hDbc, SQL_FBGETCONN_CLIENT_LOADS, &loads, 0, NULL);
+    SQLRETURN ret = SQLGetConnectAttr(hDbc, SQL_FBGETCONN_CLIENT_USERS, &users, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_DBC, hDbc);
+    ASSERT_EQ(users, 1) << "Another connection of the process uses the client library";
+
+    // Another path to the same file: other letter case on Windows, a symbolic link elsewhere
+    std::string otherPath = path;
+#ifdef _WIN32
+    std::transform(otherPath.begin(), otherPath.end(), otherPath.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+#else
+    std::filesystem::path link = std::filesystem::temp_directory_path() / "odbc_test_libfbclient.so";
+    std::error_code error;
+    std::filesystem::remove(link, error);
+    std::filesystem::create_symlink(path, link, error);
+    if (error)
+        GTEST_SKIP() << "Cannot link the client library: " << error.message();
+    otherPath = link.string();
+#endif
+
+    auto connectWith = [this](SQLHDBC dbc, const std::string &client) {
+        std::string connStr = GetConnectionString() + ";CLIENT=" + client;
+        SQLRETURN rc = SQLDriverConnect(dbc, NULL, (SQLCHAR*)connStr.c_str(), SQL_NTS,
+            NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        EXPECT_TRUE(SQL_SUCCEEDED(rc)) << client << ": " << GetOdbcError(SQL_HANDLE_DBC, dbc);
+        return SQL_SUCCEEDED(rc);
+    };
+    auto clientUsers = [this]() {
+        SQLINTEGER count = 0;
+        SQLGetConnectAttr(hDbc, SQL_FBGETCONN_CLIENT_USERS, &count, 0, NULL);
+        return count;
+    };
+    auto clientLoads = [this]() {
+        SQLINTEGER count = 0;
+        SQLGetConnectAttr(hDbc, SQL_FBGETCONN_CLIENT_LOADS, &count, 0, NULL);
+        return count;
+    };
+
+    SQLHDBC samePath = SQL_NULL_HDBC, otherPathDbc = SQL_NULL_HDBC;
+    SQLAllocHandle(SQL_HANDLE_DBC, hEnv, &samePath);
+    SQLAllocHandle(SQL_HANDLE_DBC, hEnv, &otherPathDbc);
+
+    if (connectWith(samePath, path)) {
+        EXPECT_EQ(clientUsers(), 2);
+        EXPECT_EQ(clientLoads(), loads);
+    }
+    if (connectWith(otherPathDbc, otherPath)) {
+        EXPECT_EQ(clientUsers(), 3);
+        EXPECT_EQ(clientLoads(), loads);
+    }
+
+    SQLDisconnect(otherPathDbc);
+    EXPECT_EQ(clientUsers(), 2);
+    SQLDisconnect(samePath);
+    EXPECT_EQ(clientUsers(), 1);
+    SQLFreeHandle(SQL_HANDLE_DBC, otherPathDbc);
+    SQLFreeHandle(SQL_HANDLE_DBC, samePath);
+#ifndef _WIN32
+    std::filesystem::remove(link, error);
+#endif
+
+    // Released with the last connection, the next one loads it again
+    ret = SQLDisconnect(hDbc);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ASSERT_TRUE(connectWith(hDbc, path));
+    EXPECT_EQ(clientLoads(), loads + 1);
+    EXPECT_EQ(clientUsers(), 1);
+}
+
 // ===== OC-3: SQL_ATTR_CONNECTION_TIMEOUT =====
 
 class ConnectionTimeoutTest : public ::testing::Test {
@@ -346,19 +747,22 @@ TEST_F(ConnectionTimeoutTest, ConnectionTimeoutDefaultIsZero) {
 
 class AsyncEnableTest : public OdbcConnectedTest {};
 
-TEST_F(AsyncEnableTest, ConnectionLevelRejectsAsyncOn) {
-    GTEST_SKIP() << "Requires Phase 7 (OC-4): SQL_ATTR_ASYNC_ENABLE support";
-    // Setting SQL_ASYNC_ENABLE_ON should fail with HYC00
+TEST_F(AsyncEnableTest, ConnectionLevelAcceptsAsyncOn) {
+    // Statements run asynchronously on a driver thread pool
     SQLRETURN ret = SQLSetConnectAttr(hDbc, SQL_ATTR_ASYNC_ENABLE,
         (SQLPOINTER)SQL_ASYNC_ENABLE_ON, SQL_IS_UINTEGER);
-    EXPECT_EQ(ret, SQL_ERROR);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_DBC, hDbc);
+
+    SQLULEN value = 999;
+    ret = SQLGetConnectAttr(hDbc, SQL_ATTR_ASYNC_ENABLE, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(value, (SQLULEN)SQL_ASYNC_ENABLE_ON);
 
-    std::string state = GetSqlState(SQL_HANDLE_DBC, hDbc);
-    EXPECT_EQ(state, "HYC00") << "Expected HYC00 for unsupported async enable";
+    SQLSetConnectAttr(hDbc, SQL_ATTR_ASYNC_ENABLE,
+        (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, SQL_IS_UINTEGER);
 }
 
 TEST_F(AsyncEnableTest, ConnectionLevelAcceptsAsyncOff) {
-    GTEST_SKIP() << "Requires Phase 7 (OC-4): SQL_ATTR_ASYNC_ENABLE support";
     // Setting SQL_ASYNC_ENABLE_OFF should succeed (it's the default)
     SQLRETURN ret = SQLSetConnectAttr(hDbc, SQL_ATTR_ASYNC_ENABLE,
         (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, SQL_IS_UINTEGER);
@@ -366,45 +770,111 @@ TEST_F(AsyncEnableTest, ConnectionLevelAcceptsAsyncOff) {
 }
 
 TEST_F(AsyncEnableTest, ConnectionLevelGetReturnsOff) {
-    GTEST_SKIP() << "Requires Phase 7 (OC-4): SQL_ATTR_ASYNC_ENABLE support";
     SQLULEN value = 999;
     SQLRETURN ret = SQLGetConnectAttr(hDbc, SQL_ATTR_ASYNC_ENABLE, &value, 0, NULL);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
     EXPECT_EQ(value, (SQLULEN)SQL_ASYNC_ENABLE_OFF);
 }
 
-TEST_F(AsyncEnableTest, StatementLevelRejectsAsyncOn) {
-    GTEST_SKIP() << "Requires Phase 7 (OC-4): SQL_ATTR_ASYNC_ENABLE support";
-    // Setting SQL_ASYNC_ENABLE_ON on statement should fail with HYC00
+TEST_F(AsyncEnableTest, StatementLevelAcceptsAsyncOn) {
     SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE,
         (SQLPOINTER)SQL_ASYNC_ENABLE_ON, SQL_IS_UINTEGER);
-    EXPECT_EQ(ret, SQL_ERROR);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
 
-    std::string state = GetSqlState(SQL_HANDLE_STMT, hStmt);
-    EXPECT_EQ(state, "HYC00") << "Expected HYC00 for unsupported async enable";
+    SQLULEN value = 999;
+    ret = SQLGetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(value, (SQLULEN)SQL_ASYNC_ENABLE_ON);
 }
 
 TEST_F(AsyncEnableTest, StatementLevelGetReturnsOff) {
-    GTEST_SKIP() << "Requires Phase 7 (OC-4): SQL_ATTR_ASYNC_ENABLE support";
     SQLULEN value = 999;
     SQLRETURN ret = SQLGetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE, &value, 0, NULL);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
     EXPECT_EQ(value, (SQLULEN)SQL_ASYNC_ENABLE_OFF);
 }
 
+TEST_F(AsyncEnableTest, ExecDirectAndFetchPollToCompletion) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE,
+        (SQLPOINTER)SQL_ASYNC_ENABLE_ON, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    // the same call is repeated until it no longer returns SQL_STILL_EXECUTING
+    SQLCHAR* sql = (SQLCHAR*)"SELECT COUNT(*) FROM rdb$fields A CROSS JOIN rdb$fields B";
+    while ((ret = SQLExecDirect(hStmt, sql, SQL_NTS)) == SQL_STILL_EXECUTING)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    while ((ret = SQLFetch(hStmt)) == SQL_STILL_EXECUTING)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLINTEGER count = 0;
+    SQLLEN ind = 0;
+    ret = SQLGetData(hStmt, 1, SQL_C_SLONG, &count, 0, &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_GT(count, 0);
+}
+
+TEST_F(AsyncEnableTest, CatalogFunctionPollsToCompletion) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE,
+        (SQLPOINTER)SQL_ASYNC_ENABLE_ON, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    while ((ret = SQLTables(hStmt, NULL, 0, NULL, 0, (SQLCHAR*)"RDB$RELATIONS", SQL_NTS,
+                            NULL, 0)) == SQL_STILL_EXECUTING)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    while ((ret = SQLFetch(hStmt)) == SQL_STILL_EXECUTING)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(ret, SQL_SUCCESS) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+}
+
+TEST_F(AsyncEnableTest, OtherFunctionWhileRunningFailsAtOnce) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE,
+        (SQLPOINTER)SQL_ASYNC_ENABLE_ON, SQL_IS_UINTEGER);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    SQLCHAR* sql = (SQLCHAR*)"SELECT COUNT(*) FROM rdb$fields A CROSS JOIN rdb$fields B"
+                             " CROSS JOIN rdb$fields C";
+    ret = SQLExecDirect(hStmt, sql, SQL_NTS);
+    if (ret != SQL_STILL_EXECUTING)
+        GTEST_SKIP() << "the query did not run asynchronously";
+
+    // another function fails without waiting for the running call
+    auto start = std::chrono::steady_clock::now();
+    ret = SQLTables(hStmt, NULL, 0, NULL, 0, (SQLCHAR*)"RDB$RELATIONS", SQL_NTS, NULL, 0);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 500);
+
+    // the running call ends as it would have, with its own diagnostics
+    while ((ret = SQLExecDirect(hStmt, sql, SQL_NTS)) == SQL_STILL_EXECUTING)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(ret, SQL_SUCCESS) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLINTEGER records = -1;
+    SQLGetDiagField(SQL_HANDLE_STMT, hStmt, 0, SQL_DIAG_NUMBER, &records, 0, NULL);
+    EXPECT_EQ(records, 0);
+
+    while ((ret = SQLFetch(hStmt)) == SQL_STILL_EXECUTING)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+}
+
 // ===== SQL_ASYNC_MODE info =====
 
 class AsyncModeTest : public OdbcConnectedTest {};
 
-TEST_F(AsyncModeTest, ReportsAsyncModeNone) {
-    GTEST_SKIP() << "Requires Phase 7 (OC-4): SQL_ASYNC_MODE info support";
+TEST_F(AsyncModeTest, ReportsAsyncModeStatement) {
     SQLUINTEGER asyncMode = 0;
     SQLSMALLINT actualLen = 0;
     SQLRETURN ret = SQLGetInfo(hDbc, SQL_ASYNC_MODE, &asyncMode, sizeof(asyncMode), &actualLen);
     ASSERT_TRUE(SQL_SUCCEEDED(ret))
         << "SQLGetInfo(SQL_ASYNC_MODE) failed: " << GetOdbcError(SQL_HANDLE_DBC, hDbc);
-    EXPECT_EQ(asyncMode, (SQLUINTEGER)SQL_AM_NONE)
-        << "SQL_ASYNC_MODE should be SQL_AM_NONE (0), got " << asyncMode;
+    EXPECT_EQ(asyncMode, (SQLUINTEGER)SQL_AM_STATEMENT)
+        << "SQL_ASYNC_MODE should be SQL_AM_STATEMENT (2), got " << asyncMode;
 }
 
 // ===== SQL_ATTR_QUERY_TIMEOUT and SQLCancel tests =====
@@ -9,6 +9,11 @@
 #include <cstring>
 #include <string>
 
+// Driver-specific statement attribute (OdbcJdbc.h)
+#ifndef SQL_FBSTMT_READAHEAD_ROWS
+#define SQL_FBSTMT_READAHEAD_ROWS 11990
+#endif
+
 class CursorsTest : public OdbcConnectedTest {
 protected:
     void SetUp() override {
@@ -247,3 +252,118 @@ TEST_F(CursorsTest, FetchPastEndReturnsNoData) {
     rc = SQLFetch(hStmt);
     EXPECT_EQ(rc, SQL_NO_DATA);
 }
+
+// --- Background read-ahead on a forward-only cursor ---
+
+TEST_F(CursorsTest, ReadAheadFetchesAllRowsInOrder) {
+    SQLRETURN rc = SQLSetStmtAttr(hStmt, SQL_FBSTMT_READAHEAD_ROWS,
+        (SQLPOINTER)8, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLLEN value = 0;
+    rc = SQLGetStmtAttr(hStmt, SQL_FBSTMT_READAHEAD_ROWS, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc));
+    EXPECT_EQ(value, 8);
+
+    rc = SQLExecDirect(hStmt,
+        (SQLCHAR*)"SELECT ID, VAL FROM ODBC_TEST_CURSORS ORDER BY ID", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLINTEGER id = 0;
+    SQLCHAR val[64] = {};
+    SQLLEN ind1 = 0, ind2 = 0;
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &id, 0, &ind1);
+    SQLBindCol(hStmt, 2, SQL_C_CHAR, val, sizeof(val), &ind2);
+
+    int rows = 0;
+    while (SQL_SUCCEEDED(rc = SQLFetch(hStmt))) {
+        ++rows;
+        ASSERT_EQ(id, rows);
+        EXPECT_EQ(std::string((char*)val), "foo" + std::to_string(rows));
+    }
+    EXPECT_EQ(rc, SQL_NO_DATA);
+    EXPECT_EQ(rows, 100);
+}
+
+TEST_F(CursorsTest, ReadAheadCloseMidStreamAndReExecute) {
+    SQLRETURN rc = SQLSetStmtAttr(hStmt, SQL_FBSTMT_READAHEAD_ROWS,
+        (SQLPOINTER)4, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc));
+
+    for (int pass = 0; pass < 3; pass++) {
+        rc = SQLExecDirect(hStmt,
+            (SQLCHAR*)"SELECT ID FROM ODBC_TEST_CURSORS ORDER BY ID", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+        SQLINTEGER id = 0;
+        SQLLEN ind = 0;
+        for (int i = 1; i <= 10; i++) {
+            rc = SQLFetch(hStmt);
+            ASSERT_TRUE(SQL_SUCCEEDED(rc));
+            SQLGetData(hStmt, 1, SQL_C_SLONG, &id, 0, &ind);
+            EXPECT_EQ(id, i);
+        }
+
+        // Worker is still prefetching; closing must stop it cleanly
+        rc = SQLCloseCursor(hStmt);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc));
+    }
+}
+
+// A positioned update must hit the row fetched, not the one the server
+// cursor would be on had it read ahead
+static void positionedUpdateWithReadAhead(SQLHDBC hDbc, SQLHSTMT hStmt, bool nameCursor) {
+    SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+
+    SQLRETURN rc = SQLSetStmtAttr(hStmt, SQL_FBSTMT_READAHEAD_ROWS, (SQLPOINTER)8, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc));
+
+    if (nameCursor) {
+        rc = SQLSetCursorName(hStmt, (SQLCHAR*)"C_READAHEAD", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    }
+
+    rc = SQLExecDirect(hStmt,
+        (SQLCHAR*)"SELECT ID, VAL FROM ODBC_TEST_CURSORS ORDER BY ID FOR UPDATE", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    for (int i = 1; i <= 3; i++)
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+
+    SQLCHAR cursorName[64] = {};
+    SQLSMALLINT nameLength = 0;
+    rc = SQLGetCursorName(hStmt, cursorName, sizeof(cursorName), &nameLength);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLHSTMT hUpdate = SQL_NULL_HSTMT;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hUpdate)));
+
+    std::string update = "UPDATE ODBC_TEST_CURSORS SET VAL = 'changed' WHERE CURRENT OF ";
+    update += (char*)cursorName;
+    rc = SQLExecDirect(hUpdate, (SQLCHAR*)update.c_str(), SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hUpdate);
+
+    SQLCloseCursor(hStmt);
+
+    rc = SQLExecDirect(hUpdate,
+        (SQLCHAR*)"SELECT ID FROM ODBC_TEST_CURSORS WHERE VAL = 'changed'", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hUpdate);
+
+    SQLINTEGER id = 0;
+    SQLLEN ind = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hUpdate)));
+    SQLGetData(hUpdate, 1, SQL_C_SLONG, &id, 0, &ind);
+    EXPECT_EQ(id, 3);
+    EXPECT_EQ(SQLFetch(hUpdate), SQL_NO_DATA);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, hUpdate);
+    SQLEndTran(SQL_HANDLE_DBC, hDbc, SQL_ROLLBACK);
+}
+
+TEST_F(CursorsTest, ReadAheadPositionedUpdateForUpdate) {
+    positionedUpdateWithReadAhead(hDbc, hStmt, false);
+}
+
+TEST_F(CursorsTest, ReadAheadPositionedUpdateNamedCursor) {
+    positionedUpdateWithReadAhead(hDbc, hStmt, true);
+}
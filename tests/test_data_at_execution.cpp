@@ -5,6 +5,7 @@
 // execution time via SQLParamData / SQLPutData.
 
 #include "test_helpers.h"
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -307,3 +308,207 @@ TEST_F(DataAtExecutionTest, BlobDAE) {
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
     EXPECT_STREQ((char*)buf, blobText.c_str());
 }
+
+// ===== Binary BLOB streamed in many chunks =====
+
+TEST_F(DataAtExecutionTest, BinaryBlobStreamedInChunks) {
+    TempTable table(this, "ODBC_TEST_DAE_BIN",
+        "ID INTEGER NOT NULL PRIMARY KEY, VAL_BLOB BLOB SUB_TYPE BINARY");
+
+    SQLRETURN ret = SQLPrepare(hStmt,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_DAE_BIN (ID, VAL_BLOB) VALUES (1, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    // More than a segment, in chunks that do not line up with segments
+    std::vector<unsigned char> data(1024 * 1024 + 17);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (unsigned char)(i * 31 + i / 4096);
+
+    SQLLEN blobInd = SQL_DATA_AT_EXEC;
+    SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY,
+        0, 0, (SQLPOINTER)1, 0, &blobInd);
+
+    ret = SQLExecute(hStmt);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+
+    SQLPOINTER paramId = nullptr;
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+
+    const size_t chunk = 7919;
+    for (size_t offset = 0; offset < data.size(); offset += chunk) {
+        SQLLEN length = (SQLLEN)std::min(chunk, data.size() - offset);
+        ret = SQLPutData(hStmt, &data[offset], length);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    }
+
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret))
+        << "Final SQLParamData failed: " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    Commit();
+
+    ReallocStmt();
+    ExecDirect("SELECT VAL_BLOB FROM ODBC_TEST_DAE_BIN WHERE ID = 1");
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    std::vector<unsigned char> read(data.size());
+    SQLLEN ind = 0;
+    ret = SQLGetData(hStmt, 1, SQL_C_BINARY, read.data(), (SQLLEN)read.size(), &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(ind, (SQLLEN)data.size());
+    EXPECT_TRUE(read == data);
+}
+
+// ===== A stream BLOB outlives the autocommit of another statement =====
+
+TEST_F(DataAtExecutionTest, BlobStreamSurvivesAutoCommitOfAnotherStatement) {
+    SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+
+    SQLRETURN ret = SQLPrepare(hStmt,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_DAE (ID, VAL_BLOB) VALUES (400, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    SQLLEN blobInd = SQL_DATA_AT_EXEC;
+    SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+        1000, 0, (SQLPOINTER)1, 0, &blobInd);
+
+    ret = SQLExecute(hStmt);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+
+    SQLPOINTER paramId = nullptr;
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+
+    ret = SQLPutData(hStmt, (SQLPOINTER)"first half, ", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    // commits on its own while the BLOB is being sent
+    SQLHSTMT hStmt2 = AllocExtraStmt();
+    ret = SQLExecDirect(hStmt2,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_DAE (ID, VAL_TEXT) VALUES (401, 'other')", SQL_NTS);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt2);
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt2);
+
+    ret = SQLPutData(hStmt, (SQLPOINTER)"second half", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret))
+        << "Final SQLParamData failed: " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ReallocStmt();
+    ExecDirect("SELECT CAST(VAL_BLOB AS VARCHAR(100)) FROM ODBC_TEST_DAE WHERE ID = 400");
+    SQLCHAR buf[101] = {};
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_STREQ((char*)buf, "first half, second half");
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+
+    ExecDirect("SELECT COUNT(*) FROM ODBC_TEST_DAE WHERE ID = 401");
+    SQLINTEGER count = 0;
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &count, 0, &ind);
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(count, 1);
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+
+    SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+}
+
+// ===== NULL for a BLOB whose transfer has begun =====
+
+TEST_F(DataAtExecutionTest, NullBlobAfterTransferBegan) {
+    SQLRETURN ret = SQLPrepare(hStmt,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_DAE (ID, VAL_BLOB) VALUES (?, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    SQLINTEGER id = 0;
+    SQLLEN idInd = sizeof(id);
+    SQLLEN blobInd = SQL_DATA_AT_EXEC;
+
+    SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+        0, 0, &id, sizeof(id), &idInd);
+    SQLBindParameter(hStmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+        1000, 0, (SQLPOINTER)2, 0, &blobInd);
+
+    // twice: the stream BLOB dropped for the NULL must not spoil the next run
+    for (id = 500; id <= 501; ++id) {
+        blobInd = SQL_DATA_AT_EXEC;
+        ret = SQLExecute(hStmt);
+        ASSERT_EQ(ret, SQL_NEED_DATA);
+
+        SQLPOINTER paramId = nullptr;
+        ret = SQLParamData(hStmt, &paramId);
+        ASSERT_EQ(ret, SQL_NEED_DATA);
+
+        ret = SQLPutData(hStmt, NULL, SQL_NULL_DATA);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+        ret = SQLParamData(hStmt, &paramId);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret))
+            << "Final SQLParamData failed: " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    }
+    Commit();
+
+    ReallocStmt();
+    ExecDirect("SELECT COUNT(*), COUNT(VAL_BLOB) FROM ODBC_TEST_DAE WHERE ID IN (500, 501)");
+    SQLINTEGER count = 0, countBlobs = -1;
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &count, 0, &ind);
+    SQLBindCol(hStmt, 2, SQL_C_SLONG, &countBlobs, 0, &ind);
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(countBlobs, 0);
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+}
+
+// ===== SQLCancel in the middle of a BLOB transfer =====
+
+TEST_F(DataAtExecutionTest, CancelDuringBlobTransfer) {
+    SQLRETURN ret = SQLPrepare(hStmt,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_DAE (ID, VAL_BLOB) VALUES (600, ?)", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    SQLLEN blobInd = SQL_DATA_AT_EXEC;
+    SQLBindParameter(hStmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+        1000, 0, (SQLPOINTER)1, 0, &blobInd);
+
+    ret = SQLExecute(hStmt);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+
+    SQLPOINTER paramId = nullptr;
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+
+    ret = SQLPutData(hStmt, (SQLPOINTER)"abandoned", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ret = SQLCancel(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    // the same statement sends the value again from the start
+    ret = SQLExecute(hStmt);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_EQ(ret, SQL_NEED_DATA);
+    ret = SQLPutData(hStmt, (SQLPOINTER)"sent", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLParamData(hStmt, &paramId);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret))
+        << "Final SQLParamData failed: " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    Commit();
+
+    ReallocStmt();
+    ExecDirect("SELECT CAST(VAL_BLOB AS VARCHAR(100)) FROM ODBC_TEST_DAE WHERE ID = 600");
+    SQLCHAR buf[101] = {};
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_STREQ((char*)buf, "sent");
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+}
@@ -46,6 +46,58 @@ TEST_F(EscapeSequenceTest, SQLNativeSqlPlainSqlUnchanged) {
     EXPECT_EQ(std::string((char*)output, outputLen), std::string(input));
 }
 
+TEST_F(EscapeSequenceTest, SQLNativeSqlBracesInLiteralsUnchanged) {
+    // Braces in string literals and comments are not escape sequences
+    const char* input = "SELECT '{fn UCASE(x)}' /* {d '2024-01-01'} */ FROM RDB$DATABASE";
+    SQLCHAR output[512] = {};
+    SQLINTEGER outputLen = 0;
+
+    SQLRETURN ret = SQLNativeSql(hDbc,
+        (SQLCHAR*)input, SQL_NTS,
+        output, sizeof(output), &outputLen);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret))
+        << "SQLNativeSql failed: " << GetOdbcError(SQL_HANDLE_DBC, hDbc);
+
+    EXPECT_EQ(std::string((char*)output, outputLen), std::string(input));
+}
+
+#ifndef SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS
+#define SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS     11977
+#define SQL_FBGETCONN_NATIVE_SQL_CACHE_ENTRIES  11975
+#endif
+
+TEST_F(EscapeSequenceTest, SQLNativeSqlRepeatedTextIsCached) {
+    const char* input = "SELECT {fn LCASE('NATIVE CACHE')} FROM RDB$DATABASE";
+    SQLCHAR first[512] = {}, second[512] = {};
+    SQLINTEGER firstLen = 0, secondLen = 0;
+    SQLINTEGER hitsBefore = 0, hitsAfter = 0, entries = 0;
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetConnectAttr(hDbc, SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS, &hitsBefore, 0, NULL)));
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLNativeSql(hDbc, (SQLCHAR*)input, SQL_NTS, first, sizeof(first), &firstLen)));
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLNativeSql(hDbc, (SQLCHAR*)input, SQL_NTS, second, sizeof(second), &secondLen)));
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetConnectAttr(hDbc, SQL_FBGETCONN_NATIVE_SQL_CACHE_HITS, &hitsAfter, 0, NULL)));
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetConnectAttr(hDbc, SQL_FBGETCONN_NATIVE_SQL_CACHE_ENTRIES, &entries, 0, NULL)));
+
+    EXPECT_EQ(std::string((char*)first, firstLen), std::string((char*)second, secondLen));
+    EXPECT_EQ(std::string((char*)second, secondLen).find('{'), std::string::npos);
+    EXPECT_GE(hitsAfter, hitsBefore + 1);
+    EXPECT_GE(entries, 1);
+}
+
+TEST_F(EscapeSequenceTest, EscapeAfterQuoteInComment) {
+    // A quote in a comment does not hide the escape sequence after it
+    ExecDirect("SELECT /* it's */ {fn UCASE('hello')} FROM RDB$DATABASE");
+
+    SQLCHAR val[32] = {};
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 1, SQL_C_CHAR, val, sizeof(val), &ind);
+    SQLRETURN ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_STREQ((char*)val, "HELLO");
+}
+
 // ===== Verify native Firebird functions work directly =====
 
 TEST_F(EscapeSequenceTest, NativeUpperFunction) {
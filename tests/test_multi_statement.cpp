@@ -1,6 +1,8 @@
 // tests/test_multi_statement.cpp — Multi-statement handle interleaving (Phase 3.4)
 
 #include "test_helpers.h"
+#include <atomic>
+#include <thread>
 
 class MultiStatementTest : public OdbcConnectedTest {
 protected:
@@ -172,3 +174,109 @@ TEST_F(MultiStatementTest, FreeOneHandleWhileOthersActive) {
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
     EXPECT_EQ(val, 3);
 }
+
+// ===== Statements of one connection used from several threads =====
+
+TEST_F(MultiStatementTest, StatementsUsedFromSeveralThreads) {
+    const int NUM_THREADS = 4;
+    const int ITERATIONS = 50;
+
+    for (int i = 0; i < NUM_THREADS; i++)
+        extraStmts_.push_back(AllocExtraStmt());
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < NUM_THREADS; i++) {
+        SQLHSTMT stmt = extraStmts_[i];
+        threads.emplace_back([stmt, &failures]() {
+            for (int n = 0; n < ITERATIONS; n++) {
+                SQLRETURN ret = SQLExecDirect(stmt,
+                    (SQLCHAR*)"SELECT ID, VAL FROM ODBC_TEST_MULTI ORDER BY ID", SQL_NTS);
+                if (!SQL_SUCCEEDED(ret)) { failures++; return; }
+
+                int rows = 0;
+                while (SQL_SUCCEEDED(SQLFetch(stmt))) {
+                    SQLINTEGER id = 0;
+                    SQLCHAR val[31] = {};
+                    SQLLEN ind;
+                    char expected[31];
+                    rows++;
+                    SQLGetData(stmt, 1, SQL_C_SLONG, &id, 0, &ind);
+                    SQLGetData(stmt, 2, SQL_C_CHAR, val, sizeof(val), &ind);
+                    snprintf(expected, sizeof(expected), "Val %d", rows);
+                    if (id != rows || strcmp((char*)val, expected) != 0)
+                        failures++;
+                }
+
+                if (rows != 5)
+                    failures++;
+                SQLCloseCursor(stmt);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(failures.load(), 0);
+}
+
+// A fetch that reaches the end of its result set commits in autocommit
+// mode, while another thread executes in the same transaction
+TEST_F(MultiStatementTest, FetchToEndWhileAnotherStatementExecutes) {
+    const int ITERATIONS = 100;
+
+    SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+
+    extraStmts_.push_back(AllocExtraStmt());
+    extraStmts_.push_back(AllocExtraStmt());
+    SQLHSTMT reader = extraStmts_[0];
+    SQLHSTMT writer = extraStmts_[1];
+
+    std::atomic<int> failures{0};
+
+    std::thread fetching([reader, &failures]() {
+        for (int n = 0; n < ITERATIONS; n++) {
+            SQLRETURN ret = SQLExecDirect(reader,
+                (SQLCHAR*)"SELECT ID FROM ODBC_TEST_MULTI ORDER BY ID", SQL_NTS);
+            if (!SQL_SUCCEEDED(ret)) { failures++; return; }
+
+            int rows = 0;
+            while ((ret = SQLFetch(reader)) == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)
+                rows++;
+            if (ret != SQL_NO_DATA || rows != 5)
+                failures++;
+            SQLCloseCursor(reader);
+        }
+    });
+
+    std::thread executing([writer, &failures]() {
+        for (int n = 0; n < ITERATIONS; n++) {
+            char sql[128];
+            snprintf(sql, sizeof(sql),
+                "UPDATE ODBC_TEST_MULTI SET VAL = 'Run %d' WHERE ID = 5", n);
+            if (!SQL_SUCCEEDED(SQLExecDirect(writer, (SQLCHAR*)sql, SQL_NTS)))
+                failures++;
+        }
+    });
+
+    fetching.join();
+    executing.join();
+
+    EXPECT_EQ(failures.load(), 0);
+
+    // every update was committed by its own execute
+    ReallocStmt();
+    SQLRETURN ret = SQLExecDirect(hStmt,
+        (SQLCHAR*)"SELECT VAL FROM ODBC_TEST_MULTI WHERE ID = 5", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+
+    SQLCHAR val[31] = {};
+    SQLLEN ind = 0;
+    SQLGetData(hStmt, 1, SQL_C_CHAR, val, sizeof(val), &ind);
+    char expected[31];
+    snprintf(expected, sizeof(expected), "Run %d", ITERATIONS - 1);
+    EXPECT_STREQ((char*)val, expected);
+}
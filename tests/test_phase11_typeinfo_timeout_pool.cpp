@@ -5,7 +5,7 @@
 //   11.1.7 - SQLGetTypeInfo ordering, multi-row DATA_TYPE, GUID searchability, no duplicates
 //   11.2.5 - SQL_ATTR_QUERY_TIMEOUT getter/setter, SQLCancel, timeout on long query
 //   11.3.4 - SQL_ATTR_RESET_CONNECTION rollback, cursor cleanup, attribute reset
-//   11.1.6 - SQL_ASYNC_MODE reports SQL_AM_NONE
+//   11.1.6 - SQL_ASYNC_MODE reports SQL_AM_STATEMENT
 
 #include "test_helpers.h"
 #include <thread>
@@ -215,16 +215,15 @@ TEST_F(TypeInfoTest, AllTypesReturnValidData)
 
 class AsyncModeTest : public OdbcConnectedTest {};
 
-TEST_F(AsyncModeTest, ReportsAsyncModeNone)
+TEST_F(AsyncModeTest, ReportsAsyncModeStatement)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     SQLUINTEGER asyncMode = 0;
     SQLSMALLINT actualLen = 0;
     SQLRETURN ret = SQLGetInfo(hDbc, SQL_ASYNC_MODE, &asyncMode, sizeof(asyncMode), &actualLen);
     ASSERT_TRUE(SQL_SUCCEEDED(ret))
         << "SQLGetInfo(SQL_ASYNC_MODE) failed: " << GetOdbcError(SQL_HANDLE_DBC, hDbc);
-    EXPECT_EQ(asyncMode, (SQLUINTEGER)SQL_AM_NONE)
-        << "SQL_ASYNC_MODE should be SQL_AM_NONE (0), got " << asyncMode;
+    EXPECT_EQ(asyncMode, (SQLUINTEGER)SQL_AM_STATEMENT)
+        << "SQL_ASYNC_MODE should be SQL_AM_STATEMENT (2), got " << asyncMode;
 }
 
 // ============================================================================
@@ -236,7 +235,6 @@ class QueryTimeoutTest : public OdbcConnectedTest {};
 // Default query timeout should be 0
 TEST_F(QueryTimeoutTest, DefaultTimeoutIsZero)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     SQLULEN timeout = 999;
     SQLRETURN ret = SQLGetStmtAttr(hStmt, SQL_ATTR_QUERY_TIMEOUT, &timeout, 0, nullptr);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
@@ -246,7 +244,6 @@ TEST_F(QueryTimeoutTest, DefaultTimeoutIsZero)
 // Setting and getting timeout
 TEST_F(QueryTimeoutTest, SetAndGetTimeout)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)5, 0);
     ASSERT_TRUE(SQL_SUCCEEDED(ret))
         << "Failed to set query timeout: " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
@@ -260,7 +257,6 @@ TEST_F(QueryTimeoutTest, SetAndGetTimeout)
 // Setting timeout back to 0 disables it
 TEST_F(QueryTimeoutTest, SetTimeoutToZero)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)10, 0);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
 
@@ -276,7 +272,6 @@ TEST_F(QueryTimeoutTest, SetTimeoutToZero)
 // SQLCancel succeeds even when nothing is executing
 TEST_F(QueryTimeoutTest, CancelWhenIdleSucceeds)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     SQLRETURN ret = SQLCancel(hStmt);
     EXPECT_TRUE(SQL_SUCCEEDED(ret))
         << "SQLCancel on idle statement should succeed: " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
@@ -285,7 +280,6 @@ TEST_F(QueryTimeoutTest, CancelWhenIdleSucceeds)
 // SQLCancel from another thread interrupts a long-running query
 TEST_F(QueryTimeoutTest, CancelFromAnotherThread)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     // Use a cartesian product query that takes a long time
     // rdb$relations has ~50 rows, so CROSS JOIN produces ~2500 rows which is fast
     // We'll use a triple cross join for a really long query
@@ -321,7 +315,6 @@ TEST_F(QueryTimeoutTest, CancelFromAnotherThread)
 // Timer-based timeout automatically cancels a long-running query (11.2.2)
 TEST_F(QueryTimeoutTest, TimerFiresOnLongQuery)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     // Set a very short timeout (1 second)
     SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)1, 0);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
@@ -356,7 +349,6 @@ TEST_F(QueryTimeoutTest, TimerFiresOnLongQuery)
 // Timeout of 0 means no timeout — query should complete normally (11.2.1)
 TEST_F(QueryTimeoutTest, ZeroTimeoutDoesNotCancel)
 {
-    GTEST_SKIP() << "Requires Phase 11: SQLGetTypeInfo ordering, query timeout, connection pool reset (not yet merged)";
     SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)0, 0);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
 
@@ -7,6 +7,10 @@
 #include "test_helpers.h"
 #include <cstring>
 
+#ifndef SQL_FBGETSTMT_TYPE
+#define SQL_FBGETSTMT_TYPE 11998
+#endif
+
 class PrepareTest : public OdbcConnectedTest {
 protected:
     void SetUp() override {
@@ -350,3 +354,126 @@ TEST_F(PrepareTest, VarcharParamColumnSize5) {
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
     EXPECT_EQ(id, 2);
 }
+
+// ===== SQLExecDirect without parameters runs without a prepare =====
+
+TEST_F(PrepareTest, ExecDirectInsertReportsRowCount) {
+    ExecDirect("INSERT INTO ODBC_TEST_PREP (ID, VAL_TEXT) VALUES (10, 'direct')");
+
+    SQLLEN rowCount = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLRowCount(hStmt, &rowCount)));
+    EXPECT_EQ(rowCount, 1);
+
+    SQLSMALLINT columns = -1;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLNumResultCols(hStmt, &columns)));
+    EXPECT_EQ(columns, 0);
+
+    SQLINTEGER type = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetStmtAttr(hStmt, SQL_FBGETSTMT_TYPE, NULL, 0, &type)));
+    EXPECT_EQ(type, 2);  // isc_info_sql_stmt_insert
+    Commit();
+
+    ReallocStmt();
+    ExecDirect("SELECT VAL_TEXT FROM ODBC_TEST_PREP WHERE ID = 10");
+    SQLCHAR text[32] = {};
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 1, SQL_C_CHAR, text, sizeof(text), &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hStmt)));
+    EXPECT_STREQ((char*)text, "direct");
+}
+
+TEST_F(PrepareTest, ExecDirectInsertSelectCountsRows) {
+    // rows of a SELECT are only known once executed, it is still prepared
+    ExecDirect("INSERT INTO ODBC_TEST_PREP (ID, VAL_TEXT) "
+               "SELECT ID + 100, VAL_TEXT FROM ODBC_TEST_PREP");
+
+    SQLLEN rowCount = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLRowCount(hStmt, &rowCount)));
+    EXPECT_EQ(rowCount, 3);
+    Commit();
+}
+
+TEST_F(PrepareTest, ExecDirectSelectDescribesColumns) {
+    SQLCHAR text[32] = {};
+    SQLLEN ind = 0;
+    SQLBindCol(hStmt, 2, SQL_C_CHAR, text, sizeof(text), &ind);
+
+    // the cursor is opened without a prepare, its columns describe it
+    ExecDirect("SELECT ID, VAL_TEXT FROM ODBC_TEST_PREP ORDER BY ID");
+
+    SQLSMALLINT columns = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLNumResultCols(hStmt, &columns)));
+    EXPECT_EQ(columns, 2);
+
+    SQLCHAR name[32] = {};
+    SQLSMALLINT nameLength = 0, dataType = 0, digits = 0, nullable = 0;
+    SQLULEN size = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLDescribeCol(hStmt, 2, name, sizeof(name), &nameLength,
+        &dataType, &size, &digits, &nullable)));
+    EXPECT_STREQ((char*)name, "VAL_TEXT");
+    EXPECT_EQ(dataType, SQL_VARCHAR);
+
+    SQLINTEGER type = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetStmtAttr(hStmt, SQL_FBGETSTMT_TYPE, NULL, 0, &type)));
+    EXPECT_EQ(type, 1);  // isc_info_sql_stmt_select
+
+    SQLINTEGER id = 0;
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, &id, 0, NULL);
+    int rows = 0;
+    while (SQL_SUCCEEDED(SQLFetch(hStmt)))
+        ++rows;
+    EXPECT_EQ(rows, 3);
+    EXPECT_EQ(id, 3);
+    EXPECT_STREQ((char*)text, "baz");
+    SQLCloseCursor(hStmt);
+
+    // a statement of another shape follows it on the same handle
+    ExecDirect("COMMENT ON TABLE ODBC_TEST_PREP IS 'direct'");
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLNumResultCols(hStmt, &columns)));
+    EXPECT_EQ(columns, 0);
+    Commit();
+}
+
+TEST_F(PrepareTest, ExecDirectDdlAndFailure) {
+    ExecDirect("COMMENT ON TABLE ODBC_TEST_PREP IS 'direct'");
+
+    SQLLEN rowCount = -1;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLRowCount(hStmt, &rowCount)));
+    EXPECT_EQ(rowCount, 0);
+    Commit();
+
+    // a duplicate key still reports the server error
+    ReallocStmt();
+    SQLRETURN ret = SQLExecDirect(hStmt,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_PREP (ID) VALUES (1)", SQL_NTS);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(GetSqlState(SQL_HANDLE_STMT, hStmt), "23000");
+}
+
+// ===== Row counts are read from the server only when asked for =====
+
+TEST_F(PrepareTest, RowCountAfterCommit) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT,
+        (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER)));
+
+    SQLRETURN ret = SQLPrepare(hStmt,
+        (SQLCHAR*)"UPDATE ODBC_TEST_PREP SET VAL_INT = VAL_INT + 1 WHERE ID <= 2", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecute(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    // the count of the execution survives the end of its transaction
+    Commit();
+    SQLLEN rowCount = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLRowCount(hStmt, &rowCount)));
+    EXPECT_EQ(rowCount, 2);
+
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+    ret = SQLExecDirect(hStmt,
+        (SQLCHAR*)"DELETE FROM ODBC_TEST_PREP WHERE ID = 999", SQL_NTS);
+    EXPECT_EQ(ret, SQL_NO_DATA);
+    Commit();
+
+    SQLSetConnectAttr(hDbc, SQL_ATTR_AUTOCOMMIT,
+        (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+}
@@ -1,6 +1,22 @@
 // test_scrollable_cursor.cpp — Tests for scrollable cursor support (Task 4.7)
 #include "test_helpers.h"
 
+#include <chrono>
+#include <random>
+
+#ifndef SQL_FBSTMT_SERVER_SCROLL
+#define SQL_FBSTMT_SERVER_SCROLL 11989
+#endif
+#ifndef SQL_FBSTMT_STATIC_CURSOR_MEMORY
+#define SQL_FBSTMT_STATIC_CURSOR_MEMORY 11988
+#endif
+#ifndef SQL_FBGETSTMT_CURSOR_MEMORY
+#define SQL_FBGETSTMT_CURSOR_MEMORY 11996
+#endif
+#ifndef SQL_FBSTMT_BLOB_CACHE_MEMORY
+#define SQL_FBSTMT_BLOB_CACHE_MEMORY 11987
+#endif
+
 // ============================================================================
 // ScrollableCursorTest: Validate static scrollable cursor operations
 // ============================================================================
@@ -193,3 +209,618 @@ TEST_F(ScrollableCursorTest, RewindAfterEnd) {
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
     EXPECT_EQ(FetchID(), 1);
 }
+
+TEST_F(ScrollableCursorTest, ServerScrollAttribute) {
+    SQLULEN value = SQL_TRUE;
+    SQLRETURN ret = SQLGetStmtAttr(hStmt, SQL_FBSTMT_SERVER_SCROLL, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(value, (SQLULEN)SQL_FALSE);
+
+    ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_SERVER_SCROLL, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    ret = SQLGetStmtAttr(hStmt, SQL_FBSTMT_SERVER_SCROLL, &value, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(value, (SQLULEN)SQL_TRUE);
+}
+
+TEST_F(ScrollableCursorTest, ServerScrollNavigation) {
+    // Servers without scrollable cursors fall back to the static cursor,
+    // so the results must be the same either way
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_SERVER_SCROLL, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    OpenScrollableCursor("SELECT ID, NAME FROM SCROLL_TEST ORDER BY ID");
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(FetchID(), 1);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), 2);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_LAST, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), NUM_ROWS);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), NUM_ROWS - 1);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, 4);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), 4);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_RELATIVE, 3);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), 7);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, -2);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), NUM_ROWS - 1);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, NUM_ROWS + 1);
+    EXPECT_EQ(ret, SQL_NO_DATA);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), NUM_ROWS);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_FIRST, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), 1);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0);
+    EXPECT_EQ(ret, SQL_NO_DATA);
+}
+
+TEST_F(ScrollableCursorTest, ServerScrollRowset) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_SERVER_SCROLL, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    const int ROWSET = 4;
+    SQLINTEGER ids[ROWSET];
+    SQLLEN inds[ROWSET];
+    SQLULEN fetched = 0;
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)ROWSET, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    OpenScrollableCursor("SELECT ID FROM SCROLL_TEST ORDER BY ID");
+    ret = SQLBindCol(hStmt, 1, SQL_C_SLONG, ids, sizeof(SQLINTEGER), inds);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    // 1-4, 5-8, 9-10
+    for (int start = 1; start <= NUM_ROWS; start += ROWSET) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        int expected = NUM_ROWS - start + 1 < ROWSET ? NUM_ROWS - start + 1 : ROWSET;
+        ASSERT_EQ(fetched, (SQLULEN)expected);
+        for (SQLULEN i = 0; i < fetched; ++i)
+            EXPECT_EQ(ids[i], start + (int)i);
+    }
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    EXPECT_EQ(ret, SQL_NO_DATA);
+
+    // Last rowset is 7-10, the one before it 3-6
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_LAST, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ASSERT_EQ(fetched, (SQLULEN)ROWSET);
+    EXPECT_EQ(ids[0], NUM_ROWS - ROWSET + 1);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ASSERT_EQ(fetched, (SQLULEN)ROWSET);
+    EXPECT_EQ(ids[0], NUM_ROWS - 2 * ROWSET + 1);
+
+    // Prior from 3-6 overlaps the start: 1-4 with 01S06
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0);
+    ASSERT_EQ(ret, SQL_SUCCESS_WITH_INFO);
+    EXPECT_EQ(GetSqlState(SQL_HANDLE_STMT, hStmt), "01S06");
+    ASSERT_EQ(fetched, (SQLULEN)ROWSET);
+    EXPECT_EQ(ids[0], 1);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_RELATIVE, 2);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(ids[0], 3);
+    EXPECT_EQ(ids[ROWSET - 1], 6);
+}
+
+TEST_F(ScrollableCursorTest, ServerScrollSetPosGetData) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_SERVER_SCROLL, (SQLPOINTER)(intptr_t)SQL_TRUE, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    const int ROWSET = 4;
+    SQLULEN fetched = 0;
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)ROWSET, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    OpenScrollableCursor("SELECT ID, NAME FROM SCROLL_TEST ORDER BY ID");
+
+    // SQLGetData reads the row SQLSetPos is on, the first one after a fetch
+    auto checkRow = [&](int id) {
+        EXPECT_EQ(FetchID(), id);
+        char name[31] = {};
+        SQLLEN ind = 0;
+        SQLRETURN rc = SQLGetData(hStmt, 2, SQL_C_CHAR, name, sizeof(name), &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        char expected[16];
+        snprintf(expected, sizeof(expected), "Row_%02d", id);
+        EXPECT_STREQ(name, expected);
+    };
+    auto setPos = [&](SQLSETPOSIROW row) {
+        SQLRETURN rc = SQLSetPos(hStmt, row, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    };
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    checkRow(1);
+    setPos(3);
+    checkRow(3);
+    setPos(2);
+    checkRow(2);
+    setPos(4);
+    checkRow(4);
+
+    // The next rowset continues after the last row fetched, not the one positioned on
+    setPos(2);
+    checkRow(2);
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    checkRow(5);
+    setPos(4);
+    checkRow(8);
+
+    // The last rowset holds 9-10 only
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ASSERT_EQ(fetched, (SQLULEN)2);
+    setPos(2);
+    checkRow(10);
+    setPos(1);
+    checkRow(9);
+    ret = SQLSetPos(hStmt, 3, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(GetSqlState(SQL_HANDLE_STMT, hStmt), "HY107");
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    checkRow(5);
+    setPos(3);
+    checkRow(7);
+}
+
+TEST_F(ScrollableCursorTest, StaticCursorSpillsToDisk) {
+    // 3000 rows of CHAR(1000) do not fit a 1 MB budget
+    const int SPILL_ROWS = 3000;
+    ExecIgnoreError("DROP TABLE SCROLL_SPILL");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE TABLE SCROLL_SPILL (ID INTEGER NOT NULL, PAD CHAR(1000))");
+    Commit();
+    ReallocStmt();
+    ExecDirect("EXECUTE BLOCK AS DECLARE I INTEGER = 1; BEGIN "
+               "WHILE (I <= 3000) DO BEGIN "
+               "INSERT INTO SCROLL_SPILL (ID, PAD) VALUES (:I, 'Row_' || :I); I = I + 1; END END");
+    Commit();
+    ReallocStmt();
+
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_STATIC_CURSOR_MEMORY, (SQLPOINTER)(intptr_t)1, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    OpenScrollableCursor("SELECT ID, PAD FROM SCROLL_SPILL ORDER BY ID");
+
+    const int rows[] = { 1, SPILL_ROWS, 17, 2999, 1500, 2, 1501, SPILL_ROWS / 3 };
+    for (int row : rows) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, row);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << "Row " << row << ": " << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        EXPECT_EQ(FetchID(), row);
+
+        char pad[1001] = {};
+        SQLLEN ind = 0;
+        ret = SQLGetData(hStmt, 2, SQL_C_CHAR, pad, sizeof(pad), &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        EXPECT_EQ(std::string(pad).substr(0, std::string(pad).find(' ')), "Row_" + std::to_string(row));
+    }
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_LAST, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), SPILL_ROWS);
+
+    ReallocStmt();
+    ExecIgnoreError("DROP TABLE SCROLL_SPILL");
+    Commit();
+}
+
+TEST_F(ScrollableCursorTest, StaticCursorCompactRows) {
+    // 1000 rows of a short value in a VARCHAR(8000) would need 8 MB stored at
+    // full width
+    const int WIDE_ROWS = 1000;
+    ExecIgnoreError("DROP TABLE SCROLL_WIDE");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE TABLE SCROLL_WIDE (ID INTEGER NOT NULL, TXT VARCHAR(8000), OPT VARCHAR(100))");
+    Commit();
+    ReallocStmt();
+    ExecDirect("EXECUTE BLOCK AS DECLARE I INTEGER = 1; BEGIN "
+               "WHILE (I <= 1000) DO BEGIN "
+               "INSERT INTO SCROLL_WIDE (ID, TXT, OPT) VALUES (:I, 'Row_' || :I, "
+               "IIF(MOD(:I, 2) = 0, NULL, 'odd')); I = I + 1; END END");
+    Commit();
+    ReallocStmt();
+
+    OpenScrollableCursor("SELECT ID, TXT, OPT FROM SCROLL_WIDE ORDER BY ID");
+
+    SQLLEN memory = 0;
+    SQLRETURN ret = SQLGetStmtAttr(hStmt, SQL_FBGETSTMT_CURSOR_MEMORY, &memory, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_GT(memory, 0);
+    EXPECT_LT(memory, 1024 * 1024);
+
+    const int rows[] = { WIDE_ROWS, 1, 500, 501, 2 };
+    for (int row : rows) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, row);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        EXPECT_EQ(FetchID(), row);
+
+        char txt[64] = {};
+        SQLLEN ind = 0;
+        ret = SQLGetData(hStmt, 2, SQL_C_CHAR, txt, sizeof(txt), &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        EXPECT_EQ(std::string(txt), "Row_" + std::to_string(row));
+
+        ret = SQLGetData(hStmt, 3, SQL_C_CHAR, txt, sizeof(txt), &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        if (row % 2 == 0)
+            EXPECT_EQ(ind, SQL_NULL_DATA);
+        else
+            EXPECT_EQ(std::string(txt), "odd");
+    }
+
+    ReallocStmt();
+    ExecIgnoreError("DROP TABLE SCROLL_WIDE");
+    Commit();
+}
+
+TEST_F(ScrollableCursorTest, StaticCursorFixedWidthRows) {
+    // Rows without VARCHAR columns are read in place from the cursor store
+    const int ROWSET = 3;
+    SQLINTEGER ids[ROWSET], twice[ROWSET];
+    SQLCHAR names[ROWSET][11];
+    SQLLEN idInd[ROWSET], twiceInd[ROWSET], nameInd[ROWSET];
+    SQLULEN fetched = 0;
+
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)ROWSET, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    OpenScrollableCursor("SELECT ID, NULLIF(ID * 2, 10), CAST(NAME AS CHAR(10)) FROM SCROLL_TEST ORDER BY ID");
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, ids, 0, idInd);
+    SQLBindCol(hStmt, 2, SQL_C_SLONG, twice, 0, twiceInd);
+    SQLBindCol(hStmt, 3, SQL_C_CHAR, names, sizeof(names[0]), nameInd);
+
+    const int starts[] = { 4, 1, 8, 2 };
+    for (int start : starts) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, start);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        ASSERT_EQ(fetched, (SQLULEN)ROWSET);
+
+        for (int i = 0; i < ROWSET; ++i) {
+            int id = start + i;
+            char expected[16];
+            snprintf(expected, sizeof(expected), "Row_%02d    ", id);
+            EXPECT_EQ(ids[i], id);
+            EXPECT_EQ(std::string((char*)names[i]), expected);
+            if (id == 5)
+                EXPECT_EQ(twiceInd[i], SQL_NULL_DATA);
+            else
+                EXPECT_EQ(twice[i], id * 2);
+        }
+    }
+
+    // SQLGetData reads the row in place as well
+    SQLFreeStmt(hStmt, SQL_UNBIND);
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)1, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, 5);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(FetchID(), 5);
+
+    SQLINTEGER value = 0;
+    SQLLEN ind = 0;
+    ret = SQLGetData(hStmt, 2, SQL_C_SLONG, &value, 0, &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_EQ(ind, SQL_NULL_DATA);
+}
+
+TEST_F(ScrollableCursorTest, StaticCursorLazyBlobs) {
+    // 200 BLOBs of 20 KB: only their ids are read on execute, and a 1 MB
+    // cache has to drop and fetch them again while scrolling
+    const int BLOB_ROWS = 200;
+    const int BLOB_LENGTH = 20000;
+    ExecIgnoreError("DROP TABLE SCROLL_BLOB");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE TABLE SCROLL_BLOB (ID INTEGER NOT NULL, DOC BLOB SUB_TYPE TEXT)");
+    Commit();
+    ReallocStmt();
+    ExecDirect("EXECUTE BLOCK AS DECLARE I INTEGER = 1; BEGIN "
+               "WHILE (I <= 200) DO BEGIN "
+               "INSERT INTO SCROLL_BLOB (ID, DOC) VALUES (:I, "
+               "IIF(MOD(:I, 7) = 0, NULL, RPAD('Doc_' || :I || '_', 20000, 'x'))); I = I + 1; END END");
+    Commit();
+    ReallocStmt();
+
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_BLOB_CACHE_MEMORY, (SQLPOINTER)(intptr_t)1, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    SQLLEN cache = 0;
+    ret = SQLGetStmtAttr(hStmt, SQL_FBSTMT_BLOB_CACHE_MEMORY, &cache, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(cache, 1);
+
+    OpenScrollableCursor("SELECT ID, DOC FROM SCROLL_BLOB ORDER BY ID");
+
+    SQLLEN memory = 0;
+    ret = SQLGetStmtAttr(hStmt, SQL_FBGETSTMT_CURSOR_MEMORY, &memory, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_LT(memory, 256 * 1024);
+
+    std::vector<char> doc(BLOB_LENGTH + 1);
+    auto checkDoc = [&](int row) {
+        EXPECT_EQ(FetchID(), row);
+
+        SQLLEN ind = 0;
+        SQLRETURN rc = SQLGetData(hStmt, 2, SQL_C_CHAR, doc.data(), (SQLLEN)doc.size(), &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        if (row % 7 == 0) {
+            EXPECT_EQ(ind, SQL_NULL_DATA);
+            return;
+        }
+
+        std::string expected = "Doc_" + std::to_string(row) + "_";
+        expected.resize(BLOB_LENGTH, 'x');
+        EXPECT_EQ(ind, (SQLLEN)BLOB_LENGTH);
+        EXPECT_EQ(std::string(doc.data()), expected);
+    };
+
+    for (int row = 1; row <= BLOB_ROWS; ++row) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        checkDoc(row);
+    }
+
+    const int rows[] = { 1, BLOB_ROWS, 100, 7, 2, 150, 1, 199, 100 };
+    for (int row : rows) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, row);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        checkDoc(row);
+    }
+
+    ret = SQLGetStmtAttr(hStmt, SQL_FBGETSTMT_CURSOR_MEMORY, &memory, 0, NULL);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_LT(memory, 2 * 1024 * 1024);
+
+    ReallocStmt();
+    ExecIgnoreError("DROP TABLE SCROLL_BLOB");
+    Commit();
+}
+
+TEST_F(ScrollableCursorTest, CatalogCursorReadsBlobsWithRows) {
+    // {call} reads the BLR of the procedure through a catalog cursor, whose
+    // transaction is gone once its rows are read
+    ExecIgnoreError("DROP PROCEDURE SCROLL_BLOB_PROC");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE PROCEDURE SCROLL_BLOB_PROC RETURNS (ID INTEGER) AS "
+               "BEGIN FOR SELECT ID FROM SCROLL_TEST ORDER BY ID INTO :ID DO SUSPEND; END");
+    Commit();
+    ReallocStmt();
+    ExecDirect("COMMENT ON PROCEDURE SCROLL_BLOB_PROC IS 'Rows of SCROLL_TEST'");
+    Commit();
+
+    // Queries and prepares then keep off the main transaction
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    hStmt = SQL_NULL_HSTMT;
+    SQLDisconnect(hDbc);
+    std::string connStr = GetConnectionString() + ";READONLYQUERIES=Y";
+    SQLRETURN ret = SQLDriverConnect(hDbc, NULL, (SQLCHAR*)connStr.c_str(), SQL_NTS,
+                                     NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_DBC, hDbc);
+    ReallocStmt();
+
+    auto writableTransactions = [this]() {
+        SQLINTEGER count = -1;
+        SQLRETURN rc = SQLExecDirect(hStmt, (SQLCHAR*)
+            "SELECT COUNT(*) FROM MON$TRANSACTIONS "
+            "WHERE MON$ATTACHMENT_ID = CURRENT_CONNECTION AND MON$READ_ONLY = 0", SQL_NTS);
+        EXPECT_TRUE(SQL_SUCCEEDED(rc)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        SQLBindCol(hStmt, 1, SQL_C_SLONG, &count, 0, NULL);
+        SQLFetch(hStmt);
+        SQLCloseCursor(hStmt);
+        SQLFreeStmt(hStmt, SQL_UNBIND);
+        return count;
+    };
+    EXPECT_EQ(writableTransactions(), 0);
+
+    ret = SQLProcedures(hStmt, NULL, 0, NULL, 0, (SQLCHAR*)"SCROLL_BLOB_PROC", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ret = SQLFetch(hStmt);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    char remarks[64] = {};
+    SQLLEN ind = 0;
+    ret = SQLGetData(hStmt, 7, SQL_C_CHAR, remarks, sizeof(remarks), &ind);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    EXPECT_STREQ(remarks, "Rows of SCROLL_TEST");
+    SQLCloseCursor(hStmt);
+
+    // A selectable procedure is called with SELECT, so it returns its rows
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"{call SCROLL_BLOB_PROC}", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    int rows = 0;
+    while (SQL_SUCCEEDED(SQLFetch(hStmt)))
+        EXPECT_EQ(FetchID(), ++rows);
+    EXPECT_EQ(rows, NUM_ROWS);
+    SQLCloseCursor(hStmt);
+
+    EXPECT_EQ(writableTransactions(), 0);
+
+    ReallocStmt();
+    ExecIgnoreError("DROP PROCEDURE SCROLL_BLOB_PROC");
+    Commit();
+}
+
+TEST_F(ScrollableCursorTest, KeysetCursorReportsChangedRows) {
+    const int ROWSET = 3;
+    SQLINTEGER ids[ROWSET];
+    SQLCHAR names[ROWSET][31];
+    SQLLEN idInds[ROWSET], nameInds[ROWSET];
+    SQLUSMALLINT status[ROWSET];
+    SQLULEN fetched = 0;
+
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)(intptr_t)SQL_CURSOR_KEYSET_DRIVEN, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(intptr_t)ROWSET, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_STATUS_PTR, status, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT ID, NAME FROM SCROLL_TEST T WHERE ID <= 6 ORDER BY ID", SQL_NTS);
+    ASSERT_EQ(ret, SQL_SUCCESS) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+
+    SQLULEN cursorType = 0;
+    SQLGetStmtAttr(hStmt, SQL_ATTR_CURSOR_TYPE, &cursorType, 0, NULL);
+    EXPECT_EQ(cursorType, (SQLULEN)SQL_CURSOR_KEYSET_DRIVEN);
+
+    SQLBindCol(hStmt, 1, SQL_C_SLONG, ids, sizeof(SQLINTEGER), idInds);
+    SQLBindCol(hStmt, 2, SQL_C_CHAR, names, sizeof(names[0]), nameInds);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, 1);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ASSERT_EQ(fetched, (SQLULEN)ROWSET);
+    for (int i = 0; i < ROWSET; ++i) {
+        EXPECT_EQ(status[i], SQL_ROW_SUCCESS);
+        EXPECT_EQ(ids[i], i + 1);
+    }
+
+    // Change the rows behind the open cursor
+    SQLHSTMT hStmt2 = SQL_NULL_HSTMT;
+    ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt2);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLExecDirect(hStmt2, (SQLCHAR*)"UPDATE SCROLL_TEST SET NAME = 'Changed' WHERE ID = 2", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt2);
+    ret = SQLExecDirect(hStmt2, (SQLCHAR*)"DELETE FROM SCROLL_TEST WHERE ID = 3", SQL_NTS);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt2);
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt2);
+
+    // The keyset keeps its rows, the next rowset reads their contents again
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(ids[0], 4);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, 1);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+    ASSERT_EQ(fetched, (SQLULEN)ROWSET);
+    EXPECT_EQ(status[0], SQL_ROW_SUCCESS);
+    EXPECT_EQ(ids[0], 1);
+    EXPECT_EQ(status[1], SQL_ROW_UPDATED);
+    EXPECT_STREQ((char*)names[1], "Changed");
+    EXPECT_EQ(status[2], SQL_ROW_DELETED);
+
+    SQLCloseCursor(hStmt);
+    Commit();
+}
+
+TEST_F(ScrollableCursorTest, KeysetCursorFallsBackToStatic) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)(intptr_t)SQL_CURSOR_KEYSET_DRIVEN, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    // A join has no single RDB$DB_KEY per row
+    ret = SQLExecDirect(hStmt, (SQLCHAR*)"SELECT A.ID FROM SCROLL_TEST A JOIN SCROLL_TEST B ON B.ID = A.ID ORDER BY A.ID", SQL_NTS);
+    ASSERT_EQ(ret, SQL_SUCCESS_WITH_INFO);
+    EXPECT_EQ(GetSqlState(SQL_HANDLE_STMT, hStmt), "01S02");
+
+    SQLULEN cursorType = 0;
+    SQLGetStmtAttr(hStmt, SQL_ATTR_CURSOR_TYPE, &cursorType, 0, NULL);
+    EXPECT_EQ(cursorType, (SQLULEN)SQL_CURSOR_STATIC);
+
+    ret = SQLFetchScroll(hStmt, SQL_FETCH_LAST, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    EXPECT_EQ(FetchID(), NUM_ROWS);
+}
+
+// Random scrolling over 10M rows with a 64 MB budget. Takes minutes, so it
+// only runs with FIREBIRD_ODBC_BENCHMARK set.
+TEST_F(ScrollableCursorTest, BenchmarkStaticCursorRandomScroll) {
+    if (!std::getenv("FIREBIRD_ODBC_BENCHMARK"))
+        GTEST_SKIP() << "FIREBIRD_ODBC_BENCHMARK not set";
+
+    const int BENCH_ROWS = 10000000;
+    const int BENCH_FETCHES = 100000;
+
+    ExecIgnoreError("DROP TABLE SCROLL_DIGITS");
+    Commit();
+    ReallocStmt();
+    ExecDirect("CREATE TABLE SCROLL_DIGITS (N INTEGER NOT NULL)");
+    Commit();
+    ReallocStmt();
+    for (int i = 0; i < 10; ++i) {
+        char sql[64];
+        snprintf(sql, sizeof(sql), "INSERT INTO SCROLL_DIGITS VALUES (%d)", i);
+        ExecDirect(sql);
+        ReallocStmt();
+    }
+    Commit();
+    ReallocStmt();
+
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_FBSTMT_STATIC_CURSOR_MEMORY, (SQLPOINTER)(intptr_t)64, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    auto start = std::chrono::steady_clock::now();
+    OpenScrollableCursor(
+        "SELECT D1.N + D2.N * 10 + D3.N * 100 + D4.N * 1000 + D5.N * 10000"
+        " + D6.N * 100000 + D7.N * 1000000, CAST('Row' AS VARCHAR(30))"
+        " FROM SCROLL_DIGITS D1, SCROLL_DIGITS D2, SCROLL_DIGITS D3, SCROLL_DIGITS D4,"
+        " SCROLL_DIGITS D5, SCROLL_DIGITS D6, SCROLL_DIGITS D7");
+    auto loaded = std::chrono::steady_clock::now();
+
+    SQLLEN rowCount = 0;
+    ret = SQLRowCount(hStmt, &rowCount);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ASSERT_EQ(rowCount, BENCH_ROWS);
+
+    // every row is visited twice and must come back the same
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<int> pick(1, BENCH_ROWS);
+    std::vector<std::pair<int, int>> seen;
+    for (int i = 0; i < BENCH_FETCHES; ++i) {
+        int row = pick(random);
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, row);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret)) << GetOdbcError(SQL_HANDLE_STMT, hStmt);
+        if (i % 100 == 0)
+            seen.emplace_back(row, FetchID());
+    }
+    for (auto& check : seen) {
+        ret = SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, check.first);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        EXPECT_EQ(FetchID(), check.second);
+    }
+    auto done = std::chrono::steady_clock::now();
+
+    using ms = std::chrono::milliseconds;
+    RecordProperty("load_ms", (int)std::chrono::duration_cast<ms>(loaded - start).count());
+    RecordProperty("scroll_ms", (int)std::chrono::duration_cast<ms>(done - loaded).count());
+    printf("[ BENCH    ] load %d ms, %d random fetches %d ms\n",
+           (int)std::chrono::duration_cast<ms>(loaded - start).count(), BENCH_FETCHES,
+           (int)std::chrono::duration_cast<ms>(done - loaded).count());
+
+    ReallocStmt();
+    ExecIgnoreError("DROP TABLE SCROLL_DIGITS");
+    Commit();
+}